@@ -0,0 +1,60 @@
+"""
+Offline replay of recorded AAANKPose feature index queries. Runs inside the editor.
+
+Traces are recorded with AAANKPOSE_TRACE_QUERIES=1 during real planning and scene builds and
+land in Saved/AAANKPose/QueryTraces/*.aqtrace. Each trace is re-run against a database in every
+search mode, comparing latency with what was recorded and how often the same clip and time is picked.
+
+Usage (editor Python console):
+    import replay_query_trace
+    replay_query_trace.replay()                                  # newest trace, recorded databases
+    replay_query_trace.replay(path, "/Game/MotionMatching/OtherDatabase")
+"""
+
+import glob
+import os
+
+import unreal
+
+MODES = [
+    unreal.AAANKPoseSearchMode.EXHAUSTIVE,
+    unreal.AAANKPoseSearchMode.EARLY_OUT,
+    unreal.AAANKPoseSearchMode.COARSE,
+]
+
+
+def latest_trace():
+    folder = os.path.join(unreal.Paths.project_saved_dir(), "AAANKPose", "QueryTraces")
+    traces = glob.glob(os.path.join(folder, "*.aqtrace"))
+    return max(traces, key=os.path.getmtime) if traces else None
+
+
+def replay(trace_path=None, database_path=None, repetitions=5):
+    """Replay a trace in every search mode; returns {mode name: FAAANKPoseReplayReport}"""
+    trace_path = trace_path or latest_trace()
+    if not trace_path:
+        print("No query traces found")
+        return {}
+
+    database = unreal.load_object(None, database_path) if database_path else None
+    if database_path and not database:
+        print(f"Database not found: {database_path}")
+        return {}
+
+    print(f"Replaying {trace_path} against {database_path or 'the recorded databases'}")
+    print(f"{'mode':<12} {'queries':>8} {'skipped':>8} {'agree':>7} {'cost d':>9} "
+          f"{'rec p50':>9} {'rep p50':>9} {'rec p99':>9} {'rep p99':>9}")
+    reports = {}
+    for mode in MODES:
+        report = unreal.AAANKPoseQueryTraceLibrary.replay_query_trace(trace_path, database, mode, repetitions)
+        name = str(mode).split(".")[-1].lower()
+        reports[name] = report
+        print(f"{name:<12} {report.queries:>8} {report.skipped:>8} {report.agreement * 100:6.1f}% "
+              f"{report.mean_cost_delta:9.3f} {report.recorded_median_microseconds:8.1f}u "
+              f"{report.replay_median_microseconds:8.1f}u {report.recorded_p99_microseconds:8.1f}u "
+              f"{report.replay_p99_microseconds:8.1f}u")
+    return reports
+
+
+if __name__ == "__main__":
+    replay()
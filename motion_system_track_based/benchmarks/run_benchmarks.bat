@@ -0,0 +1,12 @@
+@echo off
+REM Headless benchmark of the canonical movies through the AAANKPose native scene build
+REM Usage: run_benchmarks.bat C:\Path\To\Project.uproject [--record]
+
+if "%~1"=="" (
+    echo Usage: run_benchmarks.bat ^<Project.uproject^> [--record]
+    exit /b 2
+)
+
+set BENCH_DIR=%~dp0
+python "%BENCH_DIR%run_benchmarks.py" --project "%~1" %2 %3 %4 %5
+exit /b %ERRORLEVEL%
@@ -0,0 +1,185 @@
+"""
+Headless benchmark of the canonical movies through the AAANKPose native scene build.
+
+1. Runs each movie script in the corpus with Unreal triggering disabled, writing its
+   track folder to benchmarks/dist/ instead of dist/
+2. Launches UnrealEditor-Cmd with -nullrhi and the AAANKPoseBenchmark commandlet,
+   which builds every folder, measures build time, peak memory and key counts,
+   and compares them with budgets.json
+3. Exits non-zero when any movie is over budget by more than the margin
+
+The native build leaves lights, splines, look-at and focus timelines, attachments, scene.json
+and audio to run_scene, so a movie using any of them is only partly built. The report marks
+those movies "partial" and lists what the native build skipped; their timings cover only the
+native part.
+
+budgets.json ships with ceiling budgets (seconds and peak MB, no key counts) that catch gross
+regressions; re-record it with --record on the reference machine to tighten them.
+
+Usage:
+    python benchmarks/run_benchmarks.py --project C:/UnrealProjects/Coding/Coding.uproject
+    python benchmarks/run_benchmarks.py --record      # re-record budgets.json from this run
+
+Environment:
+    UE_EDITOR_CMD: Path to UnrealEditor-Cmd.exe (default: UE_5.7 install location)
+    UE_PROJECT:    Path to the .uproject (instead of --project)
+"""
+
+import argparse
+import json
+import os
+import runpy
+import subprocess
+import sys
+
+BENCH_DIR = os.path.dirname(os.path.abspath(__file__))
+ROOT_DIR = os.path.dirname(BENCH_DIR)
+MOVIES_DIR = os.path.join(ROOT_DIR, "movies")
+TRACKS_DIR = os.path.join(BENCH_DIR, "dist")
+BUDGETS_PATH = os.path.join(BENCH_DIR, "budgets.json")
+REPORT_PATH = os.path.join(BENCH_DIR, "last_report.json")
+
+DEFAULT_EDITOR_CMD = r"C:\Program Files\Epic Games\UE_5.7\Engine\Binaries\Win64\UnrealEditor-Cmd.exe"
+
+# Canonical movies: locomotion, camera work, splines and atmosphere-heavy scenes.
+# sprint_with_new_tracking.py is left out: it writes the same "Sprint With Camera Track" folder.
+CORPUS = [
+    "sprint_with_camera.py",
+    "sprint_socket_tracking.py",
+    "camera_settings_exploration.py",
+    "manny_speed_demo.py",
+    "variable_speed_demo.py",
+    "circular_spline_demo.py",
+    "square_spline_demo.py",
+    "spline_demo.py",
+    "mystical_forest.py",
+    "cathedral_god_rays.py",
+    "sunset_atmosphere.py",
+]
+
+
+def generate_tracks(movie_files):
+    """Run each movie script as __main__ with save_to_tracks redirected and run() disabled"""
+    sys.path.insert(0, ROOT_DIR)
+    from motion_builder import MovieBuilder
+
+    original_save = MovieBuilder.save_to_tracks
+    original_run = MovieBuilder.run
+
+    def save_to_bench(self, output_folder="dist/", chunk_frames=None):
+        return original_save(self, TRACKS_DIR, chunk_frames)
+
+    def no_run(self, to_unreal=False):
+        return self
+
+    MovieBuilder.save_to_tracks = save_to_bench
+    MovieBuilder.run = no_run
+    failed = []
+    try:
+        for movie_file in movie_files:
+            print(f"--- Generating tracks: {movie_file}")
+            try:
+                runpy.run_path(os.path.join(MOVIES_DIR, movie_file), run_name="__main__")
+            except Exception as e:
+                print(f"  ✗ {movie_file} failed: {e}")
+                failed.append(movie_file)
+    finally:
+        MovieBuilder.save_to_tracks = original_save
+        MovieBuilder.run = original_run
+    return failed
+
+
+def native_gaps(movie_folder):
+    """What the native scene build skips in a track folder; empty when it builds the whole movie."""
+    gaps = set()
+    for name in ("scene.json", "audio.json"):
+        if os.path.exists(os.path.join(movie_folder, name)):
+            gaps.add(os.path.splitext(name)[0])
+    for actor_name in os.listdir(movie_folder):
+        actor_folder = os.path.join(movie_folder, actor_name)
+        settings_path = os.path.join(actor_folder, "settings.json")
+        if not os.path.isfile(settings_path):
+            continue
+        with open(settings_path, "r", encoding="utf-8") as f:
+            settings = json.load(f)
+        if settings.get("actor_type") == "light" or "light_type" in settings:
+            gaps.add("lights")
+        if settings.get("actor_type") == "spline":
+            gaps.add("splines")
+        if "look_at_timeline" in settings or "look_at_actor" in settings:
+            gaps.add("look_at")
+        if "focus_on_timeline" in settings or os.path.exists(os.path.join(actor_folder, "focus_distance.json")):
+            gaps.add("focus")
+        if os.path.exists(os.path.join(actor_folder, "attach.json")):
+            gaps.add("attach")
+    return sorted(gaps)
+
+
+def run_commandlet(project, editor_cmd, margin, iterations, record):
+    args = [
+        editor_cmd,
+        project,
+        "-run=AAANKPoseBenchmark",
+        "-nullrhi",
+        "-unattended",
+        "-nosplash",
+        "-stdout",
+        f"-TracksRoot={TRACKS_DIR}",
+        f"-Margin={margin}",
+        f"-Iterations={iterations}",
+        f"-Report={REPORT_PATH}",
+    ]
+    if record or os.path.exists(BUDGETS_PATH):
+        args.append(f"-Budgets={BUDGETS_PATH}")
+    else:
+        print(f"--- No {os.path.basename(BUDGETS_PATH)} yet: reporting only. Record budgets with --record.")
+    if record:
+        args.append("-RecordBudgets")
+    print("--- Running: " + " ".join(f'"{a}"' if " " in a else a for a in args))
+    return subprocess.call(args)
+
+
+def print_report():
+    if not os.path.exists(REPORT_PATH):
+        print("No report written")
+        return
+    with open(REPORT_PATH, "r", encoding="utf-8") as f:
+        report = json.load(f)
+    print("")
+    print(f"{'movie':<32} {'seconds':>9} {'budget':>9} {'peak MB':>9} {'keys':>8}  coverage")
+    for movie, result in sorted(report.get("movies", {}).items()):
+        status = "FAIL " + result.get("reason", "") if result.get("failed") else "ok"
+        movie_folder = os.path.join(TRACKS_DIR, movie)
+        gaps = native_gaps(movie_folder) if os.path.isdir(movie_folder) else []
+        coverage = f"partial (skips {', '.join(gaps)})" if gaps else "full"
+        print(f"{movie:<32} {result['seconds']:9.3f} {result['budget_seconds']:9.3f} "
+              f"{result['peak_mb']:9.1f} {int(result['keys']):8d}  {coverage:<40} {status}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--project", default=os.environ.get("UE_PROJECT"), help="Path to the .uproject")
+    parser.add_argument("--editor-cmd", default=os.environ.get("UE_EDITOR_CMD", DEFAULT_EDITOR_CMD))
+    parser.add_argument("--margin", type=float, default=0.2, help="Allowed fraction over budget")
+    parser.add_argument("--iterations", type=int, default=3, help="Builds per movie; the fastest counts")
+    parser.add_argument("--record", action="store_true", help="Write this run's results to budgets.json")
+    parser.add_argument("--skip-generate", action="store_true", help="Reuse benchmarks/dist as is")
+    parser.add_argument("movies", nargs="*", help="Subset of the corpus (script names)")
+    args = parser.parse_args()
+
+    if not args.project:
+        parser.error("--project or UE_PROJECT is required")
+
+    if not args.skip_generate:
+        failed = generate_tracks(args.movies or CORPUS)
+        if failed:
+            print(f"✗ Track generation failed for: {', '.join(failed)}")
+            return 1
+
+    code = run_commandlet(args.project, args.editor_cmd, args.margin, args.iterations, args.record)
+    print_report()
+    return code
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -70,14 +70,14 @@ class MovieBuilder:
         current_time: Global timeline cursor
     """
     
-    def __init__(self, name: str, fps: int = 60, create_new_level: bool = True, character: str = "belica"):
+    def __init__(self, name: str, fps: int = 60, create_new_level: bool = False, character: str = "belica"):
         """
         Initialize a new movie builder.
         
         Args:
             name: Movie name (also output folder name)
             fps: Frame rate for keyframe calculations
-            create_new_level: Whether to create new Unreal level
+            create_new_level: Build in the movie's own level cloned from the template instead of the open one
             character: Character type for motion matching ("belica" or "manny")
         """
         self.name = name
@@ -395,7 +395,23 @@ class MovieBuilder:
             "cast_volumetric_shadow": cast_volumetric_shadow
         })
         return self
-    
+
+    def add_light_rig(self, preset: str) -> 'MovieBuilder':
+        """
+        Add a ready-made light rig, spawned natively in one call.
+
+        Args:
+            preset: Rig preset name ("god_rays", "cathedral")
+
+        Returns:
+            Self for chaining
+        """
+        self._scene_commands.append({
+            "command": "add_light_rig",
+            "preset": preset
+        })
+        return self
+
     # -------------------------------------------------------------------------
     # Context Managers
     # -------------------------------------------------------------------------
@@ -462,7 +478,7 @@ class MovieBuilder:
     # Output
     # -------------------------------------------------------------------------
     
-    def save_to_tracks(self, output_folder: str = "dist/") -> 'MovieBuilder':
+    def save_to_tracks(self, output_folder: str = "dist/", chunk_frames: Optional[int] = None) -> 'MovieBuilder':
         """
         Save all tracks to folder structure.
         
@@ -480,6 +496,9 @@ class MovieBuilder:
         
         Args:
             output_folder: Base output directory
+            chunk_frames: Store each transform track as windows of this many frames
+                (ActorName/transform/index.json + one file per window) so long takes
+                can be read a window at a time; None writes a single transform.json
         
         Returns:
             Self for chaining
@@ -583,6 +602,7 @@ class MovieBuilder:
         
         # Save each actor's tracks
         for actor_name, track_set in self.actors.items():
+            track_set.transform.chunk_frames = chunk_frames
             track_set.save(movie_folder)
         
         # Generate camera keyframes from timelines (AFTER actor tracks are saved)
@@ -611,9 +631,7 @@ class MovieBuilder:
                     # (Rest is handled by Unreal's LookAt tracking)
                     if keyframes["rotation"]:
                         camera_folder = os.path.join(movie_folder, camera_name)
-                        transform_path = os.path.join(camera_folder, "transform.json")
-                        with open(transform_path, 'w', encoding='utf-8') as f:
-                            json.dump(keyframes["rotation"], f, indent=2)
+                        track_set.transform.save_keys(camera_folder, keyframes["rotation"])
                     
                     # NOTE: focus_distance keyframes NOT saved - Tracking Focus handled in run_scene.py
                     # using Unreal's built-in FocusSettings.TrackingFocusSettings.ActorToTrack
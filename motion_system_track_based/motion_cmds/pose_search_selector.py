@@ -41,6 +41,31 @@ import traceback
 # Output file path matches script
 out_file = "C:/UnrealProjects/coding/unreal/motion_system_track_based/temp_mm_result.json"
 
+def query_feature_index(db):
+    # Native feature index (AAANKPose plugin): matches on speed, and records to the query trace if one is open
+    index_lib = getattr(unreal, "AAANKPoseFeatureIndexLibrary", None)
+    if not index_lib:
+        return None
+    trace_lib = getattr(unreal, "AAANKPoseQueryTraceLibrary", None)
+    if "{TRACE_LABEL}" and trace_lib and not trace_lib.is_query_trace_recording():
+        trace_lib.begin_query_trace("{TRACE_LABEL}")
+    res = index_lib.query_database(db, unreal.Vector({VEL_X}, {VEL_Y}, 0.0))
+    if res.row < 0:
+        return None
+    return {
+        'anim_path': res.asset_path,
+        'start_time': res.time,
+        'cost': res.cost,
+        'debug_name': res.asset_path.split('.')[-1],
+    }
+
+def feature_index_wanted():
+    # A native query is only worth running when it selects or a trace records it
+    if {USE_FEATURE_INDEX} or "{TRACE_LABEL}":
+        return True
+    trace_lib = getattr(unreal, "AAANKPoseQueryTraceLibrary", None)
+    return bool(trace_lib and trace_lib.is_query_trace_recording())
+
 def perform_query():
     try:
         # Load Database
@@ -49,6 +74,11 @@ def perform_query():
         if not db:
             return {'error': 'Database not found: ' + db_path}
 
+        # Recorded next to the motion_match result; only replaces it when explicitly opted in
+        index_result = query_feature_index(db) if feature_index_wanted() else None
+        if {USE_FEATURE_INDEX} and index_result:
+            return dict(index_result, db_name=db.get_name(), debug_log='AAANKPose feature index')
+
         # Spawn Temp Character
         character_bp = unreal.load_object(None, "/Game/ThirdPerson/Blueprints/BP_ThirdPersonCharacter")
         if not character_bp:
@@ -125,7 +155,8 @@ def perform_query():
                 'debug_name': r_name,
                 'db_asset_count': num_assets,
                 'db_name': db.get_name(),
-                'debug_log': "; ".join(debug_info)
+                'debug_log': "; ".join(debug_info),
+                'feature_index': index_result
             }
             return result_data
             
@@ -148,6 +179,14 @@ except Exception as main_e:
         # Inject variables
         script = script_body.replace("{DB_PATH}", self.database_path)
         script = script.replace("{CTX_VAL}", context_anim_str)
+        script = script.replace("{VEL_X}", repr(float(speed) * direction[0]))
+        script = script.replace("{VEL_Y}", repr(float(speed) * direction[1]))
+        # Opt-in (AAANKPOSE_TRACE_QUERIES=1): open a query trace in the editor; run_scene closes it
+        trace_label = "planning" if os.environ.get("AAANKPOSE_TRACE_QUERIES", "") not in ("", "0") else ""
+        script = script.replace("{TRACE_LABEL}", trace_label)
+        # Opt-in (AAANKPOSE_FEATURE_INDEX_SELECT=1): select with the native feature index instead of motion_match
+        use_feature_index = os.environ.get("AAANKPOSE_FEATURE_INDEX_SELECT", "") not in ("", "0")
+        script = script.replace("{USE_FEATURE_INDEX}", repr(use_feature_index))
         
         # Output file path matches script
         out_file = "C:/UnrealProjects/coding/unreal/motion_system_track_based/temp_mm_result.json"
@@ -54,6 +54,35 @@ class Materials:
         }
         return mapping.get(color_name.lower(), Materials.RED)
 
+    # Linear RGB of the named marker colors
+    COLORS = {
+        "red": (1.0, 0.0, 0.0),
+        "blue": (0.0, 0.0, 1.0),
+        "green": (0.0, 1.0, 0.0),
+        "yellow": (1.0, 1.0, 0.0),
+        "purple": (1.0, 0.0, 1.0),
+        "orange": (1.0, 0.5, 0.0),
+        "cyan": (0.0, 1.0, 1.0),
+        "white": (1.0, 1.0, 1.0),
+    }
+
+    @staticmethod
+    def get_color_material(color, base_material=None):
+        """
+        Shared material for a marker color: a color name or an (r, g, b) / unreal.LinearColor.
+        Comes from the native pool (one saved instance per color, reused across runs);
+        without the plugin, loads the My<Color> asset get_color names.
+        """
+        import unreal
+        pool_lib = getattr(unreal, "AAANKPoseMaterialPoolLibrary", None)
+        if not pool_lib:
+            return unreal.load_object(None, Materials.get_color(color if isinstance(color, str) else "red"))
+        if isinstance(color, str):
+            color = Materials.COLORS.get(color.lower(), Materials.COLORS["red"])
+        if not isinstance(color, unreal.LinearColor):
+            color = unreal.LinearColor(color[0], color[1], color[2], 1.0)
+        return pool_lib.get_color_material(color, base_material)
+
 class Animations:
     PIA_JOG_FWD = "/Game/MetaHumans/Pia/Animations2/Unarmed/pia_rtg_3_MF_Unarmed_Jog_Fwd.pia_rtg_3_MF_Unarmed_Jog_Fwd"
     
@@ -59,8 +59,12 @@ def create_axis_markers():
         
         actor.set_actor_scale3d(scale_vec)
 
-        # Try to assign a colored material
-        if base_mat:
+        # Shared pooled material per color; MID per segment without the plugin
+        pool_lib = getattr(unreal, "AAANKPoseMaterialPoolLibrary", None)
+        if pool_lib:
+            smc.set_material(0, pool_lib.get_color_material(color_lin, base_mat))
+            log(f"  ✓ {name}: {color_lin.r:.1f},{color_lin.g:.1f},{color_lin.b:.1f}")
+        elif base_mat:
             try:
                 mid = unreal.MaterialInstanceDynamic.create(base_mat, actor)
                 # Attempt common parameter names for color
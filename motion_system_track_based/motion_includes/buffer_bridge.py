@@ -0,0 +1,119 @@
+# Simple inline logger functions for motion_includes
+# This avoids import conflicts with other logger modules in the Python path
+
+def log(message, log_file=None):
+    """Print message"""
+    print(message)
+
+def log_header(title):
+    """Print header"""
+    print("=" * 60)
+    print(title)
+    print("=" * 60)
+
+
+"""
+Zero-copy arrays between Python and AAANKPose batch functions
+
+The plugin allocates a named shared memory region and hands back a small handle; Python maps the
+same region and reads or writes it as a memoryview (or numpy array when numpy is available). Only
+the handle goes through the reflection layer, never the elements.
+
+    with buffer_bridge.share(points, "double") as pts, buffer_bridge.create("float", 8 * 4096) as out:
+        count = unreal.AAANKPoseBufferLibrary.sample_spline_path_to_buffer(pts.handle, 10.0, False, out.handle)
+        samples = out.numpy()[:count * 8].reshape(-1, 8)
+"""
+import array
+import mmap
+import sys
+import unreal
+
+_FORMATS = {"float": "f", "double": "d", "int32": "i"}
+
+
+def _flatten(values):
+    """[(x, y, z), ...] -> [x, y, z, ...]; flat sequences pass through"""
+    values = list(values)
+    if values and isinstance(values[0], (tuple, list)):
+        return [v for item in values for v in item]
+    return values
+
+
+def _buffer_type(type_name):
+    return getattr(unreal.AAANKPoseBufferType, type_name.upper())
+
+
+class SharedBuffer:
+    """Python side of an FAAANKPoseBufferHandle; release() (or a with block) frees both sides"""
+
+    def __init__(self, handle, type_name):
+        self.handle = handle
+        self.type_name = type_name
+        self.format = _FORMATS[type_name]
+        nbytes = handle.num * unreal.AAANKPoseBufferLibrary.get_buffer_element_size(handle.type)
+        if sys.platform == "win32":
+            # The plugin reports the exact mapping name (Global\...); a bare name would open a different, empty mapping
+            self._map = mmap.mmap(-1, nbytes, tagname=handle.kernel_name)
+            raw = memoryview(self._map)
+        else:
+            from multiprocessing import shared_memory
+            self._map = shared_memory.SharedMemory(name=handle.kernel_name)
+            raw = self._map.buf
+        self._raw = raw[:nbytes]
+        self.view = self._raw.cast(self.format)
+
+    def __len__(self):
+        return self.handle.num
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.release()
+
+    def numpy(self):
+        """numpy array over the shared region (no copy); requires numpy"""
+        import numpy
+        return numpy.frombuffer(self._raw, dtype=numpy.dtype(self.format), count=self.handle.num)
+
+    def write(self, data, offset=0):
+        """Copy a buffer-protocol object, numpy array or sequence of numbers in with one memcpy"""
+        try:
+            source = memoryview(data)
+        except TypeError:
+            source = memoryview(array.array(self.format, _flatten(data)))
+        if source.format != self.format:
+            source = memoryview(array.array(self.format, _flatten(source.tolist())))
+        count = source.nbytes // source.itemsize
+        self.view[offset:offset + count] = source.cast("B").cast(self.format)
+        return count
+
+    def release(self):
+        if self._map is None:
+            return
+        self.view.release()
+        self._raw.release()
+        self._map.close()
+        self._map = None
+        unreal.AAANKPoseBufferLibrary.release_shared_buffer(self.handle)
+
+
+def create(type_name, count):
+    """A zeroed shared buffer of count elements of "float", "double" or "int32" """
+    handle = unreal.AAANKPoseBufferLibrary.create_shared_buffer(_buffer_type(type_name), count)
+    if not handle.name:
+        raise RuntimeError(f"Could not create a shared {type_name} buffer of {count} elements")
+    return SharedBuffer(handle, type_name)
+
+
+def share(data, type_name="double"):
+    """A shared buffer holding a copy of data (nested sequences are flattened), ready to pass to batch functions"""
+    try:
+        source = memoryview(data)
+        count = source.nbytes // source.itemsize
+    except TypeError:
+        data = array.array(_FORMATS[type_name], _flatten(data))
+        count = len(data)
+    buffer = create(type_name, count)
+    buffer.write(data)
+    return buffer
@@ -0,0 +1,133 @@
+# Simple inline logger functions for motion_includes
+# This avoids import conflicts with other logger modules in the Python path
+
+def log(message, log_file=None):
+    """Print message"""
+    print(message)
+
+def log_header(title):
+    """Print header"""
+    print("=" * 60)
+    print(title)
+    print("=" * 60)
+
+
+"""
+Opt-in profiler for Python -> Unreal reflection calls (add_key, set_editor_property, ...)
+
+Enable with the environment variable AAANKPOSE_PROFILE_CALLS=1. Calls into the `unreal`
+module are timed with sys.setprofile, grouped by build phase and Python call site, and
+handed to AAANKPoseCallProfilerLibrary once per phase for ranking.
+"""
+import os
+import sys
+import time
+import unreal
+
+
+def is_enabled():
+    return os.environ.get("AAANKPOSE_PROFILE_CALLS", "") not in ("", "0")
+
+
+def _reflected_name(func):
+    """'Owner.method' for builtins bound to unreal types or objects, else None"""
+    owner = getattr(func, "__self__", None)
+    if owner is None:
+        return None
+    owner_type = owner if isinstance(owner, type) else type(owner)
+    if getattr(owner_type, "__module__", None) != "unreal":
+        return None
+    return f"{owner_type.__name__}.{func.__name__}"
+
+
+class CallProfiler:
+    """Accumulates (name, call site) -> [calls, seconds] for the current phase"""
+
+    def __init__(self):
+        self.phase = "Setup"
+        self._samples = {}
+        self._starts = []
+        self._previous = None
+
+    def start(self):
+        unreal.AAANKPoseCallProfilerLibrary.reset_call_profile()
+        self._previous = sys.getprofile()
+        sys.setprofile(self._hook)
+
+    def stop(self):
+        sys.setprofile(self._previous)
+        self._flush()
+
+    def set_phase(self, phase):
+        self._flush()
+        self.phase = phase
+
+    def _hook(self, frame, event, arg):
+        if event == "c_call":
+            self._starts.append(time.perf_counter())
+        elif event == "c_return" or event == "c_exception":
+            if not self._starts:
+                return
+            elapsed = time.perf_counter() - self._starts.pop()
+            name = _reflected_name(arg)
+            if name:
+                key = (name, f"{os.path.basename(frame.f_code.co_filename)}:{frame.f_lineno}")
+                sample = self._samples.get(key)
+                if sample:
+                    sample[0] += 1
+                    sample[1] += elapsed
+                else:
+                    self._samples[key] = [1, elapsed]
+
+    def _flush(self):
+        if not self._samples:
+            return
+        # Submitting is itself a reflected call; keep it out of the numbers
+        hook = sys.getprofile()
+        sys.setprofile(None)
+        samples, self._samples = self._samples, {}
+        unreal.AAANKPoseCallProfilerLibrary.submit_call_samples(
+            self.phase,
+            [name for name, _ in samples],
+            [site for _, site in samples],
+            [value[0] for value in samples.values()],
+            [value[1] for value in samples.values()],
+        )
+        sys.setprofile(hook)
+
+    def report(self, movie_name, max_entries=15):
+        """Log the most expensive crossings and write the full CSV"""
+        entries = unreal.AAANKPoseCallProfilerLibrary.get_ranked_call_report(False, max_entries)
+        log_header(f"REFLECTION CALL PROFILE: {movie_name}")
+        for entry in entries:
+            mean_us = entry.total_seconds * 1.0e6 / max(entry.calls, 1)
+            log(f"  {entry.total_seconds * 1000.0:9.1f} ms  {entry.calls:7d} calls  {mean_us:8.1f} us  [{entry.phase}] {entry.name}")
+        path = unreal.AAANKPoseCallProfilerLibrary.write_call_report(movie_name)
+        if path:
+            log(f"  Full profile: {path}")
+
+
+_active = None
+
+
+def begin():
+    """Start profiling if enabled and the plugin is loaded"""
+    global _active
+    if _active or not is_enabled() or not hasattr(unreal, "AAANKPoseCallProfilerLibrary"):
+        return None
+    _active = CallProfiler()
+    _active.start()
+    return _active
+
+
+def set_phase(phase):
+    if _active:
+        _active.set_phase(phase)
+
+
+def end(movie_name):
+    global _active
+    if _active:
+        profiler, _active = _active, None
+        profiler.stop()
+        profiler.report(movie_name)
@@ -15,6 +15,7 @@ def log_header(title):
 """
 Camera creation and configuration
 """
+import math
 import unreal
 from .assets import Materials
 # import logger
@@ -61,40 +62,13 @@ def create_camera_marker(location, color_name="red", owner_name="Camera"):
     ground_loc = unreal.Vector(location.x, location.y, 91.44)
     marker.set_actor_location(ground_loc, False, True)
     
-    # Material/Color
-    # User requested to use existing materials (MyRed, MyBlue, etc.)
-    color_map = {
-        "red": Materials.RED,
-        "blue": Materials.BLUE,
-        "green": Materials.GREEN,
-        "yellow": Materials.YELLOW
-    }
-    
-    mat_path = color_map.get(color_name.lower(), Materials.RED)
-    existing_mat = unreal.EditorAssetLibrary.load_asset(mat_path)
-    
-    if existing_mat:
-        marker.static_mesh_component.set_material(0, existing_mat)
-        log(f"  + Set marker material to {mat_path}")
+    # Material/Color: one shared pooled material per color
+    marker_mat = Materials.get_color_material(color_name)
+    if marker_mat:
+        marker.static_mesh_component.set_material(0, marker_mat)
+        log(f"  + Set marker material to {marker_mat.get_name()}")
     else:
-        # Fallback to dynamic if specific asset missing
-        try:
-            # Create dynamic material
-            mat = marker.static_mesh_component.create_dynamic_material_instance(0)
-            
-            # Colors - Solid Opaque for maximum visibility
-            color = unreal.LinearColor(1, 0, 0, 1.0) # Red default
-            if color_name.lower() == "blue":
-                color = unreal.LinearColor(0, 0, 1, 1.0)
-            elif color_name.lower() == "green":
-                color = unreal.LinearColor(0, 1, 0, 1.0)
-            elif color_name.lower() == "yellow":
-                color = unreal.LinearColor(1, 1, 0, 1.0)
-                
-            mat.set_vector_parameter_value("Color", color)
-            mat.set_vector_parameter_value("BaseColor", color)
-        except Exception as e:
-            log(f"  ⚠ Could not set marker color: {e}")
+        log(f"  ⚠ Could not set marker color: {color_name}")
 
     log(f"  + Marker ({owner_name}) created at {location}")
 
@@ -137,9 +111,11 @@ def create_camera(camera_name, location=None, rotation=None, fov=90.0, tint=None
 
         # Set camera properties
         camera_component = camera.get_cine_camera_component()
-        camera_component.set_editor_property("current_focal_length", 50.0)
+        # A cine camera derives its FOV from the lens, so set the focal length that gives fov on this filmback
+        sensor_width = camera_component.get_editor_property("filmback").sensor_width
+        focal_length = sensor_width * 0.5 / math.tan(math.radians(max(1.0, min(fov, 170.0))) * 0.5)
+        camera_component.set_editor_property("current_focal_length", focal_length)
         camera_component.set_editor_property("current_aperture", 2.8)
-        camera_component.set_editor_property("field_of_view", fov)
         
         # Enable debug visualization (frustum) if requested
         if debug_visible:
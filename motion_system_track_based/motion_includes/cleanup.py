@@ -105,6 +105,10 @@ def delete_old_actors():
     else:
         log("  No old actors found")
 
+    # The HUD text actors are gone, so their post-tick updaters go with them
+    from . import hud_setup
+    hud_setup.remove_hud_callbacks()
+
 
 def cleanup_old_assets(keep_sequence=False):
     """Main cleanup function - removes all old test assets
@@ -20,6 +20,24 @@ import unreal
 # from logger import log
 
 
+# Post-tick handles registered by create_hud; cleanup.delete_old_actors removes them with the HUD actors
+_tick_handles = []
+
+
+def remove_hud_callbacks():
+    """Unregister every HUD post-tick callback; called when the HUD actors they update are deleted"""
+    while _tick_handles:
+        try:
+            unreal.unregister_slate_post_tick_callback(_tick_handles.pop())
+        except Exception as e:
+            log(f"⚠ Warning: HUD tick unregister failed: {e}")
+
+
+def registered_callback_count():
+    """Callbacks still registered; grows across runs if a HUD is created without cleanup unhooking the last one"""
+    return len(_tick_handles)
+
+
 def create_hud(camera, mannequin):
     """Create HUD text actor showing Belica X/Y/Z position"""
     # Position HUD in front of camera (Y-forward is camera's forward direction)
@@ -57,7 +75,7 @@ def create_hud(camera, mannequin):
                 text_comp.set_text(f"Belica XYZ\nX: {loc.x:.1f}\nY: {loc.y:.1f}\nZ: {loc.z:.1f}")
 
             try:
-                unreal.register_slate_post_tick_callback(_update_hud)
+                _tick_handles.append(unreal.register_slate_post_tick_callback(_update_hud))
                 log("✓ HUD tick registered to update Belica position")
             except Exception as e:
                 log(f"⚠ Warning: HUD tick registration failed: {e}")
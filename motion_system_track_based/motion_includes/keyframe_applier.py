@@ -18,6 +18,7 @@ Keyframe Applier - Pass 2: Apply keyframe data to Unreal
 Takes structured keyframe data and creates actual Unreal sequencer keyframes.
 """
 import unreal
+from .property_batch import set_properties
 # import logger
 # from logger import log
 
@@ -160,9 +161,7 @@ def apply_keyframes_to_actor(actor_name, actor, binding, keyframe_data, fps, dur
             component = actor.get_cine_camera_component()
             
             # Ensure Manual Focus Method is set
-            focus_settings = component.get_editor_property("focus_settings")
-            focus_settings.set_editor_property("focus_method", unreal.CameraFocusMethod.MANUAL)
-            component.set_editor_property("focus_settings", focus_settings)
+            set_properties([(component, "focus_settings.focus_method", unreal.CameraFocusMethod.MANUAL)])
             
             # Add component binding if not already exists (reuse comp_binding idea)
             comp_binding = unreal.MovieSceneSequenceExtensions.add_possessable(sequence, component)
@@ -223,21 +222,20 @@ def apply_keyframes_to_actor(actor_name, actor, binding, keyframe_data, fps, dur
         
         try:
             # Enable LookAt Tracking globally on the actor first
-            tracking_settings = actor.get_editor_property("lookat_tracking_settings")
-            tracking_settings.set_editor_property("enable_look_at_tracking", True)
+            writes = [(actor, "lookat_tracking_settings.enable_look_at_tracking", True)]
             
             # Apply interpolation speed if present in first key (heuristic)
             if look_at_keys:
                 interp_speed = look_at_keys[0].get("interp_speed", 0.0)
                 if interp_speed > 0:
-                    tracking_settings.set_editor_property("look_at_tracking_interp_speed", interp_speed)
+                    writes.append((actor, "lookat_tracking_settings.look_at_tracking_interp_speed", interp_speed))
                     log(f"  > Set Look-At Interp Speed: {interp_speed}")
             
             # Set default to first target to ensure it works immediately
             if look_at_keys and look_at_keys[0]["value"] in actor_map:
-                tracking_settings.set_editor_property("actor_to_track", actor_map[look_at_keys[0]["value"]])
+                writes.append((actor, "lookat_tracking_settings.actor_to_track", actor_map[look_at_keys[0]["value"]]))
                 
-            actor.set_editor_property("lookat_tracking_settings", tracking_settings)
+            set_properties(writes)
             
             # Create Object Property Track
             track_class = unreal.MovieSceneObjectPropertyTrack
@@ -283,9 +281,7 @@ def apply_keyframes_to_actor(actor_name, actor, binding, keyframe_data, fps, dur
             component = actor.get_cine_camera_component()
             
             # Ensure Tracking Focus Method is set
-            focus_settings = component.get_editor_property("focus_settings")
-            focus_settings.set_editor_property("focus_method", unreal.CameraFocusMethod.TRACKING)
-            component.set_editor_property("focus_settings", focus_settings)
+            set_properties([(component, "focus_settings.focus_method", unreal.CameraFocusMethod.TRACKING)])
             
             # Add component binding
             comp_binding = unreal.MovieSceneSequenceExtensions.add_possessable(sequence, component)
@@ -16,6 +16,7 @@ def log_header(title):
 Level creation and management logic.
 """
 import unreal
+from .property_batch import set_properties
 # import logger
 # from logger import log, log_header
 
@@ -61,29 +62,77 @@ def save_current_level(level_path):
     return success
 
 
+def create_movie_level(scene_name, atmosphere_cmd=None):
+    """
+    Open a level for a create_new_level movie: a one-step copy of the prepared movie template
+    (floor, sun, sky and fog already placed) with the movie's add_atmosphere applied to the template fog.
+    Returns True if atmosphere_cmd was applied, so the caller can skip apply_atmosphere_settings.
+    Falls back to create_basic_level() without the AAANKPose plugin.
+    """
+    level_lib = getattr(unreal, "AAANKPoseLevelTemplateLibrary", None)
+    if not level_lib:
+        create_basic_level()
+        return False
+
+    overrides = unreal.AAANKPoseLevelOverrides()
+    if atmosphere_cmd:
+        fog_density, fog_color, volumetric_albedo = _resolve_atmosphere_presets(atmosphere_cmd)
+        overrides.override_fog = True
+        overrides.fog_density = fog_density
+        overrides.fog_color = unreal.LinearColor(r=fog_color[0], g=fog_color[1], b=fog_color[2])
+        overrides.fog_height_falloff = atmosphere_cmd.get("fog_height_falloff", 0.2)
+        overrides.fog_max_opacity = atmosphere_cmd.get("fog_max_opacity", 1.0)
+        overrides.fog_start_distance = atmosphere_cmd.get("start_distance", 0)
+        overrides.volumetric_fog = atmosphere_cmd.get("volumetric", False)
+        overrides.volumetric_scattering = atmosphere_cmd.get("volumetric_scattering", 1.0)
+        overrides.volumetric_albedo = unreal.LinearColor(r=volumetric_albedo[0], g=volumetric_albedo[1], b=volumetric_albedo[2])
+
+    level_path = level_lib.get_movie_level_path(scene_name)
+    if not level_lib.create_movie_level(level_path, "", overrides):
+        log(f"✗ Failed to open {level_path} from the movie template")
+        return False
+    log(f"✓ Level ready: {level_path}")
+    return bool(atmosphere_cmd)
+
+
+# Color presets
+COLOR_PRESETS = {
+    "white": (1.0, 1.0, 1.0),
+    "gray": (0.5, 0.5, 0.5),
+    "blue": (0.6, 0.7, 1.0),
+    "mystical": (0.5, 1.0, 0.7),
+    "orange": (1.0, 0.6, 0.3),
+    "purple": (0.8, 0.4, 1.0),
+    "forest": (0.3, 0.8, 0.4),
+}
+
+# Density presets
+DENSITY_PRESETS = {
+    "clear": 0.01,
+    "light": 0.02,
+    "medium": 0.05,
+    "heavy": 0.1,
+    "dense": 0.2,
+}
+
+
+def _resolve_atmosphere_presets(cmd):
+    """Fog density, fog color and volumetric albedo of an add_atmosphere command, presets resolved."""
+    fog_density = cmd.get("fog_density", 0.02)
+    if isinstance(fog_density, str):
+        fog_density = DENSITY_PRESETS.get(fog_density, 0.02)
+    fog_color = cmd.get("fog_color", (0.6, 0.7, 1.0))
+    if isinstance(fog_color, str):
+        fog_color = COLOR_PRESETS.get(fog_color, (0.6, 0.7, 1.0))
+    volumetric_albedo = cmd.get("volumetric_albedo", (0.9, 0.9, 0.9))
+    if isinstance(volumetric_albedo, str):
+        volumetric_albedo = COLOR_PRESETS.get(volumetric_albedo, (0.9, 0.9, 0.9))
+    return fog_density, fog_color, volumetric_albedo
+
+
 def apply_atmosphere_settings(cmd):
     """Apply atmosphere/fog settings to the level's ExponentialHeightFog actor."""
     
-    # Color presets
-    COLOR_PRESETS = {
-        "white": (1.0, 1.0, 1.0),
-        "gray": (0.5, 0.5, 0.5),
-        "blue": (0.6, 0.7, 1.0),
-        "mystical": (0.5, 1.0, 0.7),
-        "orange": (1.0, 0.6, 0.3),
-        "purple": (0.8, 0.4, 1.0),
-        "forest": (0.3, 0.8, 0.4),
-    }
-    
-    # Density presets
-    DENSITY_PRESETS = {
-        "clear": 0.01,
-        "light": 0.02,
-        "medium": 0.05,
-        "heavy": 0.1,
-        "dense": 0.2,
-    }
-    
     # Delete all existing fog actors first (clean slate)
     fog_actors = unreal.GameplayStatics.get_all_actors_of_class(
         unreal.EditorLevelLibrary.get_editor_world(),
@@ -110,26 +159,26 @@ def apply_atmosphere_settings(cmd):
     fog_density = cmd.get("fog_density", 0.02)
     if isinstance(fog_density, str):
         fog_density = DENSITY_PRESETS.get(fog_density, 0.02)
-    fog_component.set_editor_property("fog_density", fog_density)
+    writes = [(fog_component, "fog_density", fog_density)]
     
     # Apply fog color (use fog_inscattering_luminance in UE 5.7)
     fog_color = cmd.get("fog_color", (0.6, 0.7, 1.0))
     if isinstance(fog_color, str):
         fog_color = COLOR_PRESETS.get(fog_color, (0.6, 0.7, 1.0))
     color = unreal.LinearColor(r=fog_color[0], g=fog_color[1], b=fog_color[2])
-    fog_component.set_editor_property("fog_inscattering_luminance", color)
+    writes.append((fog_component, "fog_inscattering_luminance", color))
     
     # Apply height falloff
     fog_height_falloff = cmd.get("fog_height_falloff", 0.2)
-    fog_component.set_editor_property("fog_height_falloff", fog_height_falloff)
+    writes.append((fog_component, "fog_height_falloff", fog_height_falloff))
     
     # Apply max opacity
     fog_max_opacity = cmd.get("fog_max_opacity", 1.0)
-    fog_component.set_editor_property("fog_max_opacity", fog_max_opacity)
+    writes.append((fog_component, "fog_max_opacity", fog_max_opacity))
     
     # Apply start distance
     start_distance = cmd.get("start_distance", 0)
-    fog_component.set_editor_property("start_distance", start_distance)
+    writes.append((fog_component, "start_distance", start_distance))
     
     # Apply volumetric fog settings (volumetric_fog boolean doesn't exist in UE 5.7, skip it)
     volumetric = cmd.get("volumetric", False)
@@ -137,7 +186,7 @@ def apply_atmosphere_settings(cmd):
     if volumetric:
         # Apply volumetric scattering intensity
         volumetric_scattering = cmd.get("volumetric_scattering", 1.0)
-        fog_component.set_editor_property("volumetric_fog_scattering_distribution", volumetric_scattering)
+        writes.append((fog_component, "volumetric_fog_scattering_distribution", volumetric_scattering))
         
         # Apply volumetric albedo (uses unreal.Color with 0-255 values)
         volumetric_albedo = cmd.get("volumetric_albedo", (0.9, 0.9, 0.9))
@@ -148,6 +197,9 @@ def apply_atmosphere_settings(cmd):
             g=int(volumetric_albedo[1] * 255),
             b=int(volumetric_albedo[2] * 255)
         )
-        fog_component.set_editor_property("volumetric_fog_albedo", albedo_color)
+        writes.append((fog_component, "volumetric_fog_albedo", albedo_color))
+    
+    # All fog settings land in one batch, so the fog component re-registers once
+    set_properties(writes)
     
     log(f"    Fog density: {fog_density}, color: {fog_color}, volumetric: {volumetric}")
@@ -1,6 +1,7 @@
 
 # Light setup module
 import unreal
+from .property_batch import set_properties
 
 # import logger
 # from logger import log
@@ -8,6 +9,19 @@ import unreal
 def log(msg):
     print(msg)
 
+# light_shafts("subtle" | "cinematic" | "dramatic") -> light shaft bloom scale
+LIGHT_SHAFT_BLOOM_PRESETS = {
+    "subtle": 0.1,
+    "cinematic": 0.3,
+    "dramatic": 0.6,
+}
+
+def _bloom_scale(value):
+    """Bloom preset name or number -> number"""
+    if isinstance(value, str):
+        return LIGHT_SHAFT_BLOOM_PRESETS.get(value, LIGHT_SHAFT_BLOOM_PRESETS["cinematic"])
+    return value
+
 def create_light(name, location, rotation, properties):
     """
     Create and configure a light actor.
@@ -90,31 +104,105 @@ def create_light(name, location, rotation, properties):
             # We didn't expose these yet, assume defaults or use radius as width?
             pass
         
+        # Collected and applied in one batch so the component is updated once
+        writes = []
+        
         # Volumetric settings (applicable to all light types)
         cast_volumetric = properties.get("cast_volumetric_shadow", False)
         if cast_volumetric:
-            comp.set_editor_property("cast_volumetric_shadow", True)
+            writes.append((comp, "cast_volumetric_shadow", True))
             log(f"    Volumetric shadows enabled")
         
         # Light shafts (god rays) - applicable to Directional lights mainly
         if light_type == "Directional":
             use_as_sun = properties.get("use_as_atmospheric_sun", False)
             if use_as_sun:
-                comp.set_editor_property("atmosphere_sun_light", True)
+                writes.append((comp, "atmosphere_sun_light", True))
                 log(f"    Set as atmospheric sun light")
             
             # Light shaft settings
-            light_shaft_bloom = properties.get("light_shaft_bloom_scale", None)
-            light_shaft_occlusion = properties.get("enable_light_shaft_occlusion", None)
+            light_shaft_bloom = _bloom_scale(properties.get("light_shaft_bloom_scale", None))
+            light_shaft_occlusion = properties.get("enable_light_shaft_occlusion", properties.get("light_shaft_occlusion", None))
             
             if light_shaft_bloom is not None:
-                comp.set_editor_property("light_shaft_bloom_scale", light_shaft_bloom)
-                comp.set_editor_property("enable_light_shaft_bloom", True)
+                writes.append((comp, "light_shaft_bloom_scale", light_shaft_bloom))
+                writes.append((comp, "enable_light_shaft_bloom", True))
                 log(f"    Light shaft bloom scale: {light_shaft_bloom}")
             
             if light_shaft_occlusion is not None:
-                comp.set_editor_property("occlusion_mask_darkness", 0.5)
-                comp.set_editor_property("enable_light_shaft_occlusion", light_shaft_occlusion)
+                writes.append((comp, "occlusion_mask_darkness", properties.get("occlusion_mask_darkness", 0.5)))
+                writes.append((comp, "enable_light_shaft_occlusion", light_shaft_occlusion))
                 log(f"    Light shaft occlusion: {light_shaft_occlusion}")
+        
+        if writes:
+            set_properties(writes)
             
     return actor
+
+
+def apply_light_shafts_command(properties, cmd):
+    """Fold a configure_light_shafts scene command into a light's settings before it is created"""
+    merged = dict(properties)
+    if cmd.get("enable_light_shafts", True):
+        merged["light_shaft_bloom_scale"] = cmd.get("bloom_scale", "cinematic")
+        merged["bloom_threshold"] = cmd.get("bloom_threshold", 8.0)
+        merged["enable_light_shaft_occlusion"] = True
+        merged["occlusion_mask_darkness"] = cmd.get("occlusion_mask_darkness", 0.5)
+    else:
+        merged["light_shaft_bloom_scale"] = None
+        merged["enable_light_shaft_occlusion"] = False
+    merged["cast_volumetric_shadow"] = cmd.get("cast_volumetric_shadow", merged.get("cast_volumetric_shadow", False))
+    return merged
+
+def light_descriptor(name, location, rotation, properties):
+    """settings.json light properties -> unreal.AAANKPoseLightDescriptor"""
+    light_type = properties.get("light_type", "Point")
+    color = properties.get("color", [1, 1, 1])
+    bloom = _bloom_scale(properties.get("light_shaft_bloom_scale", None))
+    occlusion = properties.get("enable_light_shaft_occlusion", properties.get("light_shaft_occlusion", False))
+    return unreal.AAANKPoseLightDescriptor(
+        name=name,
+        light_type=getattr(unreal.AAANKPoseLightType, light_type.upper()),
+        transform=unreal.Transform(location, rotation, unreal.Vector(1, 1, 1)),
+        intensity=properties.get("intensity", 5000.0),
+        intensity_units=getattr(unreal.LightUnits, properties.get("intensity_unit", "UNITLESS").upper(), unreal.LightUnits.UNITLESS),
+        color=unreal.LinearColor(color[0], color[1], color[2], 1.0),
+        cast_shadows=properties.get("cast_shadows", True),
+        cast_volumetric_shadow=properties.get("cast_volumetric_shadow", False),
+        attenuation_radius=properties.get("attenuation_radius", properties.get("radius", 1000.0)),
+        inner_cone_angle=properties.get("inner_cone_angle", properties.get("cone_inner", 0.0)),
+        outer_cone_angle=properties.get("outer_cone_angle", properties.get("cone_outer", 44.0)),
+        atmosphere_sun_light=properties.get("use_as_atmospheric_sun", False),
+        enable_light_shaft_bloom=bloom is not None,
+        bloom_scale=bloom if bloom is not None else 0.2,
+        bloom_threshold=properties.get("bloom_threshold", 8.0),
+        enable_light_shaft_occlusion=bool(occlusion),
+        occlusion_mask_darkness=properties.get("occlusion_mask_darkness", 0.5),
+    )
+
+def spawn_light_rig(lights):
+    """
+    Spawn every light of a scene in one call.
+    lights: list of (name, location, rotation, properties) as create_light takes them.
+    Returns {name: actor}. Uses the native rig builder (deferred spawn, each light configured
+    before it registers) when the plugin is loaded, else create_light per light.
+    """
+    rig_lib = getattr(unreal, "AAANKPoseLightRigLibrary", None)
+    if not rig_lib:
+        return {name: create_light(name, location, rotation, properties)
+                for name, location, rotation, properties in lights}
+
+    rig = unreal.AAANKPoseLightRig(lights=[light_descriptor(*light) for light in lights])
+    actors = rig_lib.spawn_light_rig(None, rig)
+    log(f"  Light rig: spawned {len([a for a in actors if a])}/{len(lights)} lights")
+    return {light[0]: actor for light, actor in zip(lights, actors)}
+
+def spawn_light_rig_preset(preset):
+    """Spawn a cached native preset ("god_rays", "cathedral"); returns the actors"""
+    rig_lib = getattr(unreal, "AAANKPoseLightRigLibrary", None)
+    if not rig_lib:
+        log(f"  ⚠ Light rig preset '{preset}' needs the AAANKPose plugin")
+        return []
+    actors = rig_lib.spawn_light_rig_preset(None, preset)
+    log(f"  Light rig preset '{preset}': spawned {len(actors)} lights")
+    return actors
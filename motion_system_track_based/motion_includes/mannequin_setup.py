@@ -78,23 +78,29 @@ def create_mannequin(mannequin_name, location=None, rotation=None, mesh_path=Non
             None, Characters.QUINN_THIRD_PERSON.path)
 
     if skeletal_mesh:
-        # Spawn a SkeletalMeshActor
+        # Prefer the plugin's lightweight mannequin (no tick, no collision) over a SkeletalMeshActor
+        native_class = getattr(unreal, "AAANKPoseMannequin", None)
         mannequin = unreal.EditorLevelLibrary.spawn_actor_from_class(
-            unreal.SkeletalMeshActor,
+            native_class or unreal.SkeletalMeshActor,
             location,
             rotation
         )
 
         if mannequin:
             mannequin.set_actor_label(mannequin_name)
-            mannequin.tags.append("MotionSystemActor")
 
-            # Set the skeletal mesh on the component
-            skel_comp = mannequin.skeletal_mesh_component
-            skel_comp.set_skinned_asset_and_update(skeletal_mesh)
-            
-            if mesh_rotation:
-                skel_comp.set_editor_property("relative_rotation", mesh_rotation)
+            if native_class:
+                # Already tagged MotionSystemActor by the class
+                mannequin.setup_mannequin(skeletal_mesh, mesh_rotation or unreal.Rotator(0, 0, 0), [])
+            else:
+                mannequin.tags.append("MotionSystemActor")
+
+                # Set the skeletal mesh on the component
+                skel_comp = mannequin.skeletal_mesh_component
+                skel_comp.set_skinned_asset_and_update(skeletal_mesh)
+                
+                if mesh_rotation:
+                    skel_comp.set_editor_property("relative_rotation", mesh_rotation)
 
             log(f"✓ Mannequin created: {mannequin_name}")
             log(f"  Location: {location}")
@@ -145,8 +151,7 @@ def spawn_thick_line(name, start, end, thickness_cm=50.0, color_name="Red"):
             actor.set_actor_scale3d(scale)
             
             # 5. Apply Material
-            mat_path = Materials.get_color(color_name)
-            mat = unreal.load_object(None, mat_path)
+            mat = Materials.get_color_material(color_name)
             if mat:
                 smc.set_material(0, mat)
             
@@ -0,0 +1,70 @@
+"""
+Batched property writes.
+
+set_properties([(object, "focus_settings.focus_method", value), ...]) hands every write to the
+native AAANKPosePropertyBatchLibrary in one call: paths resolve through a cached property chain and
+each object gets one change notification after all of its writes. Without the plugin it falls back
+to set_editor_property, doing the get/modify/set dance for struct paths.
+"""
+import unreal
+
+
+def log(message, log_file=None):
+    """Print message"""
+    print(message)
+
+
+def _to_export_text(value):
+    """Python value -> the property export text ImportText parses"""
+    if isinstance(value, bool):
+        return "True" if value else "False"
+    if isinstance(value, (int, float)):
+        return repr(value)
+    if isinstance(value, str):
+        return value
+    if value is None:
+        return "None"
+    if isinstance(value, unreal.Object):
+        return value.get_path_name()
+    if isinstance(value, unreal.EnumBase):
+        return value.name
+    if isinstance(value, unreal.StructBase):
+        return value.export_text()
+    return str(value)
+
+
+def _set_path(obj, names, value):
+    """set_editor_property along a dotted path, writing modified structs back to their owner"""
+    if len(names) == 1:
+        obj.set_editor_property(names[0], value)
+        return
+    inner = obj.get_editor_property(names[0])
+    _set_path(inner, names[1:], value)
+    if not isinstance(inner, unreal.Object):
+        obj.set_editor_property(names[0], inner)
+
+
+def set_properties(writes):
+    """
+    Apply (object, path, value) writes. Paths are dot-separated property names, e.g.
+    "lookat_tracking_settings.actor_to_track". Returns the number of writes applied.
+    """
+    batch_lib = getattr(unreal, "AAANKPosePropertyBatchLibrary", None)
+    if batch_lib:
+        batch = [
+            unreal.AAANKPosePropertyWrite(object=obj, path=path, value=_to_export_text(value))
+            for obj, path, value in writes
+        ]
+        result = batch_lib.set_properties(batch)
+        for error in result.errors:
+            log(f"    [WARN] {error}")
+        return result.applied
+
+    applied = 0
+    for obj, path, value in writes:
+        try:
+            _set_path(obj, path.split("."), value)
+            applied += 1
+        except Exception as e:
+            log(f"    [WARN] {obj.get_name()}.{path}: {e}")
+    return applied
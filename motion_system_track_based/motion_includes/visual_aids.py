@@ -50,7 +50,7 @@ def create_plus_sign_at_origin():
                     pass
                 plus_x.set_actor_scale3d(unreal.Vector(9.5, .25, 0.01))
 
-                mat = unreal.EditorAssetLibrary.load_asset(Materials.RED)
+                mat = Materials.get_color_material("red")
                 if mat:
                     smc.set_material(0, mat)
                     log("✓ +X axis (Red, 10m)")
@@ -75,7 +75,7 @@ def create_plus_sign_at_origin():
                     pass
                 minus_x.set_actor_scale3d(unreal.Vector(9.5, 1.0, 0.01))
 
-                mat = unreal.EditorAssetLibrary.load_asset(Materials.YELLOW)
+                mat = Materials.get_color_material("yellow")
                 if mat:
                     smc.set_material(0, mat)
                     log("✓ -X axis (Yellow, 10m)")
@@ -100,7 +100,7 @@ def create_plus_sign_at_origin():
                     pass
                 plus_y.set_actor_scale3d(unreal.Vector(1.0, 9.5, 0.01))
 
-                mat = unreal.EditorAssetLibrary.load_asset(Materials.GREEN)
+                mat = Materials.get_color_material("green")
                 if mat:
                     smc.set_material(0, mat)
                     log("✓ +Y axis (Green, 10m)")
@@ -125,7 +125,7 @@ def create_plus_sign_at_origin():
                     pass
                 minus_y.set_actor_scale3d(unreal.Vector(1.0, 9.5, 0.01))
 
-                mat = unreal.EditorAssetLibrary.load_asset(Materials.BLUE)
+                mat = Materials.get_color_material("blue")
                 if mat:
                     smc.set_material(0, mat)
                     log("✓ -Y axis (Purple/Blue, 10m)")
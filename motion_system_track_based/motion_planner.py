@@ -8,6 +8,7 @@ import math
 import os
 from typing import Dict, List, Tuple, Any
 from motion_builder import (CHARACTER_HEIGHT)
+from motion_structs import track_chunks
 
 
 def euclidean_distance_3d(p1: Tuple[float, float, float], p2: Tuple[float, float, float]) -> float:
@@ -92,13 +93,8 @@ def calculate_look_at_rotation(camera_pos: Tuple[float, float, float],
 
 
 def load_actor_transform(movie_folder: str, actor_name: str) -> List[Dict]:
-    """Load actor's transform.json keyframes."""
-    transform_path = os.path.join(movie_folder, actor_name, "transform.json")
-    if not os.path.exists(transform_path):
-        return []
-    
-    with open(transform_path, 'r', encoding='utf-8') as f:
-        return json.load(f)
+    """Load actor's transform keyframes (transform.json or every chunked window)."""
+    return track_chunks.load_transform(os.path.join(movie_folder, actor_name))
 
 
 def get_position_at_frame(keyframes: List[Dict], frame: int) -> Tuple[float, float, float]:
@@ -167,9 +163,9 @@ def generate_camera_keyframes(movie_folder: str, camera_name: str,
     # Load camera's static position
     camera_pos = camera_location
     if not camera_pos:
-        camera_transform = load_actor_transform(movie_folder, camera_name)
-        if camera_transform:
-            camera_pos = (camera_transform[0]["x"], camera_transform[0]["y"], camera_transform[0]["z"])
+        first_key = track_chunks.TransformWindowReader(os.path.join(movie_folder, camera_name)).first_key()
+        if first_key:
+            camera_pos = (first_key["x"], first_key["y"], first_key["z"])
         else:
             camera_pos = (0, 0, 0)  # Default
     
@@ -183,7 +179,7 @@ def generate_camera_keyframes(movie_folder: str, camera_name: str,
         
         if start_time <= 0:
              # Load subject's transform at frame 0
-            subject_keyframes = load_actor_transform(movie_folder, actor_name)
+            subject_keyframes = track_chunks.load_window(os.path.join(movie_folder, actor_name), 0, 0)
             if subject_keyframes:
                 # Find frame 0
                 target_pos = None
@@ -216,7 +212,8 @@ def generate_camera_keyframes(movie_folder: str, camera_name: str,
         start_frame = int(start_time * fps)
         end_frame = int(end_time * fps) if end_time else 99999
         
-        subject_keyframes = load_actor_transform(movie_folder, actor_name)
+        # Frames are visited in order, so only the windows around the current frame are loaded
+        subject_keyframes = track_chunks.TransformWindowReader(os.path.join(movie_folder, actor_name))
         if not subject_keyframes:
             continue
         
@@ -225,7 +222,7 @@ def generate_camera_keyframes(movie_folder: str, camera_name: str,
         change_threshold = 0.10  # 10% change (reduced from 5% to minimize keyframes)
         
         for frame in range(start_frame, min(end_frame + 1, 10000), 1):
-            subject_pos = get_position_at_frame(subject_keyframes, frame)
+            subject_pos = subject_keyframes.location_at(frame)
             focal_length = calculate_focal_length(camera_pos, subject_pos, coverage=coverage)
             
             # Only add keyframe if significant change
@@ -242,7 +239,8 @@ def generate_camera_keyframes(movie_folder: str, camera_name: str,
         start_frame = int(start_time * fps)
         end_frame = int(end_time * fps) if end_time else 99999
         
-        subject_keyframes = load_actor_transform(movie_folder, actor_name)
+        # Frames are visited in order, so only the windows around the current frame are loaded
+        subject_keyframes = track_chunks.TransformWindowReader(os.path.join(movie_folder, actor_name))
         if not subject_keyframes:
             continue
         
@@ -251,7 +249,7 @@ def generate_camera_keyframes(movie_folder: str, camera_name: str,
         change_threshold = 0.10  # 10% change (reduced from 5% to minimize keyframes)
         
         for frame in range(start_frame, min(end_frame + 1, 10000), 1):
-            subject_pos = get_position_at_frame(subject_keyframes, frame)
+            subject_pos = subject_keyframes.location_at(frame)
             subject_pos = (subject_pos[0], subject_pos[1], subject_pos[2] + CHARACTER_HEIGHT * height_pct)
             focus_dist = euclidean_distance_3d(camera_pos, subject_pos) / 100.0  # Convert to meters
             
@@ -321,28 +319,25 @@ def plan_motion(movie_folder: str) -> Dict[str, Any]:
         }
         
         # Load Transform
-        transform_path = os.path.join(actor_folder, "transform.json")
-        if os.path.exists(transform_path):
-            with open(transform_path, 'r', encoding='utf-8') as f:
-                transforms = json.load(f)
-                for t in transforms:
-                    # Location
-                    if "x" in t and "y" in t and "z" in t:
-                        keyframes["location"].append({
-                            "frame": t["frame"],
-                            "x": t["x"],
-                            "y": t["y"],
-                            "z": t["z"]
-                        })
-                    
-                    # Rotation
-                    if "roll" in t and "pitch" in t and "yaw" in t:
-                        keyframes["rotation"].append({
-                            "frame": t["frame"],
-                            "roll": t["roll"],
-                            "pitch": t["pitch"],
-                            "yaw": t["yaw"]
-                        })
+        for transforms in track_chunks.iter_windows(actor_folder):
+            for t in transforms:
+                # Location
+                if "x" in t and "y" in t and "z" in t:
+                    keyframes["location"].append({
+                        "frame": t["frame"],
+                        "x": t["x"],
+                        "y": t["y"],
+                        "z": t["z"]
+                    })
+                
+                # Rotation
+                if "roll" in t and "pitch" in t and "yaw" in t:
+                    keyframes["rotation"].append({
+                        "frame": t["frame"],
+                        "roll": t["roll"],
+                        "pitch": t["pitch"],
+                        "yaw": t["yaw"]
+                    })
 
         # Load Animation
         anim_path = os.path.join(actor_folder, "animation.json")
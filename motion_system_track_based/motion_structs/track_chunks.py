@@ -0,0 +1,224 @@
+"""
+Chunked transform track storage for very long takes.
+
+Instead of one transform.json, a chunked actor has:
+
+    ActorName/transform/
+    ├── index.json      # {format, window_frames, first_frame, last_frame, count, chunks: [{file, start_frame, end_frame, count}]}
+    ├── 000000.json     # keys with frame // window_frames == 0, same entries as transform.json
+    └── 000001.json
+
+Readers open only the windows they touch (FAAANKPoseTransformReader is the native twin of
+TransformWindowReader). load_transform() still returns every key for callers that need them all.
+"""
+from __future__ import annotations
+import json
+import os
+import shutil
+from typing import Any, Dict, Iterator, List, Optional
+
+CHUNK_FOLDER = "transform"
+INDEX_FILE = "index.json"
+
+# 10 seconds at 60 fps
+DEFAULT_WINDOW_FRAMES = 600
+
+
+def _chunk_folder(actor_folder: str) -> str:
+    return os.path.join(actor_folder, CHUNK_FOLDER)
+
+
+def save_chunked(actor_folder: str, keys: List[Dict[str, Any]], window_frames: int = DEFAULT_WINDOW_FRAMES):
+    """Write keys as fixed windows plus an index, replacing transform.json and any previous windows."""
+    if window_frames <= 0:
+        raise ValueError(f"window_frames must be positive, got {window_frames}")
+
+    folder = _chunk_folder(actor_folder)
+    shutil.rmtree(folder, ignore_errors=True)
+    os.makedirs(folder, exist_ok=True)
+
+    keys = sorted(keys, key=lambda k: k["frame"])
+    chunks = []
+    start = 0
+    while start < len(keys):
+        window = int(keys[start]["frame"] // window_frames)
+        end = start + 1
+        while end < len(keys) and int(keys[end]["frame"] // window_frames) == window:
+            end += 1
+        file_name = f"{window:06d}.json"
+        with open(os.path.join(folder, file_name), 'w', encoding='utf-8') as f:
+            json.dump(keys[start:end], f)
+        chunks.append({"file": file_name, "start_frame": keys[start]["frame"],
+                       "end_frame": keys[end - 1]["frame"], "count": end - start})
+        start = end
+
+    index = {
+        "format": "chunked",
+        "window_frames": window_frames,
+        "first_frame": keys[0]["frame"] if keys else 0,
+        "last_frame": keys[-1]["frame"] if keys else 0,
+        "count": len(keys),
+        "chunks": chunks,
+    }
+    # Index last, so a reader never sees it list a window that isn't written yet
+    with open(os.path.join(folder, INDEX_FILE), 'w', encoding='utf-8') as f:
+        json.dump(index, f, indent=2)
+
+    legacy_path = os.path.join(actor_folder, "transform.json")
+    if os.path.exists(legacy_path):
+        os.remove(legacy_path)
+
+
+def load_index(actor_folder: str) -> Optional[Dict[str, Any]]:
+    """The chunk index, or None if the actor stores a single transform.json."""
+    index_path = os.path.join(_chunk_folder(actor_folder), INDEX_FILE)
+    if not os.path.exists(index_path):
+        return None
+    with open(index_path, 'r', encoding='utf-8') as f:
+        return json.load(f)
+
+
+def _load_chunk(actor_folder: str, chunk: Dict[str, Any]) -> List[Dict[str, Any]]:
+    with open(os.path.join(_chunk_folder(actor_folder), chunk["file"]), 'r', encoding='utf-8') as f:
+        return json.load(f)
+
+
+def load_window(actor_folder: str, start_frame: int, end_frame: int) -> List[Dict[str, Any]]:
+    """Keys of the windows overlapping [start_frame, end_frame]; the whole track if not chunked."""
+    index = load_index(actor_folder)
+    if index is None:
+        return load_transform(actor_folder)
+    keys = []
+    for chunk in index["chunks"]:
+        if chunk["end_frame"] >= start_frame and chunk["start_frame"] <= end_frame:
+            keys.extend(_load_chunk(actor_folder, chunk))
+    return sorted(keys, key=lambda k: k["frame"])
+
+
+def iter_windows(actor_folder: str) -> Iterator[List[Dict[str, Any]]]:
+    """Yield the track one window at a time in frame order (one window for transform.json)."""
+    index = load_index(actor_folder)
+    if index is None:
+        keys = load_transform(actor_folder)
+        if keys:
+            yield keys
+        return
+    for chunk in index["chunks"]:
+        yield sorted(_load_chunk(actor_folder, chunk), key=lambda k: k["frame"])
+
+
+def load_transform(actor_folder: str) -> List[Dict[str, Any]]:
+    """Every key of either layout, sorted by frame; [] if the actor has no transform track."""
+    index = load_index(actor_folder)
+    if index is not None:
+        keys = []
+        for chunk in index["chunks"]:
+            keys.extend(_load_chunk(actor_folder, chunk))
+        return sorted(keys, key=lambda k: k["frame"])
+
+    transform_path = os.path.join(actor_folder, "transform.json")
+    if not os.path.exists(transform_path):
+        return []
+    with open(transform_path, 'r', encoding='utf-8') as f:
+        return json.load(f)
+
+
+def frame_range(actor_folder: str):
+    """(first key, last frame, key count) reading at most one window; (None, 0, 0) without a track."""
+    index = load_index(actor_folder)
+    if index is not None:
+        first = load_window(actor_folder, index["first_frame"], index["first_frame"])
+        return (first[0] if first else None), index["last_frame"], index["count"]
+    keys = load_transform(actor_folder)
+    if not keys:
+        return None, 0, 0
+    return keys[0], max(k.get("frame", 0) for k in keys), len(keys)
+
+
+class TransformWindowReader:
+    """
+    Linear location/rotation sampling that keeps only the windows around the sampled frame loaded.
+    Same result as interpolating over the whole track; cheapest when frames are visited in order.
+    """
+
+    def __init__(self, actor_folder: str):
+        self.actor_folder = actor_folder
+        self.index = load_index(actor_folder)
+        self._resident: Dict[int, List[Dict[str, Any]]] = {}
+        self._all = None if self.index is not None else load_transform(actor_folder)
+        self.windows_loaded = 0
+
+    def __bool__(self):
+        if self.index is not None:
+            return bool(self.index["chunks"])
+        return bool(self._all)
+
+    def first_key(self) -> Optional[Dict[str, Any]]:
+        if self.index is None:
+            return self._all[0] if self._all else None
+        keys = self._chunk(0) if self.index["chunks"] else []
+        return keys[0] if keys else None
+
+    def _chunk(self, chunk_index: int) -> List[Dict[str, Any]]:
+        if chunk_index not in self._resident:
+            # Only neighbours can still be needed to interpolate across a window boundary
+            for stale in [i for i in self._resident if abs(i - chunk_index) > 1]:
+                del self._resident[stale]
+            chunk = self.index["chunks"][chunk_index]
+            self._resident[chunk_index] = sorted(_load_chunk(self.actor_folder, chunk), key=lambda k: k["frame"])
+            self.windows_loaded += 1
+        return self._resident[chunk_index]
+
+    def _find_chunk(self, frame: float) -> int:
+        chunks = self.index["chunks"]
+        low, high = 0, len(chunks) - 1
+        while low < high:
+            mid = (low + high + 1) // 2
+            if chunks[mid]["start_frame"] <= frame:
+                low = mid
+            else:
+                high = mid - 1
+        return low
+
+    def _keys_around(self, frame: float) -> List[Dict[str, Any]]:
+        if self.index is None:
+            return self._all or []
+        if not self.index["chunks"]:
+            return []
+        chunk_index = self._find_chunk(frame)
+        chunk = self.index["chunks"][chunk_index]
+        if frame <= chunk["end_frame"] or chunk_index == len(self.index["chunks"]) - 1:
+            return self._chunk(chunk_index)
+        return self._chunk(chunk_index)[-1:] + self._chunk(chunk_index + 1)[:1]
+
+    def sample(self, frame: float) -> Optional[Dict[str, Any]]:
+        """Interpolated {frame, x, y, z, roll, pitch, yaw}, clamped at both ends; None without keys."""
+        keys = self._keys_around(frame)
+        if not keys:
+            return None
+        if frame <= keys[0]["frame"]:
+            return dict(keys[0])
+        if frame >= keys[-1]["frame"]:
+            return dict(keys[-1])
+
+        low, high = 0, len(keys) - 1
+        while high - low > 1:
+            mid = (low + high) // 2
+            if keys[mid]["frame"] <= frame:
+                low = mid
+            else:
+                high = mid
+        a, b = keys[low], keys[high]
+        span = b["frame"] - a["frame"]
+        t = (frame - a["frame"]) / span if span else 0.0
+        result = {"frame": frame}
+        for field in ("x", "y", "z", "roll", "pitch", "yaw"):
+            if field in a and field in b:
+                result[field] = a[field] + (b[field] - a[field]) * t
+        return result
+
+    def location_at(self, frame: float):
+        key = self.sample(frame)
+        if not key:
+            return (0, 0, 0)
+        return (key.get("x", 0), key.get("y", 0), key.get("z", 0))
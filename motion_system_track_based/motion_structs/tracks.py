@@ -1,6 +1,7 @@
 from __future__ import annotations
 import os
 import json
+import shutil
 from typing import Dict, List, Any, Tuple
 
 class Keyframe:
@@ -73,6 +74,25 @@ class TransformTrack(Track):
     """
     def __init__(self):
         super().__init__("transform")
+        # Frames per window when saved chunked (see track_chunks); None writes a single transform.json
+        self.chunk_frames = None
+    
+    def save(self, folder_path: str):
+        """Save as transform.json, or as fixed windows plus an index when chunk_frames is set."""
+        # The plan a root motion bake kept aside is stale once the plan itself is rewritten
+        shutil.rmtree(os.path.join(folder_path, "planned"), ignore_errors=True)
+        self.save_keys(folder_path, self.to_dict())
+    
+    def save_keys(self, folder_path: str, keys: List[Dict[str, Any]]):
+        """Write keys in this track's layout, replacing whatever the actor stored before."""
+        if self.chunk_frames:
+            from motion_structs import track_chunks
+            track_chunks.save_chunked(folder_path, keys, self.chunk_frames)
+            return
+        # A previous chunked save would otherwise shadow the new transform.json
+        shutil.rmtree(os.path.join(folder_path, "transform"), ignore_errors=True)
+        with open(os.path.join(folder_path, f"{self.name}.json"), 'w', encoding='utf-8') as f:
+            json.dump(keys, f, indent=2)
     
     def get_location_at_frame(self, frame: float) -> Tuple[float, float, float]:
         """Interpolate location at a specific frame."""
@@ -60,6 +60,11 @@ GRID_SIZE = 50  # 50x50 = 2500 elevation queries (be mindful of API limits)
 HORIZONTAL_SCALE = 100.0  # Unreal units per meter
 VERTICAL_SCALE = 1.0      # Vertical exaggeration (1.0 = realistic)
 
+# Synthetic terrain (AAANKPose plugin): a seeded plateau with a terraced canyon, imported as one landscape.
+# Set to None to fetch real elevation instead.
+SYNTHETIC_SEED = 7
+SYNTHETIC_RESOLUTION = 2017  # Samples per side
+
 # ==============================================================================
 # ELEVATION DATA FETCHING
 # ==============================================================================
@@ -230,6 +235,41 @@ def apply_canyon_color(actor, elevation_normalized):
         dmi.set_vector_parameter_value("Color", color)
         dmi.set_scalar_parameter_value("Roughness", 0.9)
 
+def synthesize_canyon_landscape(terrain_lib):
+    """Generate the canyon natively (noise, erosion, carving) and import it as a landscape in one call"""
+    log(f"\n1. Synthesizing {SYNTHETIC_RESOLUTION}x{SYNTHETIC_RESOLUTION} canyon terrain (seed {SYNTHETIC_SEED})...")
+    
+    total_width = AREA_SIZE_KM * 1000 * HORIZONTAL_SCALE
+    
+    # Meandering river course across the area, in cm from the terrain corner
+    river = [
+        unreal.Vector(total_width * x, total_width * y, 0)
+        for x, y in [(0.0, 0.45), (0.2, 0.55), (0.4, 0.4), (0.6, 0.6), (0.8, 0.45), (1.0, 0.55)]
+    ]
+    canyon = unreal.AAANKPoseCanyonPath(
+        points=river,
+        width=total_width * 0.35,
+        depth=1200 * HORIZONTAL_SCALE * VERTICAL_SCALE,  # ~1.2km deep
+        floor_fraction=0.1,
+        wall_exponent=3.0,
+        terraces=6
+    )
+    settings = unreal.AAANKPoseTerrainSettings(
+        seed=SYNTHETIC_SEED,
+        resolution=SYNTHETIC_RESOLUTION,
+        sample_spacing=total_width / (SYNTHETIC_RESOLUTION - 1),
+        relief=250 * HORIZONTAL_SCALE * VERTICAL_SCALE,  # Rolling plateau
+        feature_size=total_width / 3,
+        ridged=0.4,
+        canyons=[canyon]
+    )
+    
+    corner = unreal.Vector(-total_width / 2, -total_width / 2, 0)
+    landscape = terrain_lib.synthesize_landscape(None, settings, corner, None, "GrandCanyon_Landscape")
+    if landscape:
+        log(f"  ✓ Landscape created ({total_width:.0f} x {total_width:.0f} units)")
+    return landscape
+
 # ==============================================================================
 # LIGHTING & CAMERA
 # ==============================================================================
@@ -295,16 +335,23 @@ print("=" * 80)
 try:
     cleanup_old_terrain()
     
-    # Fetch elevation data
-    result = generate_elevation_grid()
-    if result is None:
-        log("\n✗ Failed to generate terrain - could not fetch elevation data")
-        sys.exit(1)
-    
-    elevation_grid, min_elev, max_elev = result
-    
-    # Create terrain
-    create_terrain_mesh(elevation_grid, min_elev, max_elev)
+    terrain_lib = getattr(unreal, "AAANKPoseTerrainLibrary", None)
+    if terrain_lib and SYNTHETIC_SEED is not None:
+        if not synthesize_canyon_landscape(terrain_lib):
+            log("\n✗ Failed to synthesize terrain")
+            sys.exit(1)
+        min_elev, max_elev = 0.0, 0.0
+    else:
+        # Fetch elevation data
+        result = generate_elevation_grid()
+        if result is None:
+            log("\n✗ Failed to generate terrain - could not fetch elevation data")
+            sys.exit(1)
+        
+        elevation_grid, min_elev, max_elev = result
+        
+        # Create terrain
+        create_terrain_mesh(elevation_grid, min_elev, max_elev)
     
     # Add scene elements
     add_lighting()
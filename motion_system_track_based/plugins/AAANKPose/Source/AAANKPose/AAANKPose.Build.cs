@@ -35,8 +35,16 @@ public class AAANKPose : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
+				"AAANKPoseMath",
+				"CinematicCamera",
 				"CoreUObject",
 				"Engine",
+				"Json",
+				"Landscape",
+				"LevelSequence",
+				"MovieScene",
+				"MovieSceneTracks",
+				"Projects",
 				"Slate",
 				"SlateCore",
 				// ... add private dependencies that you statically link with here ...	
@@ -47,6 +55,9 @@ public class AAANKPose : ModuleRules
 		if (Target.bBuildEditor)
 		{
 			PrivateDependencyModuleNames.Add("UnrealEd");
+			PrivateDependencyModuleNames.Add("AssetRegistry");
+			PrivateDependencyModuleNames.Add("DirectoryWatcher");
+			PrivateDependencyModuleNames.Add("LevelEditor");
 		}
 		
 		DynamicallyLoadedModuleNames.AddRange(
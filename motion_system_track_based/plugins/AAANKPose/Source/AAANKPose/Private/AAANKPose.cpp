@@ -1,9 +1,45 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "AAANKPose.h"
+#include "AAANKPoseBufferBridge.h"
+#include "AAANKPoseLiveApply.h"
+#include "HAL/FileManager.h"
+#include "LevelSequence.h"
+#include "Misc/Paths.h"
+
+#if WITH_EDITOR
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#endif
 
 #define LOCTEXT_NAMESPACE "FAAANKPoseModule"
 
+namespace AAANKPoseModule
+{
+	/** Quiet period after the last write before changed actors are applied */
+	static const double DebounceSeconds = 0.25;
+
+	static FString NormalizeFolder(const FString& Folder)
+	{
+		FString Normalized = FPaths::ConvertRelativePathToFull(Folder);
+		FPaths::NormalizeDirectoryName(Normalized);
+		return Normalized;
+	}
+
+	/** Files live apply reacts to, relative to the movie folder */
+	static bool IsWatchedFile(const FString& RelativePath)
+	{
+		FString ActorName;
+		return FAAANKPoseLiveApply::IsActorTrackFile(RelativePath, ActorName) || FAAANKPoseLiveApply::NeedsRebuild(RelativePath);
+	}
+
+	/** Invalid for a file that no longer exists, so a deletion reads as a change */
+	static FMD5Hash HashFile(const FString& MovieFolder, const FString& RelativePath)
+	{
+		return FMD5Hash::HashFile(*FPaths::Combine(MovieFolder, RelativePath));
+	}
+}
+
 void FAAANKPoseModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
@@ -13,6 +49,13 @@ void FAAANKPoseModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	TArray<FString> Folders;
+	WatchedFolders.GetKeys(Folders);
+	for (const FString& Folder : Folders)
+	{
+		UnwatchMovieFolder(Folder);
+	}
+	FAAANKPoseBufferRegistry::ReleaseAll();
 }
 
 FString FAAANKPoseModule::HelloWorld()
@@ -20,6 +63,179 @@ FString FAAANKPoseModule::HelloWorld()
 	return TEXT("Hello World");
 }
 
+bool FAAANKPoseModule::WatchMovieFolder(const FString& MovieFolder, ULevelSequence* Sequence)
+{
+#if WITH_EDITOR
+	const FString Folder = AAANKPoseModule::NormalizeFolder(MovieFolder);
+	if (!Sequence || !FPaths::DirectoryExists(Folder))
+	{
+		UE_LOG(LogTemp, Error, TEXT("WatchMovieFolder: Need an existing folder and a sequence (got '%s')"), *Folder);
+		return false;
+	}
+	UnwatchMovieFolder(Folder);
+
+	IDirectoryWatcher* Watcher = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")).Get();
+	FWatchedMovieFolder Watched;
+	Watched.Sequence = Sequence;
+
+	// Baseline: the sequence was just built from what is on disk now
+	IFileManager::Get().IterateDirectoryRecursively(*Folder, [&Folder, &Watched](const TCHAR* Path, bool bIsDirectory)
+	{
+		FString RelativePath(Path);
+		if (!bIsDirectory && FPaths::MakePathRelativeTo(RelativePath, *(Folder / TEXT(""))) && AAANKPoseModule::IsWatchedFile(RelativePath))
+		{
+			Watched.FileHashes.Add(RelativePath, AAANKPoseModule::HashFile(Folder, RelativePath));
+		}
+		return true;
+	});
+
+	if (!Watcher || !Watcher->RegisterDirectoryChangedCallback_Handle(Folder,
+		IDirectoryWatcher::FDirectoryChanged::CreateRaw(this, &FAAANKPoseModule::OnMovieFolderChanged, Folder), Watched.WatchHandle))
+	{
+		UE_LOG(LogTemp, Error, TEXT("WatchMovieFolder: Could not watch '%s'"), *Folder);
+		return false;
+	}
+	WatchedFolders.Add(Folder, MoveTemp(Watched));
+
+	if (!LiveApplyTickerHandle.IsValid())
+	{
+		LiveApplyTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FAAANKPoseModule::TickLiveApply), 0.05f);
+	}
+	UE_LOG(LogTemp, Log, TEXT("WatchMovieFolder: Applying changes in '%s' to %s"), *Folder, *Sequence->GetName());
+	return true;
+#else
+	UE_LOG(LogTemp, Warning, TEXT("WatchMovieFolder: Live apply is only available in the editor"));
+	return false;
+#endif
+}
+
+bool FAAANKPoseModule::UnwatchMovieFolder(const FString& MovieFolder)
+{
+	FWatchedMovieFolder Watched;
+	if (!WatchedFolders.RemoveAndCopyValue(AAANKPoseModule::NormalizeFolder(MovieFolder), Watched))
+	{
+		return false;
+	}
+
+#if WITH_EDITOR
+	if (FDirectoryWatcherModule* WatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+	{
+		if (IDirectoryWatcher* Watcher = WatcherModule->Get())
+		{
+			Watcher->UnregisterDirectoryChangedCallback_Handle(AAANKPoseModule::NormalizeFolder(MovieFolder), Watched.WatchHandle);
+		}
+	}
+#endif
+
+	if (WatchedFolders.Num() == 0 && LiveApplyTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(LiveApplyTickerHandle);
+		LiveApplyTickerHandle.Reset();
+	}
+	return true;
+}
+
+TArray<FString> FAAANKPoseModule::GetWatchedMovieFolders() const
+{
+	TArray<FString> Folders;
+	WatchedFolders.GetKeys(Folders);
+	return Folders;
+}
+
+void FAAANKPoseModule::OnMovieFolderChanged(const TArray<FFileChangeData>& Changes, FString MovieFolder)
+{
+#if WITH_EDITOR
+	FWatchedMovieFolder* Watched = WatchedFolders.Find(MovieFolder);
+	if (!Watched)
+	{
+		return;
+	}
+
+	for (const FFileChangeData& Change : Changes)
+	{
+		FString RelativePath = FPaths::ConvertRelativePathToFull(Change.Filename);
+		if (!FPaths::MakePathRelativeTo(RelativePath, *(MovieFolder / TEXT(""))))
+		{
+			continue;
+		}
+
+		// Hashed once the burst settles; a file may be rewritten several times in one save
+		if (AAANKPoseModule::IsWatchedFile(RelativePath))
+		{
+			Watched->WrittenFiles.Add(RelativePath);
+			Watched->LastChangeSeconds = FPlatformTime::Seconds();
+		}
+	}
+#endif
+}
+
+void FAAANKPoseModule::CollectChanges(const FString& MovieFolder, FWatchedMovieFolder& Watched, TSet<FString>& OutActors, bool& bOutNeedsRebuild)
+{
+	for (const FString& RelativePath : Watched.WrittenFiles)
+	{
+		const FMD5Hash Hash = AAANKPoseModule::HashFile(MovieFolder, RelativePath);
+		const FMD5Hash* Previous = Watched.FileHashes.Find(RelativePath);
+		if (Previous && *Previous == Hash)
+		{
+			continue;
+		}
+		Watched.FileHashes.Add(RelativePath, Hash);
+
+		FString ActorName;
+		if (FAAANKPoseLiveApply::IsActorTrackFile(RelativePath, ActorName))
+		{
+			OutActors.Add(ActorName);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("LiveApply: '%s' cannot be re-keyed live"), *RelativePath);
+			bOutNeedsRebuild = true;
+		}
+	}
+	Watched.WrittenFiles.Reset();
+}
+
+bool FAAANKPoseModule::TickLiveApply(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	TArray<FString> Stale;
+	for (TPair<FString, FWatchedMovieFolder>& Pair : WatchedFolders)
+	{
+		FWatchedMovieFolder& Watched = Pair.Value;
+		if (Watched.WrittenFiles.Num() == 0 || Now - Watched.LastChangeSeconds < AAANKPoseModule::DebounceSeconds)
+		{
+			continue;
+		}
+
+		ULevelSequence* Sequence = Watched.Sequence.Get();
+		if (!Sequence)
+		{
+			Stale.Add(Pair.Key);
+			continue;
+		}
+
+		TSet<FString> ChangedActors;
+		bool bNeedsRebuild = false;
+		CollectChanges(Pair.Key, Watched, ChangedActors, bNeedsRebuild);
+
+		if (bNeedsRebuild)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("LiveApply: Scene files in '%s' changed; full rebuild needed to pick them up"), *Pair.Key);
+		}
+		if (ChangedActors.Num() > 0)
+		{
+			FAAANKPoseLiveApply::ApplyActorTracks(Sequence, Pair.Key, ChangedActors.Array());
+		}
+	}
+
+	for (const FString& Folder : Stale)
+	{
+		UE_LOG(LogTemp, Log, TEXT("LiveApply: Sequence for '%s' is gone; no longer watching"), *Folder);
+		UnwatchMovieFolder(Folder);
+	}
+	return LiveApplyTickerHandle.IsValid();
+}
+
 #undef LOCTEXT_NAMESPACE
 	
-IMPLEMENT_MODULE(FAAANKPoseModule, AAANKPose)
\ No newline at end of file
+IMPLEMENT_MODULE(FAAANKPoseModule, AAANKPose)
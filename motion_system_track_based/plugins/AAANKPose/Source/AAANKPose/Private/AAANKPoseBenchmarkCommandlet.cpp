@@ -0,0 +1,291 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseBenchmarkCommandlet.h"
+#include "AAANKPoseBuildTelemetry.h"
+#include "AAANKPoseSceneBuild.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "LevelSequence.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+
+namespace AAANKPoseBenchmark
+{
+	static const double BytesPerMegabyte = 1024.0 * 1024.0;
+
+	struct FMovieResult
+	{
+		FString Movie;
+		bool bBuilt = false;
+		double Seconds = TNumericLimits<double>::Max();
+		double PeakMegabytes = 0.0;
+		int64 KeysWritten = 0;
+		int64 ActorsSpawned = 0;
+		double BudgetSeconds = 0.0;
+		double BudgetPeakMegabytes = 0.0;
+		bool bFailed = false;
+		FString Reason;
+	};
+
+	static TArray<FString> FindMovies(const FString& TracksRoot, const FString& Filter)
+	{
+		TArray<FString> Movies;
+		if (!Filter.IsEmpty())
+		{
+			Filter.ParseIntoArray(Movies, TEXT(","));
+			return Movies;
+		}
+
+		IFileManager::Get().IterateDirectory(*TracksRoot, [&Movies](const TCHAR* Path, bool bIsDirectory)
+		{
+			if (bIsDirectory && FPaths::FileExists(FPaths::Combine(Path, TEXT("meta.json"))))
+			{
+				Movies.Add(FPaths::GetCleanFilename(Path));
+			}
+			return true;
+		});
+		Movies.Sort();
+		return Movies;
+	}
+
+	/** One build of one movie in its own empty world, so runs don't see each other's actors */
+	static void RunOnce(const FString& MovieFolder, FMovieResult& Result)
+	{
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, /*bPerformFullPurge*/ true);
+
+		UWorld* World = UWorld::CreateWorld(EWorldType::Editor, /*bInformEngineOfWorld*/ false);
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Editor);
+		WorldContext.SetCurrentWorld(World);
+
+		const int64 BaselineBytes = FPlatformMemory::GetStats().UsedPhysical;
+		int64 PeakBytes = BaselineBytes;
+
+		FAAANKPoseBuildTelemetry::BeginBuild(Result.Movie + TEXT(".bench"));
+		const double StartSeconds = FPlatformTime::Seconds();
+
+		// Tick with an expired deadline runs exactly one unit, so memory can be sampled between units
+		FAAANKPoseSceneBuild Build(MovieFolder, World);
+		Build.SetUseBuildCache(false);
+		// Streaming waits depend on the machine's IO, not on the build; keep the timings comparable with older runs
+		Build.SetPrewarmTimeout(0.0f);
+		while (!Build.Tick(0.0))
+		{
+			PeakBytes = FMath::Max<int64>(PeakBytes, FPlatformMemory::GetStats().UsedPhysical);
+		}
+
+		const double Seconds = FPlatformTime::Seconds() - StartSeconds;
+		if (!Build.Succeeded())
+		{
+			FAAANKPoseBuildTelemetry::SetOutcome(EAAANKPoseBuildOutcome::Failed);
+		}
+		const FAAANKPoseBuildReport Report = FAAANKPoseBuildTelemetry::EndBuild();
+
+		if (Build.Succeeded())
+		{
+			Result.bBuilt = true;
+			Result.Seconds = FMath::Min(Result.Seconds, Seconds);
+			Result.PeakMegabytes = FMath::Max(Result.PeakMegabytes, (PeakBytes - BaselineBytes) / BytesPerMegabyte);
+			Result.KeysWritten = Report.Counters.FindRef(FAAANKPoseBuildTelemetry::KeysWritten);
+			Result.ActorsSpawned = Report.Counters.FindRef(FAAANKPoseBuildTelemetry::ActorsSpawned);
+		}
+		else
+		{
+			Result.Reason = Build.GetError();
+		}
+
+		// Let the sequence go with the world instead of piling up across iterations
+		if (ULevelSequence* Sequence = Build.GetSequence())
+		{
+			Sequence->ClearFlags(RF_Standalone | RF_Public);
+		}
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(/*bInformEngineOfWorld*/ false);
+	}
+
+	static void ApplyBudget(FMovieResult& Result, const TSharedPtr<FJsonObject>& Budgets, double Margin)
+	{
+		const TSharedPtr<FJsonObject>* Budget = nullptr;
+		if (!Result.bBuilt || !Budgets.IsValid())
+		{
+			return;
+		}
+		// Once budgets exist, a movie without one would otherwise pass the gate unmeasured
+		if (!Budgets->TryGetObjectField(Result.Movie, Budget))
+		{
+			Result.bFailed = true;
+			Result.Reason = TEXT("no budget recorded; re-record with -RecordBudgets");
+			return;
+		}
+
+		(*Budget)->TryGetNumberField(TEXT("seconds"), Result.BudgetSeconds);
+		(*Budget)->TryGetNumberField(TEXT("peak_mb"), Result.BudgetPeakMegabytes);
+
+		TArray<FString> Reasons;
+		if (Result.BudgetSeconds > 0.0 && Result.Seconds > Result.BudgetSeconds * (1.0 + Margin))
+		{
+			Reasons.Add(FString::Printf(TEXT("%.3f s over budget %.3f s"), Result.Seconds, Result.BudgetSeconds));
+		}
+		if (Result.BudgetPeakMegabytes > 0.0 && Result.PeakMegabytes > Result.BudgetPeakMegabytes * (1.0 + Margin))
+		{
+			Reasons.Add(FString::Printf(TEXT("%.1f MB over budget %.1f MB"), Result.PeakMegabytes, Result.BudgetPeakMegabytes));
+		}
+
+		int64 BudgetKeys = 0;
+		if ((*Budget)->TryGetNumberField(TEXT("keys"), BudgetKeys) && BudgetKeys != Result.KeysWritten)
+		{
+			// Different key counts mean the movie itself changed; the budget should be re-recorded
+			UE_LOG(LogTemp, Warning, TEXT("AAANKPoseBenchmark: %s wrote %lld keys, budget was recorded with %lld"),
+				*Result.Movie, Result.KeysWritten, BudgetKeys);
+		}
+
+		Result.bFailed = Reasons.Num() > 0;
+		Result.Reason = FString::Join(Reasons, TEXT("; "));
+	}
+
+	static TSharedRef<FJsonObject> ToJson(const FMovieResult& Result)
+	{
+		TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		Object->SetBoolField(TEXT("built"), Result.bBuilt);
+		Object->SetNumberField(TEXT("seconds"), Result.bBuilt ? Result.Seconds : 0.0);
+		Object->SetNumberField(TEXT("peak_mb"), Result.PeakMegabytes);
+		Object->SetNumberField(TEXT("keys"), static_cast<double>(Result.KeysWritten));
+		Object->SetNumberField(TEXT("actors"), static_cast<double>(Result.ActorsSpawned));
+		Object->SetNumberField(TEXT("budget_seconds"), Result.BudgetSeconds);
+		Object->SetNumberField(TEXT("budget_peak_mb"), Result.BudgetPeakMegabytes);
+		Object->SetBoolField(TEXT("failed"), Result.bFailed);
+		Object->SetStringField(TEXT("reason"), Result.Reason);
+		return Object;
+	}
+
+	static bool SaveJson(const TSharedRef<FJsonObject>& Object, const FString& Path)
+	{
+		FString Text;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Text);
+		return FJsonSerializer::Serialize(Object, Writer) && FFileHelper::SaveStringToFile(Text, *Path);
+	}
+}
+
+UAAANKPoseBenchmarkCommandlet::UAAANKPoseBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UAAANKPoseBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace AAANKPoseBenchmark;
+
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	const FString TracksRoot = ParamValues.FindRef(TEXT("TracksRoot"));
+	if (TracksRoot.IsEmpty() || !FPaths::DirectoryExists(TracksRoot))
+	{
+		UE_LOG(LogTemp, Error, TEXT("AAANKPoseBenchmark: -TracksRoot=<dir> is required (got '%s')"), *TracksRoot);
+		return 2;
+	}
+
+	const FString BudgetsPath = ParamValues.FindRef(TEXT("Budgets"));
+	const double Margin = ParamValues.Contains(TEXT("Margin")) ? FCString::Atod(*ParamValues[TEXT("Margin")]) : 0.2;
+	const int32 Iterations = ParamValues.Contains(TEXT("Iterations")) ? FMath::Max(1, FCString::Atoi(*ParamValues[TEXT("Iterations")])) : 3;
+	const bool bRecordBudgets = Switches.Contains(TEXT("RecordBudgets"));
+	const FString ReportPath = ParamValues.Contains(TEXT("Report"))
+		? ParamValues[TEXT("Report")]
+		: FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AAANKPose"), TEXT("Benchmarks"), FString::Printf(TEXT("report_%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"))));
+
+	TSharedPtr<FJsonObject> Budgets;
+	FString BudgetsText;
+	if (!bRecordBudgets && !BudgetsPath.IsEmpty())
+	{
+		if (!FFileHelper::LoadFileToString(BudgetsText, *BudgetsPath)
+			|| !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BudgetsText), Budgets) || !Budgets.IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("AAANKPoseBenchmark: Could not read budgets from '%s'"), *BudgetsPath);
+			return 2;
+		}
+		if (Budgets->Values.Num() == 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("AAANKPoseBenchmark: '%s' has no budgets; record them with -RecordBudgets"), *BudgetsPath);
+			return 2;
+		}
+	}
+	if (!Budgets.IsValid() && !bRecordBudgets)
+	{
+		UE_LOG(LogTemp, Display, TEXT("AAANKPoseBenchmark: No -Budgets given; reporting only, nothing is gated"));
+	}
+
+	const TArray<FString> Movies = FindMovies(TracksRoot, ParamValues.FindRef(TEXT("Movies")));
+	UE_LOG(LogTemp, Display, TEXT("AAANKPoseBenchmark: %d movie(s), %d iteration(s), margin %.0f%%"), Movies.Num(), Iterations, Margin * 100.0);
+
+	TArray<FMovieResult> Results;
+	int32 NumFailed = 0;
+	for (const FString& Movie : Movies)
+	{
+		FMovieResult& Result = Results.AddDefaulted_GetRef();
+		Result.Movie = Movie;
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			RunOnce(FPaths::Combine(TracksRoot, Movie), Result);
+		}
+
+		if (!Result.bBuilt)
+		{
+			Result.bFailed = true;
+			Result.Reason = FString::Printf(TEXT("build failed: %s"), *Result.Reason);
+		}
+		else if (!bRecordBudgets)
+		{
+			ApplyBudget(Result, Budgets, Margin);
+		}
+		NumFailed += Result.bFailed ? 1 : 0;
+
+		UE_LOG(LogTemp, Display, TEXT("AAANKPoseBenchmark: %-32s %8.3f s %8.1f MB %8lld keys %s%s"),
+			*Movie, Result.bBuilt ? Result.Seconds : 0.0, Result.PeakMegabytes, Result.KeysWritten,
+			Result.bFailed ? TEXT("FAIL ") : TEXT("ok"), *Result.Reason);
+	}
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetNumberField(TEXT("margin"), Margin);
+	Report->SetNumberField(TEXT("iterations"), Iterations);
+	Report->SetNumberField(TEXT("failed"), NumFailed);
+	TSharedRef<FJsonObject> MovieReports = MakeShared<FJsonObject>();
+	for (const FMovieResult& Result : Results)
+	{
+		MovieReports->SetObjectField(Result.Movie, ToJson(Result));
+	}
+	Report->SetObjectField(TEXT("movies"), MovieReports);
+	SaveJson(Report, ReportPath);
+	UE_LOG(LogTemp, Display, TEXT("AAANKPoseBenchmark: Report written to %s"), *ReportPath);
+
+	if (bRecordBudgets && !BudgetsPath.IsEmpty())
+	{
+		TSharedRef<FJsonObject> NewBudgets = MakeShared<FJsonObject>();
+		for (const FMovieResult& Result : Results)
+		{
+			if (Result.bBuilt)
+			{
+				TSharedRef<FJsonObject> Budget = MakeShared<FJsonObject>();
+				Budget->SetNumberField(TEXT("seconds"), Result.Seconds);
+				Budget->SetNumberField(TEXT("peak_mb"), Result.PeakMegabytes);
+				Budget->SetNumberField(TEXT("keys"), static_cast<double>(Result.KeysWritten));
+				NewBudgets->SetObjectField(Result.Movie, Budget);
+			}
+		}
+		SaveJson(NewBudgets, BudgetsPath);
+		UE_LOG(LogTemp, Display, TEXT("AAANKPoseBenchmark: Budgets recorded to %s"), *BudgetsPath);
+	}
+
+	return NumFailed > 0 ? 1 : 0;
+}
@@ -0,0 +1,197 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseBufferBridge.h"
+#include "AAANKPoseMath.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformProcess.h"
+
+
+namespace AAANKPoseBufferBridge
+{
+	static TMap<FString, FPlatformMemory::FSharedMemoryRegion*> Regions;
+	static int32 NextId = 0;
+
+	/** Double xyz buffers are read in place as FVector (three packed doubles) */
+	static_assert(sizeof(FVector) == 3 * sizeof(double), "FVector must be three packed doubles");
+
+	/** The object MapNamedSharedMemoryRegion actually creates for Name */
+	static FString GetKernelObjectName(const FString& Name)
+	{
+#if PLATFORM_WINDOWS
+		// The Windows implementation creates the mapping in the global namespace
+		return FString(TEXT("Global\\")) + Name;
+#else
+		return Name;
+#endif
+	}
+
+	static TConstArrayView<FVector> ViewAsVectors(const FAAANKPoseBufferHandle& Handle, const TCHAR* Caller)
+	{
+		const TArrayView<double> Values = FAAANKPoseBufferRegistry::View<double>(Handle);
+		if (Values.Num() == 0 || Values.Num() % 3 != 0)
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s: '%s' is not a double buffer of x, y, z triples"), Caller, *Handle.Name);
+			return TConstArrayView<FVector>();
+		}
+		return TConstArrayView<FVector>(reinterpret_cast<const FVector*>(Values.GetData()), Values.Num() / 3);
+	}
+}
+
+FAAANKPoseBufferHandle FAAANKPoseBufferRegistry::Create(EAAANKPoseBufferType Type, int32 Num)
+{
+	check(IsInGameThread());
+
+	FAAANKPoseBufferHandle Handle;
+	if (Num <= 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CreateSharedBuffer: Invalid size %d"), Num);
+		return Handle;
+	}
+
+	// Unique per editor process so a second editor can't map our buffers by accident
+	const FString Name = FString::Printf(TEXT("AAANKPose_%u_%d"), FPlatformProcess::GetCurrentProcessId(), ++AAANKPoseBufferBridge::NextId);
+	const SIZE_T Bytes = static_cast<SIZE_T>(Num) * GetElementSize(Type);
+	const uint32 Access = static_cast<uint32>(FPlatformMemory::ESharedMemoryAccess::Read) | static_cast<uint32>(FPlatformMemory::ESharedMemoryAccess::Write);
+
+	FPlatformMemory::FSharedMemoryRegion* Region = FPlatformMemory::MapNamedSharedMemoryRegion(Name, /*bCreate*/ true, Access, Bytes);
+	if (!Region)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CreateSharedBuffer: Could not map %llu bytes as '%s'"), (uint64)Bytes, *Name);
+		return Handle;
+	}
+	FMemory::Memzero(Region->GetAddress(), Bytes);
+	AAANKPoseBufferBridge::Regions.Add(Name, Region);
+
+	Handle.Name = Name;
+	Handle.KernelName = AAANKPoseBufferBridge::GetKernelObjectName(Name);
+	Handle.Type = Type;
+	Handle.Num = Num;
+	return Handle;
+}
+
+bool FAAANKPoseBufferRegistry::Release(const FAAANKPoseBufferHandle& Handle)
+{
+	check(IsInGameThread());
+
+	FPlatformMemory::FSharedMemoryRegion* Region = nullptr;
+	if (!AAANKPoseBufferBridge::Regions.RemoveAndCopyValue(Handle.Name, Region))
+	{
+		return false;
+	}
+	return FPlatformMemory::UnmapNamedSharedMemoryRegion(Region);
+}
+
+int32 FAAANKPoseBufferRegistry::ReleaseAll()
+{
+	const int32 Released = AAANKPoseBufferBridge::Regions.Num();
+	for (const TPair<FString, FPlatformMemory::FSharedMemoryRegion*>& Pair : AAANKPoseBufferBridge::Regions)
+	{
+		FPlatformMemory::UnmapNamedSharedMemoryRegion(Pair.Value);
+	}
+	AAANKPoseBufferBridge::Regions.Reset();
+	return Released;
+}
+
+int32 FAAANKPoseBufferRegistry::GetElementSize(EAAANKPoseBufferType Type)
+{
+	return Type == EAAANKPoseBufferType::Double ? sizeof(double) : sizeof(float);
+}
+
+void* FAAANKPoseBufferRegistry::Find(const FAAANKPoseBufferHandle& Handle)
+{
+	FPlatformMemory::FSharedMemoryRegion* const* Region = AAANKPoseBufferBridge::Regions.Find(Handle.Name);
+	if (!Region || Handle.Num <= 0 || (*Region)->GetSize() < static_cast<SIZE_T>(Handle.Num) * GetElementSize(Handle.Type))
+	{
+		return nullptr;
+	}
+	return (*Region)->GetAddress();
+}
+
+FAAANKPoseBufferHandle UAAANKPoseBufferLibrary::CreateSharedBuffer(EAAANKPoseBufferType Type, int32 Num)
+{
+	return FAAANKPoseBufferRegistry::Create(Type, Num);
+}
+
+bool UAAANKPoseBufferLibrary::ReleaseSharedBuffer(const FAAANKPoseBufferHandle& Handle)
+{
+	return FAAANKPoseBufferRegistry::Release(Handle);
+}
+
+int32 UAAANKPoseBufferLibrary::GetBufferElementSize(EAAANKPoseBufferType Type)
+{
+	return FAAANKPoseBufferRegistry::GetElementSize(Type);
+}
+
+int32 UAAANKPoseBufferLibrary::SampleSplinePathToBuffer(const FAAANKPoseBufferHandle& Points, float SampleInterval, bool bClosed, const FAAANKPoseBufferHandle& OutSamples)
+{
+	const TConstArrayView<FVector> ControlPoints = AAANKPoseBufferBridge::ViewAsVectors(Points, TEXT("SampleSplinePathToBuffer"));
+	const TArrayView<float> Out = FAAANKPoseBufferRegistry::View<float>(OutSamples);
+	if (ControlPoints.Num() == 0 || Out.Num() == 0)
+	{
+		return 0;
+	}
+
+	TArray<AAANKPoseMath::FSplineSample> Samples;
+	AAANKPoseMath::SampleSplinePath(ControlPoints, SampleInterval, bClosed, Samples);
+
+	const int32 Stride = 8;
+	const int32 Written = FMath::Min(Samples.Num(), Out.Num() / Stride);
+	for (int32 Index = 0; Index < Written; ++Index)
+	{
+		const AAANKPoseMath::FSplineSample& Sample = Samples[Index];
+		float* Row = &Out[Index * Stride];
+		Row[0] = Sample.Position.X;
+		Row[1] = Sample.Position.Y;
+		Row[2] = Sample.Position.Z;
+		Row[3] = Sample.Tangent.X;
+		Row[4] = Sample.Tangent.Y;
+		Row[5] = Sample.Tangent.Z;
+		Row[6] = Sample.Distance;
+		Row[7] = Sample.Slope;
+	}
+	if (Written < Samples.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SampleSplinePathToBuffer: %d samples produced, '%s' holds %d"), Samples.Num(), *OutSamples.Name, Written);
+	}
+	return Samples.Num();
+}
+
+int32 UAAANKPoseBufferLibrary::SolveCameraTrackToBuffer(const FAAANKPoseBufferHandle& CameraLocations, const FAAANKPoseBufferHandle& SubjectLocations,
+	float SubjectHeight, float Coverage, const FAAANKPoseBufferHandle& OutCamera)
+{
+	const TConstArrayView<FVector> Cameras = AAANKPoseBufferBridge::ViewAsVectors(CameraLocations, TEXT("SolveCameraTrackToBuffer"));
+	const TConstArrayView<FVector> Subjects = AAANKPoseBufferBridge::ViewAsVectors(SubjectLocations, TEXT("SolveCameraTrackToBuffer"));
+	const TArrayView<float> Out = FAAANKPoseBufferRegistry::View<float>(OutCamera);
+	if (Cameras.Num() == 0 || Cameras.Num() != Subjects.Num() || Out.Num() < Cameras.Num() * 4)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SolveCameraTrackToBuffer: %d camera frames, %d subject frames, room for %d"), Cameras.Num(), Subjects.Num(), Out.Num() / 4);
+		return -1;
+	}
+
+	for (int32 Index = 0; Index < Cameras.Num(); ++Index)
+	{
+		const FRotator Rotation = AAANKPoseMath::CalculateLookAtRotation(Cameras[Index], Subjects[Index]);
+		float* Row = &Out[Index * 4];
+		Row[0] = Rotation.Pitch;
+		Row[1] = Rotation.Yaw;
+		Row[2] = Rotation.Roll;
+		Row[3] = AAANKPoseMath::CalculateFocalLength(Cameras[Index], Subjects[Index], SubjectHeight, Coverage);
+	}
+	return Cameras.Num();
+}
+
+int32 UAAANKPoseBufferLibrary::ReduceCurveToBuffer(const FAAANKPoseBufferHandle& Points, float Tolerance, const FAAANKPoseBufferHandle& OutKeptIndices)
+{
+	const TConstArrayView<FVector> CurvePoints = AAANKPoseBufferBridge::ViewAsVectors(Points, TEXT("ReduceCurveToBuffer"));
+	const TArrayView<int32> Out = FAAANKPoseBufferRegistry::View<int32>(OutKeptIndices);
+	if (CurvePoints.Num() == 0 || Out.Num() == 0)
+	{
+		return 0;
+	}
+
+	TArray<int32> Kept;
+	AAANKPoseMath::ReduceCurve(CurvePoints, Tolerance, Kept);
+	const int32 Written = FMath::Min(Kept.Num(), Out.Num());
+	FMemory::Memcpy(Out.GetData(), Kept.GetData(), Written * sizeof(int32));
+	return Kept.Num();
+}
@@ -0,0 +1,268 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseBuildCache.h"
+#include "AAANKPoseSceneBuild.h"
+#include "AAANKPoseSpawnLibrary.h"
+#include "AAANKPoseTrackFolder.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "LevelSequence.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "MovieScene.h"
+#include "Sections/MovieSceneSubSection.h"
+#include "Serialization/Archive.h"
+#include "Tracks/MovieSceneCinematicShotTrack.h"
+#include "UniversalObjectLocatorResolveParams.h"
+
+#if WITH_EDITOR
+#include "AssetRegistry/AssetRegistryModule.h"
+#endif
+
+
+namespace AAANKPoseBuildCache
+{
+	static const int64 ReadBlockSize = 1024 * 1024;
+
+	/** Size and contents, read in blocks so large chunked takes don't need one big buffer; returns bytes hashed */
+	static int64 HashFile(FSHA1& Hash, const FString& Path, TArray<uint8>& Buffer)
+	{
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path));
+		if (!Reader)
+		{
+			return 0;
+		}
+
+		const int64 Size = Reader->TotalSize();
+		Hash.Update(reinterpret_cast<const uint8*>(&Size), sizeof(Size));
+		for (int64 Offset = 0; Offset < Size; Offset += ReadBlockSize)
+		{
+			const int64 BlockSize = FMath::Min(ReadBlockSize, Size - Offset);
+			Buffer.SetNumUninitialized(BlockSize, EAllowShrinking::No);
+			Reader->Serialize(Buffer.GetData(), BlockSize);
+			Hash.Update(Buffer.GetData(), BlockSize);
+		}
+		return Size;
+	}
+
+	/** Resolve each root binding of Sequence against World; false if any doesn't resolve to an actor there */
+	static bool ResolveRootBindings(const UMovieSceneSequence& Sequence, UWorld& World, TArray<AActor*>& OutActors)
+	{
+		bool bResolved = true;
+		const UMovieScene& MovieScene = *Sequence.GetMovieScene();
+		for (int32 Index = 0; Index < MovieScene.GetPossessableCount(); ++Index)
+		{
+			const FMovieScenePossessable& Possessable = MovieScene.GetPossessable(Index);
+			if (Possessable.GetParent().IsValid())
+			{
+				continue;
+			}
+
+			TArray<UObject*, TInlineAllocator<1>> Objects;
+			Sequence.LocateBoundObjects(Possessable.GetGuid(), UE::UniversalObjectLocator::FResolveParams(&World), nullptr, Objects);
+			AActor* Actor = Objects.Num() > 0 ? Cast<AActor>(Objects[0]) : nullptr;
+			if (!Actor || Actor->GetWorld() != &World)
+			{
+				UE_LOG(LogTemp, Log, TEXT("ResolveRootBindings: '%s' in %s does not resolve in %s"), *Possessable.GetName(), *Sequence.GetName(), *World.GetName());
+				bResolved = false;
+				continue;
+			}
+			OutActors.AddUnique(Actor);
+		}
+		return bResolved;
+	}
+}
+
+FString FAAANKPoseBuildCache::GetPluginVersion()
+{
+	const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("AAANKPose"));
+	return Plugin.IsValid() ? Plugin->GetDescriptor().VersionName : FString();
+}
+
+FString FAAANKPoseBuildCache::ComputeFingerprint(const FString& MovieFolder, const FString& BuildOptions)
+{
+	if (!FPaths::DirectoryExists(MovieFolder))
+	{
+		return FString();
+	}
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	TArray<FString> Files;
+	IFileManager::Get().FindFilesRecursive(Files, *MovieFolder, TEXT("*"), /*Files*/ true, /*Directories*/ false);
+
+	// Relative, sorted paths so the fingerprint doesn't depend on where dist/ lives or on directory order
+	const FString Root = FPaths::ConvertRelativePathToFull(MovieFolder) / TEXT("");
+	TArray<TPair<FString, FString>> RelativeFiles;
+	RelativeFiles.Reserve(Files.Num());
+	for (const FString& File : Files)
+	{
+		const FString FullPath = FPaths::ConvertRelativePathToFull(File);
+		FString Relative = FullPath.StartsWith(Root) ? FullPath.RightChop(Root.Len()) : FPaths::GetCleanFilename(FullPath);
+		Relative.ReplaceCharInline(TEXT('\\'), TEXT('/'));
+		// Editor and OS droppings (.DS_Store, swap files) are not track data
+		if (!FPaths::GetCleanFilename(Relative).StartsWith(TEXT(".")))
+		{
+			RelativeFiles.Emplace(MoveTemp(Relative), FullPath);
+		}
+	}
+	RelativeFiles.Sort([](const TPair<FString, FString>& A, const TPair<FString, FString>& B)
+	{
+		return A.Key < B.Key;
+	});
+
+	FSHA1 Hash;
+	const FString Header = GetPluginVersion() + TEXT("|") + BuildOptions;
+	Hash.UpdateWithString(*Header, Header.Len());
+
+	int64 Bytes = 0;
+	TArray<uint8> Buffer;
+	for (const TPair<FString, FString>& File : RelativeFiles)
+	{
+		// Terminator included so a path can't run into the next file's bytes
+		Hash.UpdateWithString(*File.Key, File.Key.Len() + 1);
+		Bytes += AAANKPoseBuildCache::HashFile(Hash, File.Value, Buffer);
+	}
+
+	Hash.Final();
+	uint8 Digest[FSHA1::DigestSize];
+	Hash.GetHash(Digest);
+
+	UE_LOG(LogTemp, Verbose, TEXT("ComputeFingerprint: %d files, %lld bytes in %.1f ms"), RelativeFiles.Num(), Bytes, (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+	return BytesToHex(Digest, FSHA1::DigestSize);
+}
+
+ULevelSequence* FAAANKPoseBuildCache::FindLatestSequence(const FString& SceneName)
+{
+#if WITH_EDITOR
+	const FString Prefix = FAAANKPoseSceneBuild::GetSequenceBaseName(SceneName) + TEXT("_");
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByPath(FName(FAAANKPoseSceneBuild::SequenceFolder), Assets, /*bRecursive*/ false);
+
+	const FAssetData* Latest = nullptr;
+	int32 LatestNumber = -1;
+	for (const FAssetData& Asset : Assets)
+	{
+		const FString AssetName = Asset.AssetName.ToString();
+		const FString Suffix = AssetName.RightChop(Prefix.Len());
+		if (!AssetName.StartsWith(Prefix) || Suffix.IsEmpty() || !Suffix.IsNumeric() || Asset.AssetClassPath != ULevelSequence::StaticClass()->GetClassPathName())
+		{
+			continue;
+		}
+		const int32 Number = FCString::Atoi(*Suffix);
+		if (Number > LatestNumber)
+		{
+			LatestNumber = Number;
+			Latest = &Asset;
+		}
+	}
+	return Latest ? Cast<ULevelSequence>(Latest->GetAsset()) : nullptr;
+#else
+	return nullptr;
+#endif
+}
+
+FString FAAANKPoseBuildCache::GetSequenceFingerprint(const ULevelSequence* Sequence)
+{
+	const UAAANKPoseBuildCacheMetaData* MetaData = Sequence ? Sequence->FindMetaData<UAAANKPoseBuildCacheMetaData>() : nullptr;
+	return MetaData ? MetaData->Fingerprint : FString();
+}
+
+bool FAAANKPoseBuildCache::ResolveRootBindings(const ULevelSequence& Sequence, UWorld& World, TArray<AActor*>& OutActors)
+{
+	const UMovieScene* MovieScene = Sequence.GetMovieScene();
+	if (!MovieScene)
+	{
+		return false;
+	}
+
+	// Keeps going past a failure so callers that only want the actors still get every one that resolves
+	bool bResolved = AAANKPoseBuildCache::ResolveRootBindings(Sequence, World, OutActors);
+
+	// Partitioned builds bind actors in their shot subsequences only
+	if (const UMovieSceneCinematicShotTrack* ShotTrack = MovieScene->FindTrack<UMovieSceneCinematicShotTrack>())
+	{
+		for (const UMovieSceneSection* Section : ShotTrack->GetAllSections())
+		{
+			const UMovieSceneSubSection* SubSection = Cast<UMovieSceneSubSection>(Section);
+			const UMovieSceneSequence* ShotSequence = SubSection ? SubSection->GetSequence() : nullptr;
+			if (!ShotSequence || !ShotSequence->GetMovieScene())
+			{
+				bResolved = false;
+				continue;
+			}
+			bResolved &= AAANKPoseBuildCache::ResolveRootBindings(*ShotSequence, World, OutActors);
+		}
+	}
+	return bResolved && OutActors.Num() > 0;
+}
+
+ULevelSequence* FAAANKPoseBuildCache::FindReusableSequence(UWorld* World, const FString& MovieFolder, const FString& Fingerprint)
+{
+	FAAANKPoseMovieMeta Meta;
+	if (!World || Fingerprint.IsEmpty() || !FAAANKPoseTrackFolder::LoadMeta(MovieFolder, Meta))
+	{
+		return nullptr;
+	}
+
+	ULevelSequence* Sequence = FindLatestSequence(Meta.Name);
+	if (!Sequence)
+	{
+		return nullptr;
+	}
+	if (GetSequenceFingerprint(Sequence) != Fingerprint)
+	{
+		UE_LOG(LogTemp, Log, TEXT("FindReusableSequence: %s was built from different tracks or plugin version; rebuilding"), *Sequence->GetName());
+		return nullptr;
+	}
+	TArray<AActor*> Actors;
+	if (!ResolveRootBindings(*Sequence, *World, Actors))
+	{
+		UE_LOG(LogTemp, Log, TEXT("FindReusableSequence: %s is up to date but its bindings no longer resolve in the level; rebuilding"), *Sequence->GetName());
+		return nullptr;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("FindReusableSequence: %s is up to date with %s"), *Sequence->GetName(), *MovieFolder);
+	return Sequence;
+}
+
+void FAAANKPoseBuildCache::StampSequence(ULevelSequence* Sequence, const FString& MovieFolder, const FString& Fingerprint)
+{
+	if (!Sequence || Fingerprint.IsEmpty())
+	{
+		return;
+	}
+
+	UAAANKPoseBuildCacheMetaData* MetaData = Sequence->FindOrAddMetaData<UAAANKPoseBuildCacheMetaData>();
+	MetaData->Fingerprint = Fingerprint;
+	MetaData->MovieFolder = MovieFolder;
+	MetaData->PluginVersion = GetPluginVersion();
+	MetaData->BuiltAt = FDateTime::UtcNow();
+	Sequence->MarkPackageDirty();
+}
+
+FString UAAANKPoseBuildCacheLibrary::ComputeTrackFolderFingerprint(const FString& MovieFolder, const FString& BuildOptions)
+{
+	return FAAANKPoseBuildCache::ComputeFingerprint(MovieFolder, BuildOptions);
+}
+
+ULevelSequence* UAAANKPoseBuildCacheLibrary::FindReusableSequence(UObject* WorldContextObject, const FString& MovieFolder, const FString& Fingerprint)
+{
+	return FAAANKPoseBuildCache::FindReusableSequence(UAAANKPoseSpawnLibrary::ResolveWorld(WorldContextObject), MovieFolder, Fingerprint);
+}
+
+void UAAANKPoseBuildCacheLibrary::StampSequence(ULevelSequence* Sequence, const FString& MovieFolder, const FString& Fingerprint)
+{
+	FAAANKPoseBuildCache::StampSequence(Sequence, MovieFolder, Fingerprint);
+}
+
+FString UAAANKPoseBuildCacheLibrary::GetSequenceFingerprint(ULevelSequence* Sequence)
+{
+	return FAAANKPoseBuildCache::GetSequenceFingerprint(Sequence);
+}
+
+FString UAAANKPoseBuildCacheLibrary::GetPluginVersion()
+{
+	return FAAANKPoseBuildCache::GetPluginVersion();
+}
@@ -0,0 +1,351 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseBuildTelemetry.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+
+const FString FAAANKPoseBuildTelemetry::ActorsSpawned(TEXT("ActorsSpawned"));
+const FString FAAANKPoseBuildTelemetry::KeysWritten(TEXT("KeysWritten"));
+const FString FAAANKPoseBuildTelemetry::AssetsLoaded(TEXT("AssetsLoaded"));
+
+namespace AAANKPoseBuildTelemetry
+{
+	/** Builds kept in each history file */
+	static const int32 MaxHistoryEntries = 100;
+	/** Builds the rolling median is taken over */
+	static const int32 MedianWindow = 10;
+	/** Phases shorter than this are too noisy to flag */
+	static const double MinRegressionSeconds = 0.05;
+
+	struct FActiveBuild
+	{
+		FString Movie;
+		EAAANKPoseBuildOutcome Outcome = EAAANKPoseBuildOutcome::Completed;
+		double StartSeconds = 0.0;
+		TArray<FString> PhaseOrder;
+		TMap<FString, double> PhaseSeconds;
+		TMap<FString, int64> Counters;
+	};
+
+	static int32 Depth = 0;
+	static FActiveBuild Active;
+
+	/** Phase opened by BeginPhase from Python */
+	static FString OpenPhase;
+	static double OpenPhaseStart = 0.0;
+
+	static void CloseOpenPhase()
+	{
+		if (!OpenPhase.IsEmpty())
+		{
+			FAAANKPoseBuildTelemetry::AddPhaseTime(OpenPhase, FPlatformTime::Seconds() - OpenPhaseStart);
+			OpenPhase.Reset();
+		}
+	}
+
+	static double Median(TArray<double>& Values)
+	{
+		if (Values.Num() == 0)
+		{
+			return 0.0;
+		}
+		Values.Sort();
+		const int32 Mid = Values.Num() / 2;
+		return Values.Num() % 2 ? Values[Mid] : 0.5 * (Values[Mid - 1] + Values[Mid]);
+	}
+
+	static TArray<FString> ReadHistoryLines(const FString& Path)
+	{
+		TArray<FString> Lines;
+		FFileHelper::LoadFileToStringArray(Lines, *Path);
+		Lines.RemoveAll([](const FString& Line) { return Line.TrimStartAndEnd().IsEmpty(); });
+		return Lines;
+	}
+
+	static const TCHAR* GetOutcomeName(EAAANKPoseBuildOutcome Outcome)
+	{
+		switch (Outcome)
+		{
+		case EAAANKPoseBuildOutcome::Skipped:	return TEXT("skipped");
+		case EAAANKPoseBuildOutcome::Failed:	return TEXT("failed");
+		default:								return TEXT("completed");
+		}
+	}
+
+	/** Median of each phase (and "total") over the most recent completed entries; older entries have no outcome and count as completed */
+	static TMap<FString, double> ComputeMedians(const TArray<FString>& Lines, int32& OutSamples)
+	{
+		TMap<FString, TArray<double>> Samples;
+		OutSamples = 0;
+
+		for (int32 Index = Lines.Num() - 1; Index >= 0 && OutSamples < MedianWindow; --Index)
+		{
+			TSharedPtr<FJsonObject> Entry;
+			if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Lines[Index]), Entry) || !Entry.IsValid())
+			{
+				continue;
+			}
+			FString Outcome;
+			if (Entry->TryGetStringField(TEXT("outcome"), Outcome) && Outcome != GetOutcomeName(EAAANKPoseBuildOutcome::Completed))
+			{
+				continue;
+			}
+			++OutSamples;
+
+			double Total = 0.0;
+			if (Entry->TryGetNumberField(TEXT("total"), Total))
+			{
+				Samples.FindOrAdd(TEXT("total")).Add(Total);
+			}
+			const TSharedPtr<FJsonObject>* Phases = nullptr;
+			if (Entry->TryGetObjectField(TEXT("phases"), Phases))
+			{
+				for (const TPair<FString, TSharedPtr<FJsonValue>>& Phase : (*Phases)->Values)
+				{
+					Samples.FindOrAdd(Phase.Key).Add(Phase.Value->AsNumber());
+				}
+			}
+		}
+
+		TMap<FString, double> Medians;
+		for (TPair<FString, TArray<double>>& Pair : Samples)
+		{
+			Medians.Add(Pair.Key, Median(Pair.Value));
+		}
+		return Medians;
+	}
+
+	static void Compare(FAAANKPosePhaseTiming& Timing, const TMap<FString, double>& Medians, float Threshold)
+	{
+		if (const double* MedianSeconds = Medians.Find(Timing.Name))
+		{
+			Timing.MedianSeconds = *MedianSeconds;
+			Timing.bRegressed = Timing.Seconds >= MinRegressionSeconds && Timing.Seconds > Timing.MedianSeconds * (1.0 + Threshold);
+		}
+	}
+
+	static FString SerializeEntry(const FAAANKPoseBuildReport& Report)
+	{
+		FString Line;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("time"), FDateTime::UtcNow().ToIso8601());
+		Writer->WriteValue(TEXT("outcome"), GetOutcomeName(Report.Outcome));
+		Writer->WriteValue(TEXT("total"), Report.Total.Seconds);
+		Writer->WriteObjectStart(TEXT("phases"));
+		for (const FAAANKPosePhaseTiming& Phase : Report.Phases)
+		{
+			Writer->WriteValue(Phase.Name, Phase.Seconds);
+		}
+		Writer->WriteObjectEnd();
+		Writer->WriteObjectStart(TEXT("counters"));
+		for (const TPair<FString, int64>& Counter : Report.Counters)
+		{
+			Writer->WriteValue(Counter.Key, Counter.Value);
+		}
+		Writer->WriteObjectEnd();
+		Writer->WriteObjectEnd();
+		Writer->Close();
+		return Line;
+	}
+}
+
+void FAAANKPoseBuildTelemetry::BeginBuild(const FString& MovieName)
+{
+	using namespace AAANKPoseBuildTelemetry;
+	check(IsInGameThread());
+
+	if (Depth++ == 0)
+	{
+		Active = FActiveBuild();
+		Active.Movie = MovieName;
+		Active.StartSeconds = FPlatformTime::Seconds();
+	}
+}
+
+FAAANKPoseBuildReport FAAANKPoseBuildTelemetry::EndBuild(float RegressionThreshold)
+{
+	using namespace AAANKPoseBuildTelemetry;
+	check(IsInGameThread());
+
+	FAAANKPoseBuildReport Report;
+	if (Depth == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("EndBuildTelemetry called without a matching BeginBuildTelemetry"));
+		return Report;
+	}
+	if (--Depth > 0)
+	{
+		return Report;
+	}
+
+	CloseOpenPhase();
+
+	Report.Movie = Active.Movie;
+	Report.Outcome = Active.Outcome;
+	Report.Total.Name = TEXT("total");
+	Report.Total.Seconds = FPlatformTime::Seconds() - Active.StartSeconds;
+	for (const FString& PhaseName : Active.PhaseOrder)
+	{
+		FAAANKPosePhaseTiming& Phase = Report.Phases.AddDefaulted_GetRef();
+		Phase.Name = PhaseName;
+		Phase.Seconds = Active.PhaseSeconds[PhaseName];
+	}
+	Report.Counters = Active.Counters;
+
+	const FString HistoryPath = GetHistoryPath(Active.Movie);
+	TArray<FString> Lines = ReadHistoryLines(HistoryPath);
+
+	// A skipped or failed build's timings say nothing about build speed, so it is only recorded
+	const TMap<FString, double> Medians = ComputeMedians(Lines, Report.HistorySamples);
+	if (Report.Outcome == EAAANKPoseBuildOutcome::Completed)
+	{
+		Compare(Report.Total, Medians, RegressionThreshold);
+		Report.bAnyRegressed = Report.Total.bRegressed;
+		for (FAAANKPosePhaseTiming& Phase : Report.Phases)
+		{
+			Compare(Phase, Medians, RegressionThreshold);
+			Report.bAnyRegressed |= Phase.bRegressed;
+		}
+	}
+
+	// Append, trimming the oldest entries so the file stays small
+	Lines.Add(SerializeEntry(Report));
+	if (Lines.Num() > MaxHistoryEntries)
+	{
+		Lines.RemoveAt(0, Lines.Num() - MaxHistoryEntries);
+	}
+	FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*FPaths::GetPath(HistoryPath));
+	FFileHelper::SaveStringArrayToFile(Lines, *HistoryPath);
+
+	UE_LOG(LogTemp, Log, TEXT("BuildTelemetry: '%s' %s in %.3f s (median %.3f s over %d builds)"),
+		*Report.Movie, GetOutcomeName(Report.Outcome), Report.Total.Seconds, Report.Total.MedianSeconds, Report.HistorySamples);
+	for (const FAAANKPosePhaseTiming& Phase : Report.Phases)
+	{
+		if (Phase.bRegressed)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("BuildTelemetry: Phase '%s' regressed: %.3f s vs median %.3f s"),
+				*Phase.Name, Phase.Seconds, Phase.MedianSeconds);
+		}
+	}
+
+	Active = FActiveBuild();
+	return Report;
+}
+
+bool FAAANKPoseBuildTelemetry::IsActive()
+{
+	return AAANKPoseBuildTelemetry::Depth > 0;
+}
+
+void FAAANKPoseBuildTelemetry::SetOutcome(EAAANKPoseBuildOutcome Outcome)
+{
+	using namespace AAANKPoseBuildTelemetry;
+	if (Depth == 0)
+	{
+		return;
+	}
+	check(IsInGameThread());
+
+	Active.Outcome = FMath::Max(Active.Outcome, Outcome);
+}
+
+void FAAANKPoseBuildTelemetry::AddPhaseTime(const FString& PhaseName, double Seconds)
+{
+	using namespace AAANKPoseBuildTelemetry;
+	if (Depth == 0)
+	{
+		return;
+	}
+	check(IsInGameThread());
+
+	if (double* Existing = Active.PhaseSeconds.Find(PhaseName))
+	{
+		*Existing += Seconds;
+	}
+	else
+	{
+		Active.PhaseOrder.Add(PhaseName);
+		Active.PhaseSeconds.Add(PhaseName, Seconds);
+	}
+}
+
+void FAAANKPoseBuildTelemetry::AddCounter(const FString& CounterName, int64 Delta)
+{
+	using namespace AAANKPoseBuildTelemetry;
+	if (Depth == 0)
+	{
+		return;
+	}
+	check(IsInGameThread());
+
+	Active.Counters.FindOrAdd(CounterName) += Delta;
+}
+
+FString FAAANKPoseBuildTelemetry::GetHistoryPath(const FString& MovieName)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AAANKPose"), TEXT("BuildHistory"), FPaths::MakeValidFileName(MovieName) + TEXT(".jsonl"));
+}
+
+FAAANKPoseScopedPhase::FAAANKPoseScopedPhase(const FString& InPhaseName)
+	: PhaseName(InPhaseName)
+	, StartSeconds(FPlatformTime::Seconds())
+{
+}
+
+FAAANKPoseScopedPhase::~FAAANKPoseScopedPhase()
+{
+	FAAANKPoseBuildTelemetry::AddPhaseTime(PhaseName, FPlatformTime::Seconds() - StartSeconds);
+}
+
+void UAAANKPoseTelemetryLibrary::BeginBuildTelemetry(const FString& MovieName)
+{
+	FAAANKPoseBuildTelemetry::BeginBuild(MovieName);
+}
+
+FAAANKPoseBuildReport UAAANKPoseTelemetryLibrary::EndBuildTelemetry(float RegressionThreshold)
+{
+	return FAAANKPoseBuildTelemetry::EndBuild(RegressionThreshold);
+}
+
+void UAAANKPoseTelemetryLibrary::BeginPhase(const FString& PhaseName)
+{
+	AAANKPoseBuildTelemetry::CloseOpenPhase();
+	if (FAAANKPoseBuildTelemetry::IsActive())
+	{
+		AAANKPoseBuildTelemetry::OpenPhase = PhaseName;
+		AAANKPoseBuildTelemetry::OpenPhaseStart = FPlatformTime::Seconds();
+	}
+}
+
+void UAAANKPoseTelemetryLibrary::EndPhase()
+{
+	AAANKPoseBuildTelemetry::CloseOpenPhase();
+}
+
+void UAAANKPoseTelemetryLibrary::SetBuildOutcome(EAAANKPoseBuildOutcome Outcome)
+{
+	FAAANKPoseBuildTelemetry::SetOutcome(Outcome);
+}
+
+void UAAANKPoseTelemetryLibrary::AddBuildCounter(const FString& CounterName, int64 Delta)
+{
+	FAAANKPoseBuildTelemetry::AddCounter(CounterName, Delta);
+}
+
+TArray<FString> UAAANKPoseTelemetryLibrary::GetBuildHistory(const FString& MovieName, int32 MaxEntries)
+{
+	TArray<FString> Lines = AAANKPoseBuildTelemetry::ReadHistoryLines(FAAANKPoseBuildTelemetry::GetHistoryPath(MovieName));
+	if (MaxEntries > 0 && Lines.Num() > MaxEntries)
+	{
+		Lines.RemoveAt(0, Lines.Num() - MaxEntries);
+	}
+	return Lines;
+}
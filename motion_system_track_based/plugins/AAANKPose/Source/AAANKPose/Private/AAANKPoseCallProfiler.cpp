@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseCallProfiler.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+
+namespace AAANKPoseCallProfiler
+{
+	/** Keyed by "Phase|Name|CallSite" */
+	static TMap<FString, FAAANKPoseCallStat> Stats;
+
+	static FString MakeKey(const FString& Phase, const FString& Name, const FString& CallSite)
+	{
+		return Phase + TEXT("|") + Name + TEXT("|") + CallSite;
+	}
+
+	static void SortByTotal(TArray<FAAANKPoseCallStat>& Entries)
+	{
+		Entries.Sort([](const FAAANKPoseCallStat& A, const FAAANKPoseCallStat& B)
+		{
+			return A.TotalSeconds > B.TotalSeconds;
+		});
+	}
+
+	/** CSV fields are names and paths; quote them so commas in paths survive */
+	static FString Quote(const FString& Field)
+	{
+		return TEXT("\"") + Field.Replace(TEXT("\""), TEXT("\"\"")) + TEXT("\"");
+	}
+}
+
+void UAAANKPoseCallProfilerLibrary::ResetCallProfile()
+{
+	AAANKPoseCallProfiler::Stats.Reset();
+}
+
+int32 UAAANKPoseCallProfilerLibrary::SubmitCallSamples(const FString& Phase, const TArray<FString>& Names, const TArray<FString>& CallSites, const TArray<int64>& Calls, const TArray<double>& Seconds)
+{
+	const int32 Num = Names.Num();
+	if (CallSites.Num() != Num || Calls.Num() != Num || Seconds.Num() != Num)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SubmitCallSamples: Array lengths differ (%d names, %d sites, %d calls, %d seconds)"),
+			Num, CallSites.Num(), Calls.Num(), Seconds.Num());
+		return 0;
+	}
+
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		FAAANKPoseCallStat& Stat = AAANKPoseCallProfiler::Stats.FindOrAdd(AAANKPoseCallProfiler::MakeKey(Phase, Names[Index], CallSites[Index]));
+		if (Stat.Calls == 0)
+		{
+			Stat.Name = Names[Index];
+			Stat.Phase = Phase;
+			Stat.CallSite = CallSites[Index];
+		}
+		Stat.Calls += Calls[Index];
+		Stat.TotalSeconds += Seconds[Index];
+	}
+	return Num;
+}
+
+TArray<FAAANKPoseCallStat> UAAANKPoseCallProfilerLibrary::GetRankedCallReport(bool bByCallSite, int32 MaxEntries)
+{
+	TArray<FAAANKPoseCallStat> Entries;
+	if (bByCallSite)
+	{
+		AAANKPoseCallProfiler::Stats.GenerateValueArray(Entries);
+	}
+	else
+	{
+		TMap<FString, FAAANKPoseCallStat> RolledUp;
+		for (const TPair<FString, FAAANKPoseCallStat>& Pair : AAANKPoseCallProfiler::Stats)
+		{
+			FAAANKPoseCallStat& Stat = RolledUp.FindOrAdd(AAANKPoseCallProfiler::MakeKey(Pair.Value.Phase, Pair.Value.Name, FString()));
+			Stat.Name = Pair.Value.Name;
+			Stat.Phase = Pair.Value.Phase;
+			Stat.Calls += Pair.Value.Calls;
+			Stat.TotalSeconds += Pair.Value.TotalSeconds;
+		}
+		RolledUp.GenerateValueArray(Entries);
+	}
+
+	AAANKPoseCallProfiler::SortByTotal(Entries);
+	if (MaxEntries > 0 && Entries.Num() > MaxEntries)
+	{
+		Entries.SetNum(MaxEntries);
+	}
+	return Entries;
+}
+
+FString UAAANKPoseCallProfilerLibrary::WriteCallReport(const FString& MovieName)
+{
+	using namespace AAANKPoseCallProfiler;
+
+	TArray<FAAANKPoseCallStat> Entries;
+	Stats.GenerateValueArray(Entries);
+	SortByTotal(Entries);
+
+	TArray<FString> Lines;
+	Lines.Reserve(Entries.Num() + 1);
+	Lines.Add(TEXT("phase,name,call_site,calls,total_ms,mean_us"));
+	for (const FAAANKPoseCallStat& Stat : Entries)
+	{
+		Lines.Add(FString::Printf(TEXT("%s,%s,%s,%lld,%.3f,%.2f"),
+			*Quote(Stat.Phase), *Quote(Stat.Name), *Quote(Stat.CallSite), Stat.Calls,
+			Stat.TotalSeconds * 1000.0, Stat.Calls > 0 ? Stat.TotalSeconds * 1.0e6 / Stat.Calls : 0.0));
+	}
+
+	const FString FileName = FString::Printf(TEXT("%s_%s.csv"), *FPaths::MakeValidFileName(MovieName), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+	const FString FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AAANKPose"), TEXT("CallProfiles"), FileName);
+	if (!FFileHelper::SaveStringArrayToFile(Lines, *FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("WriteCallReport: Could not write %s"), *FilePath);
+		return FString();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("WriteCallReport: %d entries written to %s"), Entries.Num(), *FilePath);
+	return FilePath;
+}
@@ -0,0 +1,288 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseFeatureIndex.h"
+#include "AAANKPoseMath.h"
+#include "AAANKPoseQueryTrace.h"
+#include "PoseSearch/PoseSearchDatabase.h"
+#include "PoseSearch/PoseSearchSchema.h"
+#include "Animation/AnimSequence.h"
+#include "Async/ParallelFor.h"
+#include "Misc/ScopedSlowTask.h"
+
+
+namespace AAANKPoseFeatureIndex
+{
+	/** Rows for a single asset; filled on a worker, appended on the game thread */
+	struct FAssetRows
+	{
+		TArray<float> Times;
+		TArray<float> Values;
+	};
+
+	static void ExtractAssetRows(const UAnimSequence* Anim, int32 SampleRate, int32 Dimension, FAssetRows& OutRows)
+	{
+		const TArray<float>& Offsets = UAAANKPoseFeatureIndexLibrary::GetTrajectorySampleOffsets();
+		const double Length = Anim->GetPlayLength();
+		const int32 NumSamples = FMath::Max(1, FMath::FloorToInt(Length * SampleRate) + 1);
+		const FAnimExtractContext Context;
+
+		OutRows.Times.SetNumUninitialized(NumSamples);
+		OutRows.Values.SetNumUninitialized(NumSamples * Dimension);
+
+		for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+		{
+			const double Time = FMath::Min(Sample / (double)SampleRate, Length);
+			float* Row = &OutRows.Values[Sample * Dimension];
+			OutRows.Times[Sample] = Time;
+
+			// Root positions relative to the pose at Time, clamped to the clip. A past sample inverts the motion
+			// that led up to Time rather than negating it, since that motion is expressed in the earlier, possibly turned, frame
+			for (int32 OffsetIndex = 0; OffsetIndex < Offsets.Num(); ++OffsetIndex)
+			{
+				const double Other = FMath::Clamp(Time + Offsets[OffsetIndex], 0.0, Length);
+				const FVector Translation = Other >= Time
+					? Anim->ExtractRootMotionFromRange(Time, Other, Context).GetTranslation()
+					: Anim->ExtractRootMotionFromRange(Other, Time, Context).Inverse().GetTranslation();
+				Row[OffsetIndex * 2 + 0] = Translation.X;
+				Row[OffsetIndex * 2 + 1] = Translation.Y;
+			}
+
+			// Facing at the furthest future sample
+			const double FacingTime = FMath::Min(Time + Offsets.Last(), Length);
+			const double Yaw = FMath::DegreesToRadians(Anim->ExtractRootMotionFromRange(Time, FacingTime, Context).Rotator().Yaw);
+			Row[Offsets.Num() * 2 + 0] = FMath::Cos(Yaw);
+			Row[Offsets.Num() * 2 + 1] = FMath::Sin(Yaw);
+		}
+	}
+
+	/** Indices built by GetCachedIndex, by database path; boxed so returned pointers survive later additions */
+	static TMap<FString, TUniquePtr<FAAANKPoseFeatureIndex>> CachedIndices;
+
+	/** Row stride of the first pass of EAAANKPoseSearchMode::Coarse */
+	static const int32 CoarseStride = 4;
+}
+
+const TArray<float>& UAAANKPoseFeatureIndexLibrary::GetTrajectorySampleOffsets()
+{
+	static const TArray<float> Offsets = { -0.33f, 0.33f, 0.66f, 1.0f };
+	return Offsets;
+}
+
+bool UAAANKPoseFeatureIndexLibrary::BuildFeatureIndex(UPoseSearchDatabase* Database, FAAANKPoseFeatureIndex& OutIndex, int32 MaxAssetsInFlight)
+{
+	using namespace AAANKPoseFeatureIndex;
+
+	if (!Database)
+	{
+		UE_LOG(LogTemp, Error, TEXT("BuildFeatureIndex: Invalid database"));
+		return false;
+	}
+
+#if WITH_EDITOR
+	UE_LOG(LogTemp, Log, TEXT("Building feature index for '%s'"), *Database->GetName());
+
+	const UPoseSearchSchema* Schema = Database->Schema;
+	const int32 SampleRate = FMath::Max(Schema ? Schema->SampleRate : 30, 1);
+	const int32 Dimension = (GetTrajectorySampleOffsets().Num() + 1) * 2;
+
+	TArray<UAnimSequence*> Anims;
+	for (int32 AssetIndex = 0; AssetIndex < Database->GetNumAnimationAssets(); ++AssetIndex)
+	{
+		const FPoseSearchDatabaseAnimationAsset* Entry = Database->GetDatabaseAnimationAsset(AssetIndex);
+		if (UAnimSequence* Anim = Entry ? Cast<UAnimSequence>(Entry->GetAnimationAsset()) : nullptr)
+		{
+			// Compressed data must be resident before workers sample it; every asset compresses concurrently
+			Anim->CacheDerivedDataForCurrentPlatform();
+			Anims.Add(Anim);
+		}
+	}
+	for (int32 AnimIndex = Anims.Num() - 1; AnimIndex >= 0; --AnimIndex)
+	{
+		UAnimSequence* Anim = Anims[AnimIndex];
+		Anim->WaitOnExistingCompression(/*bWantResults*/ true);
+		if (!Anim->IsCompressedDataValid())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("BuildFeatureIndex: '%s' failed to compress and is left out of the index"), *Anim->GetName());
+			Anims.RemoveAt(AnimIndex);
+		}
+	}
+
+	OutIndex = FAAANKPoseFeatureIndex();
+	OutIndex.DatabasePath = Database->GetPathName();
+	OutIndex.Dimension = Dimension;
+	OutIndex.SampleRate = SampleRate;
+
+	MaxAssetsInFlight = FMath::Max(MaxAssetsInFlight, 1);
+	FScopedSlowTask Progress(Anims.Num(), FText::FromString(TEXT("Extracting PoseSearch features")));
+	Progress.MakeDialog();
+
+	TArray<FAssetRows> ShardRows;
+	for (int32 ShardStart = 0; ShardStart < Anims.Num(); ShardStart += MaxAssetsInFlight)
+	{
+		const int32 ShardSize = FMath::Min(MaxAssetsInFlight, Anims.Num() - ShardStart);
+		ShardRows.Reset();
+		ShardRows.SetNum(ShardSize);
+
+		ParallelFor(ShardSize, [&](int32 LocalIndex)
+		{
+			ExtractAssetRows(Anims[ShardStart + LocalIndex], SampleRate, Dimension, ShardRows[LocalIndex]);
+		});
+
+		// Merge in database order so the index does not depend on scheduling
+		for (int32 LocalIndex = 0; LocalIndex < ShardSize; ++LocalIndex)
+		{
+			const int32 AssetIndex = OutIndex.AssetPaths.Add(Anims[ShardStart + LocalIndex]->GetPathName());
+			FAssetRows& Rows = ShardRows[LocalIndex];
+			for (int32 Row = 0; Row < Rows.Times.Num(); ++Row)
+			{
+				OutIndex.RowAssets.Add(AssetIndex);
+			}
+			OutIndex.RowTimes.Append(Rows.Times);
+			OutIndex.Values.Append(Rows.Values);
+		}
+		Progress.EnterProgressFrame(ShardSize);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Feature index for '%s': %d assets, %d rows x %d features"),
+		*Database->GetName(), OutIndex.AssetPaths.Num(), OutIndex.NumRows(), Dimension);
+	return true;
+#else
+	UE_LOG(LogTemp, Warning, TEXT("BuildFeatureIndex is only available in editor builds"));
+	return false;
+#endif
+}
+
+const FAAANKPoseFeatureIndex* UAAANKPoseFeatureIndexLibrary::GetCachedIndex(UPoseSearchDatabase* Database)
+{
+	using namespace AAANKPoseFeatureIndex;
+
+	if (!Database)
+	{
+		return nullptr;
+	}
+	const FString DatabasePath = Database->GetPathName();
+	if (const TUniquePtr<FAAANKPoseFeatureIndex>* Cached = CachedIndices.Find(DatabasePath))
+	{
+		return Cached->Get();
+	}
+
+	TUniquePtr<FAAANKPoseFeatureIndex> Index = MakeUnique<FAAANKPoseFeatureIndex>();
+	if (!BuildFeatureIndex(Database, *Index) || Index->NumRows() == 0)
+	{
+		return nullptr;
+	}
+	return CachedIndices.Add(DatabasePath, MoveTemp(Index)).Get();
+}
+
+TArray<float> UAAANKPoseFeatureIndexLibrary::MakeTrajectoryQuery(FVector Velocity)
+{
+	// Same layout as ExtractAssetRows: root offsets in the character's frame, then facing at the last offset
+	const TArray<float>& Offsets = GetTrajectorySampleOffsets();
+	TArray<float> Query;
+	Query.Reserve((Offsets.Num() + 1) * 2);
+	for (const float Offset : Offsets)
+	{
+		Query.Add(Velocity.X * Offset);
+		Query.Add(Velocity.Y * Offset);
+	}
+	// Constant velocity never turns
+	Query.Add(1.0f);
+	Query.Add(0.0f);
+	return Query;
+}
+
+FAAANKPoseQueryResult UAAANKPoseFeatureIndexLibrary::SearchIndex(const FAAANKPoseFeatureIndex& Index, TConstArrayView<float> Query, EAAANKPoseSearchMode Mode)
+{
+	FAAANKPoseQueryResult Result;
+	const int32 Dimension = Index.Dimension;
+	const int32 NumRows = Index.NumRows();
+	if (Dimension <= 0 || Query.Num() != Dimension || NumRows == 0 || Index.Values.Num() != NumRows * Dimension)
+	{
+		return Result;
+	}
+
+	const TConstArrayView<float> Rows(Index.Values);
+	switch (Mode)
+	{
+	case EAAANKPoseSearchMode::Exhaustive:
+	{
+		TArray<float> Distances;
+		Distances.SetNumUninitialized(NumRows);
+		AAANKPoseMath::SquaredDistances(Query, Rows, Distances);
+		Result.Row = 0;
+		for (int32 Row = 1; Row < NumRows; ++Row)
+		{
+			if (Distances[Row] < Distances[Result.Row])
+			{
+				Result.Row = Row;
+			}
+		}
+		Result.Cost = Distances[Result.Row];
+		break;
+	}
+	case EAAANKPoseSearchMode::EarlyOut:
+		Result.Row = AAANKPoseMath::FindNearestRow(Query, Rows, Result.Cost);
+		break;
+	case EAAANKPoseSearchMode::Coarse:
+	{
+		// Neighbouring rows are neighbouring times of one clip, so refine around the best strided row
+		const int32 Stride = AAANKPoseFeatureIndex::CoarseStride;
+		int32 CoarseBest = 0;
+		float CoarseCost = TNumericLimits<float>::Max();
+		for (int32 Row = 0; Row < NumRows; Row += Stride)
+		{
+			float Cost = 0.0f;
+			AAANKPoseMath::SquaredDistances(Query, Rows.Slice(Row * Dimension, Dimension), MakeArrayView(&Cost, 1));
+			if (Cost < CoarseCost)
+			{
+				CoarseBest = Row;
+				CoarseCost = Cost;
+			}
+		}
+		const int32 First = FMath::Max(0, CoarseBest - Stride + 1);
+		const int32 Last = FMath::Min(NumRows, CoarseBest + Stride);
+		Result.Row = First + AAANKPoseMath::FindNearestRow(Query, Rows.Slice(First * Dimension, (Last - First) * Dimension), Result.Cost);
+		break;
+	}
+	}
+
+	Result.AssetPath = Index.AssetPaths.IsValidIndex(Index.RowAssets[Result.Row]) ? Index.AssetPaths[Index.RowAssets[Result.Row]] : FString();
+	Result.Time = Index.RowTimes[Result.Row];
+	return Result;
+}
+
+FAAANKPoseQueryResult UAAANKPoseFeatureIndexLibrary::QueryFeatureIndex(const FAAANKPoseFeatureIndex& Index, const TArray<float>& Query, EAAANKPoseSearchMode Mode)
+{
+	if (Query.Num() != Index.Dimension)
+	{
+		UE_LOG(LogTemp, Error, TEXT("QueryFeatureIndex: Query has %d features, index '%s' has %d"), Query.Num(), *Index.DatabasePath, Index.Dimension);
+		return FAAANKPoseQueryResult();
+	}
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	const FAAANKPoseQueryResult Result = SearchIndex(Index, Query, Mode);
+	const double Seconds = FPlatformTime::Seconds() - StartSeconds;
+
+	if (FAAANKPoseQueryTrace::IsRecording())
+	{
+		FAAANKPoseQueryTrace::Record(Index.DatabasePath, Mode, Query, Result, Seconds);
+	}
+	return Result;
+}
+
+FAAANKPoseQueryResult UAAANKPoseFeatureIndexLibrary::QueryDatabase(UPoseSearchDatabase* Database, FVector Velocity, EAAANKPoseSearchMode Mode)
+{
+	if (!Database)
+	{
+		UE_LOG(LogTemp, Error, TEXT("QueryDatabase: Invalid database"));
+		return FAAANKPoseQueryResult();
+	}
+
+	const FAAANKPoseFeatureIndex* Index = GetCachedIndex(Database);
+	if (!Index)
+	{
+		UE_LOG(LogTemp, Error, TEXT("QueryDatabase: Could not index '%s'"), *Database->GetName());
+		return FAAANKPoseQueryResult();
+	}
+	return QueryFeatureIndex(*Index, MakeTrajectoryQuery(Velocity), Mode);
+}
@@ -0,0 +1,178 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseLeakDetector.h"
+#include "HAL/PlatformMemory.h"
+#include "UObject/UObjectIterator.h"
+
+
+namespace AAANKPoseLeakDetector
+{
+	/** Snapshots per movie, oldest first; only the tail is ever analysed */
+	static TMap<FString, TArray<FAAANKPoseLeakSnapshot>> RunHistory;
+	static const int32 MaxRunsPerMovie = 32;
+
+	/** Flattens a snapshot into one name -> value table so objects, callbacks and memory diff alike */
+	static TMap<FString, int64> Flatten(const FAAANKPoseLeakSnapshot& Snapshot)
+	{
+		TMap<FString, int64> Values;
+		Values.Reserve(Snapshot.ObjectCounts.Num() + Snapshot.CallbackCounts.Num() + 3);
+		for (const TPair<FString, int32>& Pair : Snapshot.ObjectCounts)
+		{
+			Values.Add(Pair.Key, Pair.Value);
+		}
+		for (const TPair<FString, int32>& Pair : Snapshot.CallbackCounts)
+		{
+			Values.Add(TEXT("Callback:") + Pair.Key, Pair.Value);
+		}
+		Values.Add(TEXT("TotalObjects"), Snapshot.TotalObjects);
+		Values.Add(TEXT("UsedPhysicalBytes"), Snapshot.UsedPhysicalBytes);
+		Values.Add(TEXT("UsedVirtualBytes"), Snapshot.UsedVirtualBytes);
+		return Values;
+	}
+
+	static bool IsMemoryCounter(const FString& Name)
+	{
+		return Name.EndsWith(TEXT("Bytes"));
+	}
+
+	static void SortByGrowth(TArray<FAAANKPoseLeakGrowth>& Growth)
+	{
+		// Objects and callbacks first, memory (whose magnitudes dwarf counts) last
+		Growth.Sort([](const FAAANKPoseLeakGrowth& A, const FAAANKPoseLeakGrowth& B)
+		{
+			const bool bMemoryA = IsMemoryCounter(A.Name);
+			const bool bMemoryB = IsMemoryCounter(B.Name);
+			return bMemoryA != bMemoryB ? bMemoryB : A.GrowthPerRun > B.GrowthPerRun;
+		});
+	}
+}
+
+FAAANKPoseLeakSnapshot UAAANKPoseLeakDetectorLibrary::TakeLeakSnapshot(const FString& Label, const TMap<FString, int32>& CallbackCounts, bool bCollectGarbageFirst)
+{
+	check(IsInGameThread());
+
+	if (bCollectGarbageFirst)
+	{
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, /*bPerformFullPurge*/ true);
+	}
+
+	FAAANKPoseLeakSnapshot Snapshot;
+	Snapshot.Label = Label;
+	Snapshot.CallbackCounts = CallbackCounts;
+
+	// Count by FName first; string keys are only built once per class
+	TMap<FName, int32> CountsByClass;
+	for (TObjectIterator<UObject> It; It; ++It)
+	{
+		++CountsByClass.FindOrAdd(It->GetClass()->GetFName());
+		++Snapshot.TotalObjects;
+	}
+	Snapshot.ObjectCounts.Reserve(CountsByClass.Num());
+	for (const TPair<FName, int32>& Pair : CountsByClass)
+	{
+		Snapshot.ObjectCounts.Add(Pair.Key.ToString(), Pair.Value);
+	}
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	Snapshot.UsedPhysicalBytes = MemoryStats.UsedPhysical;
+	Snapshot.UsedVirtualBytes = MemoryStats.UsedVirtual;
+
+	UE_LOG(LogTemp, Log, TEXT("TakeLeakSnapshot: '%s' %d objects in %d classes, %.1f MB physical"),
+		*Label, Snapshot.TotalObjects, Snapshot.ObjectCounts.Num(), Snapshot.UsedPhysicalBytes / (1024.0 * 1024.0));
+	return Snapshot;
+}
+
+TArray<FAAANKPoseLeakGrowth> UAAANKPoseLeakDetectorLibrary::DiffLeakSnapshots(const FAAANKPoseLeakSnapshot& Before, const FAAANKPoseLeakSnapshot& After, int64 MinGrowth)
+{
+	using namespace AAANKPoseLeakDetector;
+
+	const TMap<FString, int64> BeforeValues = Flatten(Before);
+	const TMap<FString, int64> AfterValues = Flatten(After);
+
+	TArray<FAAANKPoseLeakGrowth> Growth;
+	for (const TPair<FString, int64>& Pair : AfterValues)
+	{
+		const int64 First = BeforeValues.FindRef(Pair.Key);
+		if (Pair.Value - First >= MinGrowth)
+		{
+			FAAANKPoseLeakGrowth& Entry = Growth.AddDefaulted_GetRef();
+			Entry.Name = Pair.Key;
+			Entry.First = First;
+			Entry.Last = Pair.Value;
+			Entry.GrowthPerRun = static_cast<double>(Pair.Value - First);
+		}
+	}
+
+	SortByGrowth(Growth);
+	return Growth;
+}
+
+FAAANKPoseLeakSnapshot UAAANKPoseLeakDetectorLibrary::RecordRunSnapshot(const FString& MovieName, const TMap<FString, int32>& CallbackCounts)
+{
+	TArray<FAAANKPoseLeakSnapshot>& Runs = AAANKPoseLeakDetector::RunHistory.FindOrAdd(MovieName);
+	FAAANKPoseLeakSnapshot Snapshot = TakeLeakSnapshot(FString::Printf(TEXT("%s run %d"), *MovieName, Runs.Num() + 1), CallbackCounts, /*bCollectGarbageFirst*/ true);
+
+	Runs.Add(Snapshot);
+	if (Runs.Num() > AAANKPoseLeakDetector::MaxRunsPerMovie)
+	{
+		Runs.RemoveAt(0, Runs.Num() - AAANKPoseLeakDetector::MaxRunsPerMovie);
+	}
+	return Snapshot;
+}
+
+TArray<FAAANKPoseLeakGrowth> UAAANKPoseLeakDetectorLibrary::AnalyzeRunGrowth(const FString& MovieName, int32 NumRuns, int64 MemoryNoiseBytes)
+{
+	using namespace AAANKPoseLeakDetector;
+
+	TArray<FAAANKPoseLeakGrowth> Growth;
+	const TArray<FAAANKPoseLeakSnapshot>* Runs = RunHistory.Find(MovieName);
+	NumRuns = FMath::Max(NumRuns, 2);
+	if (!Runs || Runs->Num() < NumRuns)
+	{
+		return Growth;
+	}
+
+	TArray<TMap<FString, int64>> Series;
+	for (int32 Index = Runs->Num() - NumRuns; Index < Runs->Num(); ++Index)
+	{
+		Series.Add(Flatten((*Runs)[Index]));
+	}
+
+	// A leak grows on every run; anything that levels off or shrinks is a cache warming up
+	for (const TPair<FString, int64>& Pair : Series.Last())
+	{
+		const int64 Noise = IsMemoryCounter(Pair.Key) ? MemoryNoiseBytes : 0;
+		bool bGrewEveryRun = true;
+		for (int32 Run = 1; Run < Series.Num() && bGrewEveryRun; ++Run)
+		{
+			bGrewEveryRun = Series[Run].FindRef(Pair.Key) - Series[Run - 1].FindRef(Pair.Key) > Noise;
+		}
+		if (bGrewEveryRun)
+		{
+			FAAANKPoseLeakGrowth& Entry = Growth.AddDefaulted_GetRef();
+			Entry.Name = Pair.Key;
+			Entry.First = Series[0].FindRef(Pair.Key);
+			Entry.Last = Pair.Value;
+			Entry.GrowthPerRun = static_cast<double>(Entry.Last - Entry.First) / (Series.Num() - 1);
+		}
+	}
+
+	SortByGrowth(Growth);
+	for (const FAAANKPoseLeakGrowth& Entry : Growth)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("AnalyzeRunGrowth: '%s' %s grew on each of the last %d runs (%lld -> %lld, %.1f per run)"),
+			*MovieName, *Entry.Name, NumRuns, Entry.First, Entry.Last, Entry.GrowthPerRun);
+	}
+	return Growth;
+}
+
+int32 UAAANKPoseLeakDetectorLibrary::GetRecordedRunCount(const FString& MovieName)
+{
+	const TArray<FAAANKPoseLeakSnapshot>* Runs = AAANKPoseLeakDetector::RunHistory.Find(MovieName);
+	return Runs ? Runs->Num() : 0;
+}
+
+void UAAANKPoseLeakDetectorLibrary::ResetRunHistory(const FString& MovieName)
+{
+	AAANKPoseLeakDetector::RunHistory.Remove(MovieName);
+}
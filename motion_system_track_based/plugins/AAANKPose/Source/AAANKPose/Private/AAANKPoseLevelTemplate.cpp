@@ -0,0 +1,184 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseLevelTemplate.h"
+#include "AAANKPoseSceneBuild.h"
+#include "AAANKPoseSpawnLibrary.h"
+#include "Components/ExponentialHeightFogComponent.h"
+#include "Components/LightComponent.h"
+#include "Engine/DirectionalLight.h"
+#include "Engine/ExponentialHeightFog.h"
+#include "EngineUtils.h"
+#include "Misc/PackageName.h"
+
+#if WITH_EDITOR
+#include "Editor.h"
+#include "LevelEditorSubsystem.h"
+#endif
+
+
+const TCHAR* FAAANKPoseLevelTemplate::DefaultTemplate = TEXT("/Game/Movies/Templates/MovieTemplate");
+const TCHAR* FAAANKPoseLevelTemplate::EngineTemplate = TEXT("/Engine/Maps/Templates/Template_Default");
+
+namespace AAANKPoseLevelTemplate
+{
+#if WITH_EDITOR
+	static ULevelEditorSubsystem* GetLevelEditor()
+	{
+		return GEditor ? GEditor->GetEditorSubsystem<ULevelEditorSubsystem>() : nullptr;
+	}
+#endif
+
+	template <typename ActorType>
+	static ActorType* FindFirst(UWorld& World)
+	{
+		TActorIterator<ActorType> It(&World);
+		return It ? *It : nullptr;
+	}
+}
+
+FString FAAANKPoseLevelTemplate::GetMovieLevelPath(const FString& SceneName)
+{
+	// Same name the movie's sequence gets, so spaces and dashes never reach a package path
+	return FString::Printf(TEXT("/Game/Movies/Levels/%s"), *FAAANKPoseSceneBuild::GetSequenceBaseName(SceneName));
+}
+
+bool FAAANKPoseLevelTemplate::PrepareTemplate(const FString& TemplatePath)
+{
+#if WITH_EDITOR
+	if (FPackageName::DoesPackageExist(TemplatePath))
+	{
+		return true;
+	}
+
+	ULevelEditorSubsystem* LevelEditor = AAANKPoseLevelTemplate::GetLevelEditor();
+	if (!LevelEditor || !LevelEditor->NewLevelFromTemplate(TemplatePath, EngineTemplate) || !LevelEditor->SaveCurrentLevel())
+	{
+		UE_LOG(LogTemp, Error, TEXT("PrepareTemplate: Could not create '%s' from '%s'"), *TemplatePath, EngineTemplate);
+		return false;
+	}
+	UE_LOG(LogTemp, Log, TEXT("PrepareTemplate: Created '%s' from '%s'; dress it once and every new-level movie starts from it"), *TemplatePath, EngineTemplate);
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool FAAANKPoseLevelTemplate::CreateMovieLevel(const FString& LevelPath, const FString& TemplatePath, const FAAANKPoseLevelOverrides& Overrides)
+{
+#if WITH_EDITOR
+	ULevelEditorSubsystem* LevelEditor = AAANKPoseLevelTemplate::GetLevelEditor();
+	if (!LevelEditor)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CreateMovieLevel: Needs the editor"));
+		return false;
+	}
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	const FString Template = TemplatePath.IsEmpty() ? FString(DefaultTemplate) : TemplatePath;
+	if (Template == DefaultTemplate && !PrepareTemplate(Template))
+	{
+		return false;
+	}
+
+	// Re-runs of the same movie keep the level they already have open
+	UWorld* World = GEditor->GetEditorWorldContext().World();
+	const bool bAlreadyOpen = World && World->GetOutermost()->GetName() == LevelPath;
+	if (!bAlreadyOpen)
+	{
+		const bool bExists = FPackageName::DoesPackageExist(LevelPath);
+		if (!bExists && !FPackageName::DoesPackageExist(Template))
+		{
+			UE_LOG(LogTemp, Error, TEXT("CreateMovieLevel: Template '%s' does not exist"), *Template);
+			return false;
+		}
+		if (bExists ? !LevelEditor->LoadLevel(LevelPath) : !LevelEditor->NewLevelFromTemplate(LevelPath, Template))
+		{
+			UE_LOG(LogTemp, Error, TEXT("CreateMovieLevel: Could not open '%s'"), *LevelPath);
+			return false;
+		}
+		World = GEditor->GetEditorWorldContext().World();
+	}
+
+	if (!World)
+	{
+		return false;
+	}
+	ApplyOverrides(*World, Overrides);
+
+	UE_LOG(LogTemp, Log, TEXT("CreateMovieLevel: %s '%s' in %.1f ms"),
+		bAlreadyOpen ? TEXT("Reused open") : TEXT("Opened"), *LevelPath, (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool FAAANKPoseLevelTemplate::ApplyOverrides(UWorld& World, const FAAANKPoseLevelOverrides& Overrides)
+{
+	bool bApplied = true;
+
+	if (Overrides.bOverrideFog)
+	{
+		AExponentialHeightFog* Fog = AAANKPoseLevelTemplate::FindFirst<AExponentialHeightFog>(World);
+		UExponentialHeightFogComponent* Component = Fog ? Fog->GetComponent() : nullptr;
+		if (Component)
+		{
+			Fog->Modify();
+			Component->SetFogDensity(Overrides.FogDensity);
+			Component->SetFogInscatteringColor(Overrides.FogColor);
+			Component->SetFogHeightFalloff(Overrides.FogHeightFalloff);
+			Component->SetFogMaxOpacity(Overrides.FogMaxOpacity);
+			Component->SetStartDistance(Overrides.FogStartDistance);
+			Component->SetVolumetricFog(Overrides.bVolumetricFog);
+			if (Overrides.bVolumetricFog)
+			{
+				Component->SetVolumetricFogScatteringDistribution(Overrides.VolumetricScattering);
+				Component->SetVolumetricFogAlbedo(Overrides.VolumetricAlbedo.ToFColor(/*bSRGB*/ false));
+			}
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ApplyOverrides: Level has no ExponentialHeightFog to override"));
+			bApplied = false;
+		}
+	}
+
+	if (Overrides.bOverrideSun)
+	{
+		ADirectionalLight* Sun = AAANKPoseLevelTemplate::FindFirst<ADirectionalLight>(World);
+		if (Sun && Sun->GetLightComponent())
+		{
+			Sun->Modify();
+			Sun->SetActorRotation(Overrides.SunRotation);
+			Sun->GetLightComponent()->SetIntensity(Overrides.SunIntensity);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ApplyOverrides: Level has no DirectionalLight to override"));
+			bApplied = false;
+		}
+	}
+
+	return bApplied;
+}
+
+bool UAAANKPoseLevelTemplateLibrary::CreateMovieLevel(const FString& LevelPath, const FString& TemplatePath, const FAAANKPoseLevelOverrides& Overrides)
+{
+	return FAAANKPoseLevelTemplate::CreateMovieLevel(LevelPath, TemplatePath, Overrides);
+}
+
+bool UAAANKPoseLevelTemplateLibrary::PrepareTemplate(const FString& TemplatePath)
+{
+	return FAAANKPoseLevelTemplate::PrepareTemplate(TemplatePath.IsEmpty() ? FString(FAAANKPoseLevelTemplate::DefaultTemplate) : TemplatePath);
+}
+
+bool UAAANKPoseLevelTemplateLibrary::ApplyLevelOverrides(UObject* WorldContextObject, const FAAANKPoseLevelOverrides& Overrides)
+{
+	UWorld* World = UAAANKPoseSpawnLibrary::ResolveWorld(WorldContextObject);
+	return World && FAAANKPoseLevelTemplate::ApplyOverrides(*World, Overrides);
+}
+
+FString UAAANKPoseLevelTemplateLibrary::GetMovieLevelPath(const FString& SceneName)
+{
+	return FAAANKPoseLevelTemplate::GetMovieLevelPath(SceneName);
+}
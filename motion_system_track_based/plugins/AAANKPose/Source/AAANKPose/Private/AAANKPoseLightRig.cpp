@@ -0,0 +1,267 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseLightRig.h"
+#include "AAANKPoseBuildTelemetry.h"
+#include "AAANKPoseMannequin.h"
+#include "AAANKPoseQuietMode.h"
+#include "AAANKPoseSpawnLibrary.h"
+#include "Algo/Count.h"
+#include "Components/DirectionalLightComponent.h"
+#include "Components/LocalLightComponent.h"
+#include "Components/RectLightComponent.h"
+#include "Components/SkyLightComponent.h"
+#include "Components/SpotLightComponent.h"
+#include "Engine/DirectionalLight.h"
+#include "Engine/PointLight.h"
+#include "Engine/RectLight.h"
+#include "Engine/SkyLight.h"
+#include "Engine/SpotLight.h"
+#include "Engine/World.h"
+
+
+namespace AAANKPoseLightRig
+{
+	static TMap<FName, FAAANKPoseLightRig> Presets;
+
+	static FAAANKPoseLightDescriptor MakeDirectional(const TCHAR* Name, const FRotator& Rotation, float Intensity, const FLinearColor& Color)
+	{
+		FAAANKPoseLightDescriptor Light;
+		Light.Name = Name;
+		Light.LightType = EAAANKPoseLightType::Directional;
+		Light.Transform = FTransform(Rotation);
+		Light.Intensity = Intensity;
+		Light.Color = Color;
+		return Light;
+	}
+
+	/** The setups movies/god_rays_test.py and movies/cathedral_god_rays.py build by hand */
+	static void BuildDefaultPresets()
+	{
+		{
+			FAAANKPoseLightDescriptor Sun = MakeDirectional(TEXT("SunLight"), FRotator(-45.0, 45.0, 0.0), 10.0f, FLinearColor(1.0f, 0.95f, 0.85f));
+			Sun.bAtmosphereSunLight = true;
+			Sun.bCastVolumetricShadow = true;
+			Sun.bEnableLightShaftBloom = true;
+			Sun.BloomScale = 0.5f;
+			Sun.bEnableLightShaftOcclusion = true;
+
+			FAAANKPoseLightDescriptor Sky;
+			Sky.Name = TEXT("SkyFill");
+			Sky.LightType = EAAANKPoseLightType::Sky;
+			Sky.Intensity = 1.0f;
+			Sky.bCastShadows = false;
+
+			Presets.Add(TEXT("god_rays")).Lights = { Sun, Sky };
+		}
+		{
+			FAAANKPoseLightDescriptor Window = MakeDirectional(TEXT("WindowLight"), FRotator(-45.0, -90.0, 0.0), 12.0f, FLinearColor(1.0f, 0.95f, 0.9f));
+			Window.bCastVolumetricShadow = true;
+			Window.bEnableLightShaftBloom = true;
+			Window.BloomScale = 0.6f;
+			Window.bEnableLightShaftOcclusion = true;
+
+			FAAANKPoseLightDescriptor Fill = MakeDirectional(TEXT("FillLight"), FRotator(-75.0, 90.0, 0.0), 4.0f, FLinearColor(0.7f, 0.8f, 1.0f));
+			Fill.bEnableLightShaftBloom = true;
+			Fill.BloomScale = 0.1f;
+			Fill.bEnableLightShaftOcclusion = true;
+
+			Presets.Add(TEXT("cathedral")).Lights = { Window, Fill };
+		}
+	}
+
+	static void EnsurePresets()
+	{
+		static bool bBuilt = false;
+		if (!bBuilt)
+		{
+			bBuilt = true;
+			BuildDefaultPresets();
+		}
+	}
+
+	static UClass* GetActorClass(EAAANKPoseLightType LightType)
+	{
+		switch (LightType)
+		{
+		case EAAANKPoseLightType::Point:       return APointLight::StaticClass();
+		case EAAANKPoseLightType::Directional: return ADirectionalLight::StaticClass();
+		case EAAANKPoseLightType::Spot:        return ASpotLight::StaticClass();
+		case EAAANKPoseLightType::Rect:        return ARectLight::StaticClass();
+		case EAAANKPoseLightType::Sky:         return ASkyLight::StaticClass();
+		}
+		return nullptr;
+	}
+
+	/**
+	 * PostSpawnInitialize has already registered the components, deferred construction or not. Each setter would
+	 * push its own render update, so the properties are written directly (colors converted as SetLightColor does)
+	 * and the render state is recreated once, at the end of the frame.
+	 */
+	static void Configure(AActor& Actor, const FAAANKPoseLightDescriptor& Light)
+	{
+		if (ASkyLight* SkyLight = Cast<ASkyLight>(&Actor))
+		{
+			USkyLightComponent* Component = SkyLight->GetLightComponent();
+			Component->Intensity = Light.Intensity;
+			Component->LightColor = Light.Color.ToFColor(true);
+			Component->CastShadows = Light.bCastShadows;
+			Component->bCastVolumetricShadow = Light.bCastVolumetricShadow;
+			Component->MarkRenderStateDirty();
+			return;
+		}
+
+		ULightComponent* Component = CastChecked<ALight>(&Actor)->GetLightComponent();
+		Component->Intensity = Light.Intensity;
+		Component->LightColor = Light.Color.ToFColor(true);
+		Component->CastShadows = Light.bCastShadows;
+		Component->bCastVolumetricShadow = Light.bCastVolumetricShadow;
+		Component->bEnableLightShaftBloom = Light.bEnableLightShaftBloom;
+		if (Light.bEnableLightShaftBloom)
+		{
+			Component->BloomScale = Light.BloomScale;
+			Component->BloomThreshold = Light.BloomThreshold;
+		}
+
+		if (ULocalLightComponent* Local = Cast<ULocalLightComponent>(Component))
+		{
+			Local->IntensityUnits = Light.IntensityUnits;
+			Local->AttenuationRadius = Light.AttenuationRadius;
+		}
+		if (USpotLightComponent* Spot = Cast<USpotLightComponent>(Component))
+		{
+			Spot->InnerConeAngle = Light.InnerConeAngle;
+			Spot->OuterConeAngle = Light.OuterConeAngle;
+		}
+		if (URectLightComponent* Rect = Cast<URectLightComponent>(Component))
+		{
+			Rect->SourceWidth = Light.SourceWidth;
+			Rect->SourceHeight = Light.SourceHeight;
+		}
+		if (UDirectionalLightComponent* Directional = Cast<UDirectionalLightComponent>(Component))
+		{
+			Directional->bAtmosphereSunLight = Light.bAtmosphereSunLight;
+			Directional->bEnableLightShaftOcclusion = Light.bEnableLightShaftOcclusion;
+			if (Light.bEnableLightShaftOcclusion)
+			{
+				Directional->OcclusionMaskDarkness = Light.OcclusionMaskDarkness;
+			}
+		}
+		Component->MarkRenderStateDirty();
+	}
+}
+
+TArray<AActor*> FAAANKPoseLightRigBuilder::Spawn(UWorld* World, const FAAANKPoseLightRig& Rig)
+{
+	using namespace AAANKPoseLightRig;
+
+	TArray<AActor*> Actors;
+	Actors.SetNumZeroed(Rig.Lights.Num());
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SpawnLightRig: No world to spawn into"));
+		return Actors;
+	}
+
+	FAAANKPoseQuietScope QuietScope;
+
+	// Pass 1: spawn deferred and configure before any construction script runs
+	for (int32 Index = 0; Index < Rig.Lights.Num(); ++Index)
+	{
+		const FAAANKPoseLightDescriptor& Light = Rig.Lights[Index];
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.bDeferConstruction = true;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParams.ObjectFlags |= RF_Transactional;
+
+		AActor* Actor = World->SpawnActor(GetActorClass(Light.LightType), &Light.Transform, SpawnParams);
+		if (!Actor)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SpawnLightRig: Failed to spawn '%s'"), *Light.Name);
+			continue;
+		}
+
+		Configure(*Actor, Light);
+		Actor->Tags.AddUnique(AAAANKPoseMannequin::MotionSystemTag);
+#if WITH_EDITOR
+		if (!Light.Name.IsEmpty())
+		{
+			Actor->SetActorLabel(Light.Name, /*bMarkDirty*/ false);
+		}
+#endif
+		Actors[Index] = Actor;
+	}
+
+	// Pass 2: finish construction with every light configured
+	for (int32 Index = 0; Index < Rig.Lights.Num(); ++Index)
+	{
+		if (Actors[Index])
+		{
+			Actors[Index]->FinishSpawning(Rig.Lights[Index].Transform);
+		}
+	}
+
+	World->MarkPackageDirty();
+	const int32 Spawned = Actors.Num() - Algo::Count(Actors, nullptr);
+	FAAANKPoseBuildTelemetry::AddCounter(FAAANKPoseBuildTelemetry::ActorsSpawned, Spawned);
+
+	UE_LOG(LogTemp, Log, TEXT("SpawnLightRig: Spawned %d/%d lights"), Spawned, Rig.Lights.Num());
+	return Actors;
+}
+
+const FAAANKPoseLightRig* FAAANKPoseLightRigBuilder::FindPreset(FName PresetName)
+{
+	AAANKPoseLightRig::EnsurePresets();
+	return AAANKPoseLightRig::Presets.Find(PresetName);
+}
+
+void FAAANKPoseLightRigBuilder::RegisterPreset(FName PresetName, const FAAANKPoseLightRig& Rig)
+{
+	AAANKPoseLightRig::EnsurePresets();
+	AAANKPoseLightRig::Presets.Add(PresetName, Rig);
+}
+
+TArray<FName> FAAANKPoseLightRigBuilder::GetPresetNames()
+{
+	AAANKPoseLightRig::EnsurePresets();
+	TArray<FName> Names;
+	AAANKPoseLightRig::Presets.GetKeys(Names);
+	return Names;
+}
+
+TArray<AActor*> UAAANKPoseLightRigLibrary::SpawnLightRig(UObject* WorldContextObject, const FAAANKPoseLightRig& Rig)
+{
+	return FAAANKPoseLightRigBuilder::Spawn(UAAANKPoseSpawnLibrary::ResolveWorld(WorldContextObject), Rig);
+}
+
+TArray<AActor*> UAAANKPoseLightRigLibrary::SpawnLightRigPreset(UObject* WorldContextObject, FName PresetName)
+{
+	const FAAANKPoseLightRig* Rig = FAAANKPoseLightRigBuilder::FindPreset(PresetName);
+	if (!Rig)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SpawnLightRigPreset: No preset named '%s'"), *PresetName.ToString());
+		return TArray<AActor*>();
+	}
+	return FAAANKPoseLightRigBuilder::Spawn(UAAANKPoseSpawnLibrary::ResolveWorld(WorldContextObject), *Rig);
+}
+
+bool UAAANKPoseLightRigLibrary::GetLightRigPreset(FName PresetName, FAAANKPoseLightRig& OutRig)
+{
+	const FAAANKPoseLightRig* Rig = FAAANKPoseLightRigBuilder::FindPreset(PresetName);
+	if (!Rig)
+	{
+		return false;
+	}
+	OutRig = *Rig;
+	return true;
+}
+
+void UAAANKPoseLightRigLibrary::RegisterLightRigPreset(FName PresetName, const FAAANKPoseLightRig& Rig)
+{
+	FAAANKPoseLightRigBuilder::RegisterPreset(PresetName, Rig);
+}
+
+TArray<FName> UAAANKPoseLightRigLibrary::GetLightRigPresetNames()
+{
+	return FAAANKPoseLightRigBuilder::GetPresetNames();
+}
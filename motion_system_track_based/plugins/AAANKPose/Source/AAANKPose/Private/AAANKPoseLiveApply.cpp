@@ -0,0 +1,291 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseLiveApply.h"
+#include "AAANKPose.h"
+#include "AAANKPoseSceneBuild.h"
+#include "AAANKPoseTrackFolder.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "LevelSequence.h"
+#include "Misc/Paths.h"
+#include "MovieScene.h"
+#include "Sections/MovieScene3DTransformSection.h"
+#include "Sections/MovieSceneFloatSection.h"
+#include "Sections/MovieSceneSubSection.h"
+#include "Tracks/MovieScene3DTransformTrack.h"
+#include "Tracks/MovieSceneCinematicShotTrack.h"
+#include "Tracks/MovieSceneFloatTrack.h"
+#include "Tracks/MovieSceneSkeletalAnimationTrack.h"
+
+
+namespace AAANKPoseLiveApply
+{
+	static const FName FocalLengthProperty(TEXT("CurrentFocalLength"));
+
+	static FGuid FindActorBinding(UMovieScene& MovieScene, const FString& ActorName)
+	{
+		for (int32 Index = 0; Index < MovieScene.GetPossessableCount(); ++Index)
+		{
+			const FMovieScenePossessable& Possessable = MovieScene.GetPossessable(Index);
+			if (!Possessable.GetParent().IsValid() && Possessable.GetName() == ActorName)
+			{
+				return Possessable.GetGuid();
+			}
+		}
+		return FGuid();
+	}
+
+	/** Shot partitioned builds bind actors in each shot's subsequence rather than in the master */
+	static void GatherShotSequences(UMovieScene& MovieScene, TArray<UMovieSceneSequence*>& OutShots)
+	{
+		const UMovieSceneCinematicShotTrack* ShotTrack = MovieScene.FindTrack<UMovieSceneCinematicShotTrack>();
+		if (!ShotTrack)
+		{
+			return;
+		}
+		for (UMovieSceneSection* Section : ShotTrack->GetAllSections())
+		{
+			const UMovieSceneSubSection* SubSection = Cast<UMovieSceneSubSection>(Section);
+			UMovieSceneSequence* ShotSequence = SubSection ? SubSection->GetSequence() : nullptr;
+			if (ShotSequence && ShotSequence->GetMovieScene())
+			{
+				OutShots.AddUnique(ShotSequence);
+			}
+		}
+	}
+
+	/** Component bindings are children of the actor binding, one per bound component class */
+	static FGuid FindChildBinding(UMovieScene& MovieScene, const FGuid& Parent, const UClass* ComponentClass)
+	{
+		for (int32 Index = 0; Index < MovieScene.GetPossessableCount(); ++Index)
+		{
+			const FMovieScenePossessable& Possessable = MovieScene.GetPossessable(Index);
+			if (Possessable.GetParent() == Parent && Possessable.GetPossessedObjectClass() && Possessable.GetPossessedObjectClass()->IsChildOf(ComponentClass))
+			{
+				return Possessable.GetGuid();
+			}
+		}
+		return FGuid();
+	}
+
+	/** Grow a range's upper bound to End; ranges are never shrunk so other actors keep their tails */
+	static TRange<FFrameNumber> Extend(const TRange<FFrameNumber>& Range, FFrameNumber End)
+	{
+		if (Range.HasUpperBound() && Range.GetUpperBoundValue() >= End)
+		{
+			return Range;
+		}
+		const FFrameNumber Start = Range.HasLowerBound() ? Range.GetLowerBoundValue() : FFrameNumber(0);
+		return TRange<FFrameNumber>(Start, End);
+	}
+
+	/** Shots keep their sliced ranges; only the master grows to fit a longer track */
+	static bool ApplyTransform(UMovieScene& MovieScene, const FGuid& Binding, const FString& ActorFolder, bool bIsShot)
+	{
+		FAAANKPoseTransformReader Reader(ActorFolder);
+		if (!Reader.IsValid())
+		{
+			return false;
+		}
+
+		UMovieScene3DTransformTrack* Track = MovieScene.FindTrack<UMovieScene3DTransformTrack>(Binding);
+		if (!Track)
+		{
+			Track = MovieScene.AddTrack<UMovieScene3DTransformTrack>(Binding);
+		}
+		UMovieScene3DTransformSection* Section = Track->GetAllSections().Num() > 0 ? Cast<UMovieScene3DTransformSection>(Track->GetAllSections()[0]) : nullptr;
+		if (!Section)
+		{
+			Section = CastChecked<UMovieScene3DTransformSection>(Track->CreateNewSection());
+			Track->AddSection(*Section);
+			if (bIsShot)
+			{
+				Section->SetRange(MovieScene.GetPlaybackRange());
+			}
+		}
+
+		const FFrameNumber End = FAAANKPoseSceneBuild::DisplayFrameToTick(MovieScene, Reader.GetLastFrame() + FAAANKPoseSceneBuild::TailFrames);
+		Section->Modify();
+		FAAANKPoseSceneBuild::StreamTransformKeys(*Section, Reader);
+		if (!bIsShot)
+		{
+			Section->SetRange(Extend(Section->GetRange(), End));
+			MovieScene.SetPlaybackRange(Extend(MovieScene.GetPlaybackRange(), End));
+		}
+		return true;
+	}
+
+	static bool ApplyAnimations(UMovieScene& MovieScene, const FGuid& Binding, const FString& ActorFolder)
+	{
+		const FGuid MeshBinding = FindChildBinding(MovieScene, Binding, USkeletalMeshComponent::StaticClass());
+		UMovieSceneSkeletalAnimationTrack* Track = MeshBinding.IsValid() ? MovieScene.FindTrack<UMovieSceneSkeletalAnimationTrack>(MeshBinding) : nullptr;
+		if (!Track)
+		{
+			// Binding a new component needs the spawned actor; that is a rebuild, not a live edit
+			return false;
+		}
+
+		TArray<FAAANKPoseAnimationSection> Sections;
+		FAAANKPoseTrackFolder::LoadAnimationSections(ActorFolder, Sections);
+
+		const FFrameNumber PlaybackEnd = MovieScene.GetPlaybackRange().GetUpperBoundValue();
+		const int32 DefaultEndFrame = FFrameRate::TransformTime(FFrameTime(PlaybackEnd), MovieScene.GetTickResolution(), MovieScene.GetDisplayRate()).FloorToFrame().Value;
+
+		Track->Modify();
+		Track->RemoveAllAnimationData();
+		FAAANKPoseSceneBuild::AddAnimationSections(*Track, Sections, DefaultEndFrame);
+		return true;
+	}
+
+	static bool ApplyFocalLength(UMovieScene& MovieScene, const FGuid& Binding, const FString& ActorFolder)
+	{
+		TArray<TPair<int32, float>> Keys;
+		FAAANKPoseTrackFolder::LoadFocalLengthKeys(ActorFolder, Keys);
+		if (Keys.Num() == 0)
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < MovieScene.GetPossessableCount(); ++Index)
+		{
+			const FMovieScenePossessable& Possessable = MovieScene.GetPossessable(Index);
+			if (Possessable.GetParent() != Binding)
+			{
+				continue;
+			}
+			for (UMovieSceneTrack* Track : MovieScene.FindTracks(UMovieSceneFloatTrack::StaticClass(), Possessable.GetGuid()))
+			{
+				UMovieSceneFloatTrack* FloatTrack = Cast<UMovieSceneFloatTrack>(Track);
+				if (!FloatTrack || FloatTrack->GetPropertyName() != FocalLengthProperty || FloatTrack->GetAllSections().Num() == 0)
+				{
+					continue;
+				}
+				UMovieSceneFloatSection* Section = Cast<UMovieSceneFloatSection>(FloatTrack->GetAllSections()[0]);
+				if (Section)
+				{
+					Section->Modify();
+					FAAANKPoseSceneBuild::WriteFocalLengthKeys(*Section, Keys);
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+}
+
+int32 FAAANKPoseLiveApply::ApplyActorTracks(ULevelSequence* Sequence, const FString& MovieFolder, const TArray<FString>& ActorNames)
+{
+	UMovieScene* MovieScene = Sequence ? Sequence->GetMovieScene() : nullptr;
+	if (!MovieScene)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ApplyActorTracks: No sequence to apply '%s' to"), *MovieFolder);
+		return 0;
+	}
+
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	// The master first, then every shot; an actor may be bound in several shots
+	TArray<UMovieSceneSequence*> Sequences;
+	Sequences.Add(Sequence);
+	AAANKPoseLiveApply::GatherShotSequences(*MovieScene, Sequences);
+
+	TSet<UMovieSceneSequence*> Changed;
+	int32 Applied = 0;
+	for (const FString& ActorName : ActorNames)
+	{
+		const FString ActorFolder = FPaths::Combine(MovieFolder, ActorName);
+		bool bBound = false;
+		bool bApplied = false;
+		for (UMovieSceneSequence* Target : Sequences)
+		{
+			UMovieScene& TargetScene = *Target->GetMovieScene();
+			const FGuid Binding = AAANKPoseLiveApply::FindActorBinding(TargetScene, ActorName);
+			if (!Binding.IsValid())
+			{
+				continue;
+			}
+			bBound = true;
+
+			TargetScene.Modify();
+			const bool bIsShot = Target != Sequence;
+			const bool bTransform = AAANKPoseLiveApply::ApplyTransform(TargetScene, Binding, ActorFolder, bIsShot);
+			const bool bAnimations = AAANKPoseLiveApply::ApplyAnimations(TargetScene, Binding, ActorFolder);
+			const bool bFocalLength = AAANKPoseLiveApply::ApplyFocalLength(TargetScene, Binding, ActorFolder);
+			if (bTransform || bAnimations || bFocalLength)
+			{
+				Changed.Add(Target);
+				bApplied = true;
+			}
+		}
+
+		if (!bBound)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ApplyActorTracks: '%s' is not bound in %s or its shots; rebuild the scene to add it"), *ActorName, *Sequence->GetName());
+		}
+		else if (bApplied)
+		{
+			++Applied;
+		}
+	}
+
+	for (UMovieSceneSequence* Target : Changed)
+	{
+		Target->MarkPackageDirty();
+		Target->GetMovieScene()->MarkAsChanged();
+	}
+	UE_LOG(LogTemp, Log, TEXT("ApplyActorTracks: Re-keyed %d/%d actors of %s in %.1f ms"), Applied, ActorNames.Num(), *Sequence->GetName(),
+		(FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+	return Applied;
+}
+
+bool FAAANKPoseLiveApply::IsActorTrackFile(const FString& RelativePath, FString& OutActorName)
+{
+	TArray<FString> Parts;
+	RelativePath.ParseIntoArray(Parts, TEXT("/"));
+
+	// Chunked transform tracks: <actor>/transform/index.json and one file per window
+	if (Parts.Num() == 3 && Parts[1] == TEXT("transform") && Parts[2].EndsWith(TEXT(".json")))
+	{
+		OutActorName = Parts[0];
+		return true;
+	}
+	if (Parts.Num() != 2)
+	{
+		return false;
+	}
+
+	const FString& FileName = Parts[1];
+	if (FileName == TEXT("transform.json") || FileName == TEXT("animation.json") || FileName == TEXT("focal_length.json"))
+	{
+		OutActorName = Parts[0];
+		return true;
+	}
+	return false;
+}
+
+bool FAAANKPoseLiveApply::NeedsRebuild(const FString& RelativePath)
+{
+	const FString FileName = FPaths::GetCleanFilename(RelativePath);
+	// focus_distance.json and attach.json are applied by run_scene.py, so a live re-key cannot pick them up
+	return FileName == TEXT("meta.json") || FileName == TEXT("camera_cuts.json") || FileName == TEXT("settings.json")
+		|| FileName == TEXT("focus_distance.json") || FileName == TEXT("attach.json");
+}
+
+bool UAAANKPoseLiveApplyLibrary::WatchMovieFolder(const FString& MovieFolder, ULevelSequence* Sequence)
+{
+	return FAAANKPoseModule::Get().WatchMovieFolder(MovieFolder, Sequence);
+}
+
+bool UAAANKPoseLiveApplyLibrary::UnwatchMovieFolder(const FString& MovieFolder)
+{
+	return FAAANKPoseModule::Get().UnwatchMovieFolder(MovieFolder);
+}
+
+TArray<FString> UAAANKPoseLiveApplyLibrary::GetWatchedMovieFolders()
+{
+	return FAAANKPoseModule::Get().GetWatchedMovieFolders();
+}
+
+int32 UAAANKPoseLiveApplyLibrary::ApplyChangedActors(ULevelSequence* Sequence, const FString& MovieFolder, const TArray<FString>& ActorNames)
+{
+	return FAAANKPoseLiveApply::ApplyActorTracks(Sequence, MovieFolder, ActorNames);
+}
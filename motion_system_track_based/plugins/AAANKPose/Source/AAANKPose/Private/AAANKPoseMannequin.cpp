@@ -0,0 +1,70 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseMannequin.h"
+#include "Components/SceneComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+
+
+const FName AAAANKPoseMannequin::MotionSystemTag(TEXT("MotionSystemActor"));
+
+AAAANKPoseMannequin::AAAANKPoseMannequin(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryActorTick.bCanEverTick = false;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	SceneRoot = CreateDefaultSubobject<USceneComponent>(TEXT("SceneRoot"));
+	SceneRoot->SetMobility(EComponentMobility::Movable);
+	RootComponent = SceneRoot;
+
+	Mesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("Mesh"));
+	Mesh->SetupAttachment(SceneRoot);
+
+	// Sequencer drives the pose directly; nothing here needs physics, overlaps or an anim blueprint
+	Mesh->SetAnimationMode(EAnimationMode::AnimationSingleNode);
+	Mesh->VisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+	Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Mesh->SetGenerateOverlapEvents(false);
+	Mesh->CanCharacterStepUpOn = ECB_No;
+	Mesh->bSkipKinematicUpdateWhenInterpolating = true;
+	Mesh->bComponentUseFixedSkelBounds = true;
+
+	Tags.Add(MotionSystemTag);
+}
+
+void AAAANKPoseMannequin::SetupMannequin(USkeletalMesh* SkeletalMesh, FRotator MeshRotation, const TArray<FName>& ExtraTags)
+{
+	if (SkeletalMesh)
+	{
+		Mesh->SetSkeletalMeshAsset(SkeletalMesh);
+	}
+	Mesh->SetRelativeRotation(MeshRotation);
+
+	for (const FName& Tag : ExtraTags)
+	{
+		Tags.AddUnique(Tag);
+	}
+}
+
+USceneComponent* AAAANKPoseMannequin::AddSocketAnchor(FName SocketName)
+{
+	if (TObjectPtr<USceneComponent>* Existing = SocketAnchors.Find(SocketName))
+	{
+		return *Existing;
+	}
+
+	if (!Mesh->DoesSocketExist(SocketName))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("AddSocketAnchor: '%s' has no socket '%s'"), *GetName(), *SocketName.ToString());
+		return nullptr;
+	}
+
+	USceneComponent* Anchor = NewObject<USceneComponent>(this, *FString::Printf(TEXT("Anchor_%s"), *SocketName.ToString()));
+	Anchor->SetupAttachment(Mesh, SocketName);
+	Anchor->RegisterComponent();
+	AddInstanceComponent(Anchor);
+
+	SocketAnchors.Add(SocketName, Anchor);
+	return Anchor;
+}
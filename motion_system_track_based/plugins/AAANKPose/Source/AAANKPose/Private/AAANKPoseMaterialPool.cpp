@@ -0,0 +1,121 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseMaterialPool.h"
+#include "AAANKPoseSaveService.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Materials/MaterialInterface.h"
+#include "UObject/Package.h"
+
+#if WITH_EDITOR
+#include "AssetRegistry/AssetRegistryModule.h"
+#endif
+
+
+const TCHAR* FAAANKPoseMaterialPool::DefaultBaseMaterial = TEXT("/Engine/BasicShapes/BasicShapeMaterial.BasicShapeMaterial");
+const TCHAR* FAAANKPoseMaterialPool::PoolFolder = TEXT("/Game/AAANKPose/MaterialPool");
+
+namespace AAANKPoseMaterialPool
+{
+	/** "<base path>|<RRGGBBAA>" -> pooled material; weak, since saved instances can always be loaded again */
+	static TMap<FString, TWeakObjectPtr<UMaterialInterface>> Pool;
+
+	/** Same parameter names axis_markers used to try */
+	static const TCHAR* ColorParameters[] = { TEXT("Color"), TEXT("BaseColor"), TEXT("TintColor") };
+
+	static FName FindColorParameter(UMaterialInterface& Base)
+	{
+		for (const TCHAR* Name : ColorParameters)
+		{
+			FLinearColor Unused;
+			if (Base.GetVectorParameterValue(FHashedMaterialParameterInfo(Name), Unused))
+			{
+				return Name;
+			}
+		}
+		return NAME_None;
+	}
+
+#if WITH_EDITOR
+	/** Saved constant instance, loaded if an earlier session made it */
+	static UMaterialInterface* FindOrCreateConstant(UMaterialInterface& Base, FName Parameter, const FLinearColor& Color, const FString& Hex)
+	{
+		const FString AssetName = FString::Printf(TEXT("MI_%s_%s"), *Base.GetName(), *Hex);
+		const FString PackageName = FString(FAAANKPoseMaterialPool::PoolFolder) / AssetName;
+		if (UMaterialInstanceConstant* Existing = LoadObject<UMaterialInstanceConstant>(nullptr, *(PackageName + TEXT(".") + AssetName), nullptr, LOAD_NoWarn | LOAD_Quiet))
+		{
+			return Existing;
+		}
+
+		UPackage* Package = CreatePackage(*PackageName);
+		UMaterialInstanceConstant* Instance = NewObject<UMaterialInstanceConstant>(Package, *AssetName, RF_Public | RF_Standalone);
+		Instance->SetParentEditorOnly(&Base);
+		Instance->SetVectorParameterValueEditorOnly(FMaterialParameterInfo(Parameter), Color);
+		Instance->PostEditChange();
+		FAssetRegistryModule::AssetCreated(Instance);
+		Package->MarkPackageDirty();
+
+		// Once per color ever, so saving right away costs nothing and later runs just load it
+		UAAANKPoseSaveLibrary::SavePackagesBatched({ Package });
+		UE_LOG(LogTemp, Log, TEXT("GetColorMaterial: Created %s"), *PackageName);
+		return Instance;
+	}
+#endif
+}
+
+UMaterialInterface* FAAANKPoseMaterialPool::GetColorMaterial(const FLinearColor& Color, UMaterialInterface* BaseMaterial)
+{
+	using namespace AAANKPoseMaterialPool;
+
+	UMaterialInterface* Base = BaseMaterial ? BaseMaterial : LoadObject<UMaterialInterface>(nullptr, DefaultBaseMaterial);
+	if (!Base)
+	{
+		UE_LOG(LogTemp, Error, TEXT("GetColorMaterial: Base material '%s' not found"), DefaultBaseMaterial);
+		return nullptr;
+	}
+
+	// Quantized so colors that render the same share an instance
+	const FColor Quantized = Color.ToFColor(/*bSRGB*/ true);
+	const FString Hex = Quantized.ToHex();
+	const FString Key = Base->GetPathName() + TEXT("|") + Hex;
+	if (UMaterialInterface* Pooled = Pool.FindRef(Key).Get())
+	{
+		return Pooled;
+	}
+
+	const FName Parameter = FindColorParameter(*Base);
+	if (Parameter.IsNone())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("GetColorMaterial: %s has no color parameter; using it untinted"), *Base->GetName());
+		return Base;
+	}
+
+	const FLinearColor PooledColor = FLinearColor::FromSRGBColor(Quantized);
+	UMaterialInterface* Material = nullptr;
+#if WITH_EDITOR
+	Material = FindOrCreateConstant(*Base, Parameter, PooledColor, Hex);
+#else
+	UMaterialInstanceDynamic* Instance = UMaterialInstanceDynamic::Create(Base, GetTransientPackage());
+	Instance->SetVectorParameterValue(Parameter, PooledColor);
+	Instance->AddToRoot();
+	Material = Instance;
+#endif
+
+	Pool.Add(Key, Material);
+	return Material;
+}
+
+int32 FAAANKPoseMaterialPool::Num()
+{
+	return AAANKPoseMaterialPool::Pool.Num();
+}
+
+UMaterialInterface* UAAANKPoseMaterialPoolLibrary::GetColorMaterial(FLinearColor Color, UMaterialInterface* BaseMaterial)
+{
+	return FAAANKPoseMaterialPool::GetColorMaterial(Color, BaseMaterial);
+}
+
+int32 UAAANKPoseMaterialPoolLibrary::GetPooledMaterialCount()
+{
+	return FAAANKPoseMaterialPool::Num();
+}
@@ -0,0 +1,245 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPosePropertyBatch.h"
+#include "Components/ActorComponent.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UnrealType.h"
+
+
+namespace AAANKPosePropertyBatch
+{
+	/** Properties from the owner down to the leaf, or down to an object reference that Rest continues from */
+	struct FResolvedPath
+	{
+		TArray<FProperty*> Chain;
+		FString Rest;
+	};
+
+	/** (owner class or struct, path) -> chain; keyed weakly so a reinstanced class never hits a stale entry */
+	static TMap<TPair<FObjectKey, FString>, FResolvedPath> Cache;
+
+	/** One resolved write, grouped by the object that owns the leaf */
+	struct FPendingWrite
+	{
+		FProperty* Member = nullptr;
+		FProperty* Leaf = nullptr;
+		void* ValuePtr = nullptr;
+		const FAAANKPosePropertyWrite* Write = nullptr;
+	};
+
+	/** Python spells FocusSettings as focus_settings and bEnableLightShaftBloom as enable_light_shaft_bloom */
+	static FString NormalizeName(const FString& Name)
+	{
+		return Name.Replace(TEXT("_"), TEXT("")).ToLower();
+	}
+
+	static FProperty* FindMember(const UStruct& Owner, const FString& Segment)
+	{
+		if (FProperty* Exact = Owner.FindPropertyByName(FName(*Segment)))
+		{
+			return Exact;
+		}
+
+		const FString Wanted = NormalizeName(Segment);
+		for (TFieldIterator<FProperty> It(&Owner); It; ++It)
+		{
+			const FString Name = NormalizeName(It->GetName());
+			if (Name == Wanted || (It->IsA<FBoolProperty>() && Name.StartsWith(TEXT("b")) && Name.RightChop(1) == Wanted))
+			{
+				return *It;
+			}
+		}
+		return nullptr;
+	}
+
+	static const FResolvedPath* FindOrResolve(const UStruct& Owner, const FString& Path, FString& OutError)
+	{
+		const TPair<FObjectKey, FString> Key(FObjectKey(&Owner), Path);
+		if (const FResolvedPath* Cached = Cache.Find(Key))
+		{
+			return Cached;
+		}
+
+		FResolvedPath Resolved;
+		const UStruct* Struct = &Owner;
+		FString Remaining = Path;
+		while (true)
+		{
+			FString Head;
+			FString Tail;
+			if (!Remaining.Split(TEXT("."), &Head, &Tail))
+			{
+				Head = Remaining;
+			}
+
+			FProperty* Property = FindMember(*Struct, Head);
+			if (!Property)
+			{
+				OutError = FString::Printf(TEXT("%s has no property '%s'"), *Struct->GetName(), *Head);
+				return nullptr;
+			}
+			Resolved.Chain.Add(Property);
+			if (Tail.IsEmpty())
+			{
+				break;
+			}
+
+			if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+			{
+				Struct = StructProperty->Struct;
+				Remaining = Tail;
+			}
+			else if (Property->IsA<FObjectPropertyBase>())
+			{
+				// The referenced object's own class resolves the rest, so subclass properties are found
+				Resolved.Rest = Tail;
+				break;
+			}
+			else
+			{
+				OutError = FString::Printf(TEXT("'%s' is neither a struct nor an object reference"), *Head);
+				return nullptr;
+			}
+		}
+		return &Cache.Add(Key, MoveTemp(Resolved));
+	}
+
+	/** Follow Write.Path to the leaf value, crossing into referenced objects; OutTarget is the object that owns it */
+	static bool ResolveWrite(const FAAANKPosePropertyWrite& Write, UObject*& OutTarget, FPendingWrite& OutPending, FString& OutError)
+	{
+		UObject* Target = Write.Object;
+		FString Path = Write.Path;
+		while (true)
+		{
+			const FResolvedPath* Resolved = FindOrResolve(*Target->GetClass(), Path, OutError);
+			if (!Resolved)
+			{
+				return false;
+			}
+
+			void* Container = Target;
+			for (int32 Index = 0; Index < Resolved->Chain.Num() - 1; ++Index)
+			{
+				Container = Resolved->Chain[Index]->ContainerPtrToValuePtr<void>(Container);
+			}
+			FProperty* Leaf = Resolved->Chain.Last();
+			void* ValuePtr = Leaf->ContainerPtrToValuePtr<void>(Container);
+
+			if (Resolved->Rest.IsEmpty())
+			{
+				OutTarget = Target;
+				OutPending.Member = Resolved->Chain[0];
+				OutPending.Leaf = Leaf;
+				OutPending.ValuePtr = ValuePtr;
+				OutPending.Write = &Write;
+				return true;
+			}
+
+			UObject* Next = CastFieldChecked<FObjectPropertyBase>(Leaf)->GetObjectPropertyValue(ValuePtr);
+			if (!Next)
+			{
+				OutError = FString::Printf(TEXT("'%s' is null"), *Leaf->GetName());
+				return false;
+			}
+			Target = Next;
+			Path = Resolved->Rest;
+		}
+	}
+}
+
+FAAANKPosePropertyBatchResult FAAANKPosePropertyBatch::Apply(TConstArrayView<FAAANKPosePropertyWrite> Writes)
+{
+	using namespace AAANKPosePropertyBatch;
+
+	FAAANKPosePropertyBatchResult Result;
+	auto Fail = [&Result](const FAAANKPosePropertyWrite& Write, const FString& Reason)
+	{
+		++Result.Failed;
+		Result.Errors.Add(FString::Printf(TEXT("%s.%s: %s"), Write.Object ? *Write.Object->GetName() : TEXT("None"), *Write.Path, *Reason));
+	};
+
+	// Resolve everything first so each object is notified around all of its writes at once
+	TMap<UObject*, TArray<FPendingWrite>> ByObject;
+	for (const FAAANKPosePropertyWrite& Write : Writes)
+	{
+		if (!IsValid(Write.Object) || Write.Path.IsEmpty())
+		{
+			Fail(Write, TEXT("Needs an object and a path"));
+			continue;
+		}
+
+		UObject* Target = nullptr;
+		FPendingWrite Pending;
+		FString Error;
+		if (ResolveWrite(Write, Target, Pending, Error))
+		{
+			ByObject.FindOrAdd(Target).Add(Pending);
+		}
+		else
+		{
+			Fail(Write, Error);
+		}
+	}
+
+	for (TPair<UObject*, TArray<FPendingWrite>>& Entry : ByObject)
+	{
+		UObject* Object = Entry.Key;
+		const TArray<FPendingWrite>& Pending = Entry.Value;
+		// A single write gets a precise change event; several get the generic one
+		FProperty* ChangedMember = Pending.Num() == 1 ? Pending[0].Member : nullptr;
+
+		Object->Modify();
+#if WITH_EDITOR
+		Object->PreEditChange(ChangedMember);
+#endif
+
+		int32 Applied = 0;
+		for (const FPendingWrite& Write : Pending)
+		{
+			if (Write.Leaf->ImportText_Direct(*Write.Write->Value, Write.ValuePtr, Object, PPF_None))
+			{
+				++Applied;
+			}
+			else
+			{
+				Fail(*Write.Write, FString::Printf(TEXT("Could not parse '%s' as %s"), *Write.Write->Value, *Write.Leaf->GetCPPType()));
+			}
+		}
+		Result.Applied += Applied;
+
+#if WITH_EDITOR
+		if (ChangedMember)
+		{
+			FPropertyChangedEvent Event(Pending[0].Leaf, Applied > 0 ? EPropertyChangeType::ValueSet : EPropertyChangeType::Unspecified);
+			Event.SetActiveMemberProperty(ChangedMember);
+			Object->PostEditChangeProperty(Event);
+		}
+		else
+		{
+			Object->PostEditChange();
+		}
+#else
+		if (UActorComponent* Component = Cast<UActorComponent>(Object))
+		{
+			Component->MarkRenderStateDirty();
+		}
+#endif
+		++Result.ObjectsChanged;
+	}
+
+	for (const FString& Error : Result.Errors)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SetProperties: %s"), *Error);
+	}
+	return Result;
+}
+
+void FAAANKPosePropertyBatch::ResetCache()
+{
+	AAANKPosePropertyBatch::Cache.Reset();
+}
+
+FAAANKPosePropertyBatchResult UAAANKPosePropertyBatchLibrary::SetProperties(const TArray<FAAANKPosePropertyWrite>& Writes)
+{
+	return FAAANKPosePropertyBatch::Apply(Writes);
+}
@@ -0,0 +1,309 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseQueryTrace.h"
+#include "HAL/FileManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "PoseSearch/PoseSearchDatabase.h"
+
+
+namespace AAANKPoseQueryTrace
+{
+	/** "AQT1" */
+	static const uint32 Magic = 0x31545141;
+	static const uint32 Version = 1;
+
+	/** Record tags; strings are defined before the first query that refers to them */
+	static const uint8 StringRecord = 0;
+	static const uint8 QueryRecord = 1;
+
+	static const uint32 NoString = MAX_uint32;
+
+	static FCriticalSection Mutex;
+	static TUniquePtr<FArchive> Writer;
+	static TMap<FString, uint32> StringIds;
+	static int32 RecordedQueries = 0;
+
+	/** Id of Value in the open trace, writing its definition on first use */
+	static uint32 GetStringId(const FString& Value)
+	{
+		if (Value.IsEmpty())
+		{
+			return NoString;
+		}
+		if (const uint32* Id = StringIds.Find(Value))
+		{
+			return *Id;
+		}
+
+		uint32 Id = StringIds.Num();
+		StringIds.Add(Value, Id);
+		uint8 Tag = StringRecord;
+		FString Mutable = Value;
+		*Writer << Tag << Id << Mutable;
+		return Id;
+	}
+
+	static double Percentile(TArray<double> Values, double Fraction)
+	{
+		if (Values.Num() == 0)
+		{
+			return 0.0;
+		}
+		Values.Sort();
+		return Values[FMath::Clamp(FMath::CeilToInt(Fraction * Values.Num()) - 1, 0, Values.Num() - 1)];
+	}
+}
+
+bool FAAANKPoseQueryTrace::BeginRecording(const FString& FilePath)
+{
+	using namespace AAANKPoseQueryTrace;
+
+	FScopeLock Lock(&Mutex);
+	if (Writer.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("QueryTrace: Already recording; ignoring %s"), *FilePath);
+		return false;
+	}
+
+	IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), /*Tree*/ true);
+	Writer.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!Writer.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("QueryTrace: Could not create %s"), *FilePath);
+		return false;
+	}
+
+	uint32 HeaderMagic = Magic;
+	uint32 HeaderVersion = Version;
+	*Writer << HeaderMagic << HeaderVersion;
+	StringIds.Reset();
+	RecordedQueries = 0;
+
+	UE_LOG(LogTemp, Log, TEXT("QueryTrace: Recording to %s"), *FilePath);
+	return true;
+}
+
+int32 FAAANKPoseQueryTrace::EndRecording()
+{
+	using namespace AAANKPoseQueryTrace;
+
+	FScopeLock Lock(&Mutex);
+	if (!Writer.IsValid())
+	{
+		return 0;
+	}
+
+	Writer->Close();
+	Writer.Reset();
+	StringIds.Reset();
+	UE_LOG(LogTemp, Log, TEXT("QueryTrace: %d queries recorded"), RecordedQueries);
+	return RecordedQueries;
+}
+
+bool FAAANKPoseQueryTrace::IsRecording()
+{
+	FScopeLock Lock(&AAANKPoseQueryTrace::Mutex);
+	return AAANKPoseQueryTrace::Writer.IsValid();
+}
+
+void FAAANKPoseQueryTrace::Record(const FString& DatabasePath, EAAANKPoseSearchMode Mode, TConstArrayView<float> Query, const FAAANKPoseQueryResult& Result, double Seconds)
+{
+	using namespace AAANKPoseQueryTrace;
+
+	FScopeLock Lock(&Mutex);
+	if (!Writer.IsValid())
+	{
+		return;
+	}
+
+	uint32 DatabaseId = GetStringId(DatabasePath);
+	uint32 AssetId = GetStringId(Result.AssetPath);
+	uint8 Tag = QueryRecord;
+	uint8 ModeValue = static_cast<uint8>(Mode);
+	uint16 Dimension = static_cast<uint16>(Query.Num());
+	int32 Row = Result.Row;
+	float Time = Result.Time;
+	float Cost = Result.Cost;
+	float Microseconds = static_cast<float>(Seconds * 1.0e6);
+
+	*Writer << Tag << DatabaseId << ModeValue << Dimension;
+	Writer->Serialize(const_cast<float*>(Query.GetData()), Dimension * sizeof(float));
+	*Writer << Row << AssetId << Time << Cost << Microseconds;
+
+	// Queries are rare next to everything else a build does; flushing keeps the trace usable after a crash
+	Writer->Flush();
+	++RecordedQueries;
+}
+
+bool FAAANKPoseQueryTrace::Load(const FString& FilePath, TArray<FAAANKPoseTracedQuery>& OutQueries)
+{
+	using namespace AAANKPoseQueryTrace;
+
+	OutQueries.Reset();
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Reader.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("QueryTrace: Could not open %s"), *FilePath);
+		return false;
+	}
+
+	uint32 HeaderMagic = 0;
+	uint32 HeaderVersion = 0;
+	*Reader << HeaderMagic << HeaderVersion;
+	if (HeaderMagic != Magic || HeaderVersion != Version)
+	{
+		UE_LOG(LogTemp, Error, TEXT("QueryTrace: %s is not a version %u trace"), *FilePath, Version);
+		return false;
+	}
+
+	TArray<FString> Strings;
+	while (!Reader->AtEnd() && !Reader->IsError())
+	{
+		uint8 Tag = 0;
+		*Reader << Tag;
+		if (Tag == StringRecord)
+		{
+			uint32 Id = 0;
+			FString Value;
+			*Reader << Id << Value;
+			if (Id >= (uint32)Strings.Num())
+			{
+				Strings.SetNum(Id + 1);
+			}
+			Strings[Id] = MoveTemp(Value);
+		}
+		else if (Tag == QueryRecord)
+		{
+			uint32 DatabaseId = NoString;
+			uint8 ModeValue = 0;
+			uint16 Dimension = 0;
+			*Reader << DatabaseId << ModeValue << Dimension;
+
+			FAAANKPoseTracedQuery& Traced = OutQueries.AddDefaulted_GetRef();
+			Traced.DatabasePath = Strings.IsValidIndex(DatabaseId) ? Strings[DatabaseId] : FString();
+			Traced.Mode = static_cast<EAAANKPoseSearchMode>(ModeValue);
+			Traced.Query.SetNumUninitialized(Dimension);
+			Reader->Serialize(Traced.Query.GetData(), Dimension * sizeof(float));
+
+			uint32 AssetId = NoString;
+			*Reader << Traced.Result.Row << AssetId << Traced.Result.Time << Traced.Result.Cost << Traced.Microseconds;
+			Traced.Result.AssetPath = Strings.IsValidIndex(AssetId) ? Strings[AssetId] : FString();
+
+			// A trace cut off mid-record (editor crash) keeps everything before the torn record
+			if (Reader->IsError())
+			{
+				OutQueries.Pop();
+			}
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("QueryTrace: Unknown record %u in %s; stopping after %d queries"), Tag, *FilePath, OutQueries.Num());
+			break;
+		}
+	}
+	return true;
+}
+
+FString FAAANKPoseQueryTrace::GetTraceDirectory()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("AAANKPose"), TEXT("QueryTraces"));
+}
+
+FString UAAANKPoseQueryTraceLibrary::BeginQueryTrace(const FString& Label)
+{
+	const FString FileName = FString::Printf(TEXT("%s_%s.aqtrace"), *FPaths::MakeValidFileName(Label), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+	const FString FilePath = FPaths::Combine(FAAANKPoseQueryTrace::GetTraceDirectory(), FileName);
+	return FAAANKPoseQueryTrace::BeginRecording(FilePath) ? FilePath : FString();
+}
+
+int32 UAAANKPoseQueryTraceLibrary::EndQueryTrace()
+{
+	return FAAANKPoseQueryTrace::EndRecording();
+}
+
+bool UAAANKPoseQueryTraceLibrary::IsQueryTraceRecording()
+{
+	return FAAANKPoseQueryTrace::IsRecording();
+}
+
+FAAANKPoseReplayReport UAAANKPoseQueryTraceLibrary::ReplayQueryTrace(const FString& TracePath, UPoseSearchDatabase* Database, EAAANKPoseSearchMode Mode, int32 Repetitions)
+{
+	FAAANKPoseReplayReport Report;
+	Report.TracePath = TracePath;
+
+	TArray<FAAANKPoseTracedQuery> Queries;
+	if (!FAAANKPoseQueryTrace::Load(TracePath, Queries))
+	{
+		return Report;
+	}
+	Report.Queries = Queries.Num();
+	Repetitions = FMath::Max(Repetitions, 1);
+
+	// Indices are resolved once per database; GetCachedIndex builds each at most once per session
+	TMap<FString, const FAAANKPoseFeatureIndex*> Indices;
+	const FAAANKPoseFeatureIndex* OverrideIndex = Database ? UAAANKPoseFeatureIndexLibrary::GetCachedIndex(Database) : nullptr;
+
+	TArray<double> RecordedMicros;
+	TArray<double> ReplayMicros;
+	int32 Agreed = 0;
+	double CostDeltaSum = 0.0;
+	for (const FAAANKPoseTracedQuery& Traced : Queries)
+	{
+		const FAAANKPoseFeatureIndex* Index = OverrideIndex;
+		if (!Database)
+		{
+			if (const FAAANKPoseFeatureIndex** Found = Indices.Find(Traced.DatabasePath))
+			{
+				Index = *Found;
+			}
+			else
+			{
+				Index = UAAANKPoseFeatureIndexLibrary::GetCachedIndex(LoadObject<UPoseSearchDatabase>(nullptr, *Traced.DatabasePath));
+				Indices.Add(Traced.DatabasePath, Index);
+			}
+		}
+		if (!Index || Index->Dimension != Traced.Query.Num())
+		{
+			++Report.Skipped;
+			continue;
+		}
+
+		FAAANKPoseQueryResult Result;
+		double BestSeconds = TNumericLimits<double>::Max();
+		for (int32 Repetition = 0; Repetition < Repetitions; ++Repetition)
+		{
+			const double StartSeconds = FPlatformTime::Seconds();
+			Result = UAAANKPoseFeatureIndexLibrary::SearchIndex(*Index, Traced.Query, Mode);
+			BestSeconds = FMath::Min(BestSeconds, FPlatformTime::Seconds() - StartSeconds);
+		}
+
+		RecordedMicros.Add(Traced.Microseconds);
+		ReplayMicros.Add(BestSeconds * 1.0e6);
+		CostDeltaSum += Result.Cost - Traced.Result.Cost;
+
+		// Rows differ between databases, so agreement is judged on the clip and time they point at
+		const double SampleSeconds = 1.0 / FMath::Max(Index->SampleRate, 1);
+		if (Result.AssetPath == Traced.Result.AssetPath && FMath::Abs(Result.Time - Traced.Result.Time) <= SampleSeconds + UE_KINDA_SMALL_NUMBER)
+		{
+			++Agreed;
+		}
+	}
+
+	const int32 Replayed = ReplayMicros.Num();
+	if (Replayed > 0)
+	{
+		Report.Agreement = static_cast<double>(Agreed) / Replayed;
+		Report.MeanCostDelta = CostDeltaSum / Replayed;
+		Report.RecordedMedianMicroseconds = AAANKPoseQueryTrace::Percentile(RecordedMicros, 0.5);
+		Report.RecordedP99Microseconds = AAANKPoseQueryTrace::Percentile(RecordedMicros, 0.99);
+		Report.ReplayMedianMicroseconds = AAANKPoseQueryTrace::Percentile(ReplayMicros, 0.5);
+		Report.ReplayP99Microseconds = AAANKPoseQueryTrace::Percentile(ReplayMicros, 0.99);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ReplayQueryTrace: %d/%d queries replayed (%s), agreement %.1f%%, median %.1f us -> %.1f us, p99 %.1f us -> %.1f us"),
+		Replayed, Report.Queries, *UEnum::GetValueAsString(Mode), Report.Agreement * 100.0,
+		Report.RecordedMedianMicroseconds, Report.ReplayMedianMicroseconds, Report.RecordedP99Microseconds, Report.ReplayP99Microseconds);
+	return Report;
+}
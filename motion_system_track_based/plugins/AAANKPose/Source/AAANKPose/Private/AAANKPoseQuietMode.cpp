@@ -0,0 +1,172 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseQuietMode.h"
+#include "Engine/Engine.h"
+
+#if WITH_EDITOR
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Editor.h"
+#include "EditorViewportClient.h"
+#include "Engine/Selection.h"
+#include "GameFramework/Actor.h"
+#endif
+
+#define LOCTEXT_NAMESPACE "FAAANKPoseModule"
+
+
+namespace AAANKPoseQuietMode
+{
+	static int32 Depth = 0;
+
+	/** Tokens handed to Python by BeginQuietMode that have not been ended yet */
+	static TArray<int32> OpenTokens;
+	static int32 LastToken = 0;
+
+#if WITH_EDITOR
+	static bool bPreviousSquelchTransactions = false;
+	static bool bPreviousAssetRegistryCaching = false;
+	static TArray<TWeakObjectPtr<AActor>> PreviousSelection;
+
+	static FText GetOverrideName()
+	{
+		return LOCTEXT("QuietModeRealtimeOverride", "AAANKPose Quiet Build");
+	}
+
+	static void Suspend()
+	{
+		if (!GEditor)
+		{
+			return;
+		}
+
+		for (FEditorViewportClient* ViewportClient : GEditor->GetAllViewportClients())
+		{
+			ViewportClient->AddRealtimeOverride(false, GetOverrideName());
+		}
+
+		// Nothing selected means no details panel to rebuild on every PostEditChange; the selection comes back on resume
+		PreviousSelection.Reset();
+		for (FSelectionIterator It(GEditor->GetSelectedActorIterator()); It; ++It)
+		{
+			if (AActor* Actor = Cast<AActor>(*It))
+			{
+				PreviousSelection.Add(Actor);
+			}
+		}
+		GEditor->SelectNone(/*bNoteSelectionChange*/ true, /*bDeselectBSPSurfs*/ true);
+		GEditor->GetSelectedActors()->BeginBatchSelectOperation();
+		GEditor->GetSelectedComponents()->BeginBatchSelectOperation();
+
+		bPreviousSquelchTransactions = GEditor->bSquelchTransactionNotification;
+		GEditor->bSquelchTransactionNotification = true;
+
+		IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+		bPreviousAssetRegistryCaching = AssetRegistry.GetTemporaryCachingMode();
+		AssetRegistry.SetTemporaryCachingMode(true);
+	}
+
+	static void Resume()
+	{
+		if (!GEditor)
+		{
+			return;
+		}
+
+		IAssetRegistry::GetChecked().SetTemporaryCachingMode(bPreviousAssetRegistryCaching);
+		GEditor->bSquelchTransactionNotification = bPreviousSquelchTransactions;
+
+		GEditor->GetSelectedComponents()->EndBatchSelectOperation(/*bNotify*/ false);
+		GEditor->GetSelectedActors()->EndBatchSelectOperation(/*bNotify*/ false);
+
+		// Actors the build deleted meanwhile are simply not reselected
+		for (const TWeakObjectPtr<AActor>& Actor : PreviousSelection)
+		{
+			if (Actor.IsValid())
+			{
+				GEditor->SelectActor(Actor.Get(), /*bInSelected*/ true, /*bNotify*/ false);
+			}
+		}
+		PreviousSelection.Reset();
+
+		// Viewports may have been opened or closed meanwhile, so don't insist on finding the override
+		for (FEditorViewportClient* ViewportClient : GEditor->GetAllViewportClients())
+		{
+			ViewportClient->RemoveRealtimeOverride(GetOverrideName(), /*bCheckMissingOverride*/ false);
+		}
+
+		// One refresh for everything that happened while quiet
+		GEngine->BroadcastLevelActorListChanged();
+		GEditor->NoteSelectionChange();
+		GEditor->RedrawAllViewports(/*bInvalidateHitProxies*/ true);
+	}
+#endif
+}
+
+FAAANKPoseQuietScope::FAAANKPoseQuietScope()
+{
+	Enter();
+}
+
+FAAANKPoseQuietScope::~FAAANKPoseQuietScope()
+{
+	Exit();
+}
+
+void FAAANKPoseQuietScope::Enter()
+{
+	check(IsInGameThread());
+	if (AAANKPoseQuietMode::Depth++ == 0)
+	{
+#if WITH_EDITOR
+		AAANKPoseQuietMode::Suspend();
+#endif
+	}
+}
+
+void FAAANKPoseQuietScope::Exit()
+{
+	check(IsInGameThread());
+	if (AAANKPoseQuietMode::Depth == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("EndQuietMode called without a matching BeginQuietMode"));
+		return;
+	}
+	if (--AAANKPoseQuietMode::Depth == 0)
+	{
+#if WITH_EDITOR
+		AAANKPoseQuietMode::Resume();
+#endif
+	}
+}
+
+bool FAAANKPoseQuietScope::IsActive()
+{
+	return AAANKPoseQuietMode::Depth > 0;
+}
+
+int32 UAAANKPoseQuietModeLibrary::BeginQuietMode()
+{
+	FAAANKPoseQuietScope::Enter();
+	const int32 Token = ++AAANKPoseQuietMode::LastToken;
+	AAANKPoseQuietMode::OpenTokens.Add(Token);
+	return Token;
+}
+
+bool UAAANKPoseQuietModeLibrary::EndQuietMode(int32 Token)
+{
+	// A token ends its own scope once; a stale or repeated one must not pop a scope someone else opened
+	if (AAANKPoseQuietMode::OpenTokens.Remove(Token) == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("EndQuietMode: Token %d is not an open quiet scope"), Token);
+		return false;
+	}
+	FAAANKPoseQuietScope::Exit();
+	return true;
+}
+
+bool UAAANKPoseQuietModeLibrary::IsQuietModeActive()
+{
+	return FAAANKPoseQuietScope::IsActive();
+}
+
+#undef LOCTEXT_NAMESPACE
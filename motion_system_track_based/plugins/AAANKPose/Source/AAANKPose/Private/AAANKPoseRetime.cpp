@@ -0,0 +1,547 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseRetime.h"
+#include "AAANKPoseBuildCache.h"
+#include "AAANKPoseMath.h"
+#include "AAANKPoseShotPartition.h"
+#include "AAANKPoseTrackFolder.h"
+#include "Async/ParallelFor.h"
+#include "Channels/MovieSceneChannel.h"
+#include "Channels/MovieSceneChannelProxy.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "HAL/FileManager.h"
+#include "LevelSequence.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "MovieScene.h"
+#include "Sections/MovieSceneSkeletalAnimationSection.h"
+#include "Sections/MovieSceneSubSection.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+
+namespace AAANKPoseRetime
+{
+	/** Location then rotation, as interleaved channels for ResampleLinear */
+	static constexpr int32 TransformChannels = 6;
+
+	/** Source frame rate and warp of one retime, shared read-only by the actor jobs */
+	struct FRetimeContext
+	{
+		AAANKPoseMath::FTimeWarp Warp;
+		int32 SourceFps = 60;
+		int32 TargetFps = 60;
+
+		double ToOutputSeconds(double SourceFrame) const
+		{
+			return Warp.ToOutput(SourceFrame / SourceFps);
+		}
+
+		int32 ToOutputFrame(double SourceFrame) const
+		{
+			return FMath::RoundToInt32(ToOutputSeconds(SourceFrame) * TargetFps);
+		}
+	};
+
+	static TSharedPtr<FJsonValue> LoadJson(const FString& FilePath)
+	{
+		FString Contents;
+		TSharedPtr<FJsonValue> Root;
+		if (!FFileHelper::LoadFileToString(Contents, *FilePath))
+		{
+			return nullptr;
+		}
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Contents);
+		if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Retime: Failed to parse JSON file '%s'"), *FilePath);
+			return nullptr;
+		}
+		return Root;
+	}
+
+	static bool SaveJson(const FString& FilePath, const TSharedPtr<FJsonValue>& Root)
+	{
+		FString Output;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+		if (!FJsonSerializer::Serialize(Root, FString(), Writer) || !FFileHelper::SaveStringToFile(Output, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Retime: Failed to write '%s'"), *FilePath);
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Moves every frame field (frame, start_frame, end_frame) and seconds field (time, start_time, end_time)
+	 * through the warp, at any depth. With bDurations, "duration" fields are spans from the start of the movie.
+	 * Null fields (open-ended attachments) are left alone.
+	 */
+	static void RemapFields(const TSharedPtr<FJsonValue>& Value, const FRetimeContext& Context, bool bDurations)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Array = nullptr;
+		const TSharedPtr<FJsonObject>* Object = nullptr;
+		if (Value->TryGetArray(Array))
+		{
+			for (const TSharedPtr<FJsonValue>& Element : *Array)
+			{
+				RemapFields(Element, Context, bDurations);
+			}
+			return;
+		}
+		if (!Value->TryGetObject(Object))
+		{
+			return;
+		}
+
+		for (TPair<FString, TSharedPtr<FJsonValue>>& Field : (*Object)->Values)
+		{
+			double Number = 0.0;
+			if (!Field.Value->TryGetNumber(Number))
+			{
+				RemapFields(Field.Value, Context, bDurations);
+			}
+			else if (Field.Key == TEXT("frame") || Field.Key == TEXT("start_frame") || Field.Key == TEXT("end_frame"))
+			{
+				Field.Value = MakeShared<FJsonValueNumber>(Context.ToOutputFrame(Number));
+			}
+			else if (Field.Key == TEXT("time") || Field.Key == TEXT("start_time") || Field.Key == TEXT("end_time"))
+			{
+				Field.Value = MakeShared<FJsonValueNumber>(Context.Warp.ToOutput(Number));
+			}
+			else if (bDurations && Field.Key == TEXT("duration"))
+			{
+				Field.Value = MakeShared<FJsonValueNumber>(Context.Warp.ToOutput(Number) - Context.Warp.ToOutput(0.0));
+			}
+		}
+	}
+
+	/** Play rates follow the warp over each section's span, measured before the frames move */
+	static void ScaleAnimationSpeeds(const TSharedPtr<FJsonValue>& Root, const FRetimeContext& Context)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+		if (!Root->TryGetArray(Entries))
+		{
+			return;
+		}
+
+		for (const TSharedPtr<FJsonValue>& Entry : *Entries)
+		{
+			const TSharedPtr<FJsonObject>* Object = nullptr;
+			if (!Entry->TryGetObject(Object))
+			{
+				continue;
+			}
+
+			double StartFrame = 0.0;
+			(*Object)->TryGetNumberField(TEXT("start_frame"), StartFrame);
+			double EndFrame = StartFrame;
+			(*Object)->TryGetNumberField(TEXT("end_frame"), EndFrame);
+
+			// Open-ended sections play at the rate where they start
+			const double OutputStart = Context.ToOutputSeconds(StartFrame);
+			const double OutputEnd = EndFrame > StartFrame ? Context.ToOutputSeconds(EndFrame) : OutputStart + 1.0 / Context.TargetFps;
+			const double Rate = Context.Warp.Rate(OutputStart, OutputEnd);
+
+			// Same precedence as LoadAnimationSections; the result is always written as speed_multiplier
+			double Speed = 1.0;
+			if (!(*Object)->TryGetNumberField(TEXT("speed_multiplier"), Speed))
+			{
+				(*Object)->TryGetNumberField(TEXT("speed"), Speed);
+			}
+			(*Object)->RemoveField(TEXT("speed"));
+			(*Object)->SetNumberField(TEXT("speed_multiplier"), Speed * Rate);
+		}
+	}
+
+	/**
+	 * Per-frame tracks are resampled at every output frame they span; anything sparser keeps its keys at their
+	 * new frames, which also keeps a camera placed by a single key from growing a key per frame.
+	 */
+	static bool RetimeTransform(const FString& ActorFolder, const FRetimeContext& Context, int32& OutKeys)
+	{
+		TArray<FAAANKPoseTransformKey> Keys;
+		if (!FAAANKPoseTrackFolder::LoadTransformKeys(ActorFolder, Keys) || Keys.Num() == 0)
+		{
+			return true;
+		}
+		FAAANKPoseTrackChunkIndex Index;
+		const bool bChunked = FAAANKPoseTrackFolder::LoadTransformIndex(ActorFolder, Index);
+
+		TArray<FAAANKPoseTransformKey> NewKeys;
+		const int32 Span = Keys.Last().Frame - Keys[0].Frame;
+		const bool bDense = Keys.Num() >= 2 && Span <= 2 * (Keys.Num() - 1);
+		if (bDense)
+		{
+			const int32 FirstFrame = Context.ToOutputFrame(Keys[0].Frame);
+			const int32 NumFrames = Context.ToOutputFrame(Keys.Last().Frame) - FirstFrame + 1;
+
+			TArray<double> KeyFrames;
+			TArray<double> Values;
+			KeyFrames.SetNumUninitialized(Keys.Num());
+			Values.SetNumUninitialized(Keys.Num() * TransformChannels);
+			for (int32 KeyIndex = 0; KeyIndex < Keys.Num(); ++KeyIndex)
+			{
+				const FAAANKPoseTransformKey& Key = Keys[KeyIndex];
+				double* Row = &Values[KeyIndex * TransformChannels];
+				KeyFrames[KeyIndex] = Key.Frame;
+				Row[0] = Key.Location.X;
+				Row[1] = Key.Location.Y;
+				Row[2] = Key.Location.Z;
+				Row[3] = Key.Rotation.Pitch;
+				Row[4] = Key.Rotation.Yaw;
+				Row[5] = Key.Rotation.Roll;
+				// Unwind against the previous key so a step across +-180 interpolates the short way instead of spinning
+				if (KeyIndex > 0)
+				{
+					const double* PrevRow = Row - TransformChannels;
+					for (int32 Channel = 3; Channel < TransformChannels; ++Channel)
+					{
+						Row[Channel] = PrevRow[Channel] + FMath::UnwindDegrees(Row[Channel] - PrevRow[Channel]);
+					}
+				}
+			}
+
+			// Output frame -> source frame for the whole span, then one resample of all six channels
+			TArray<double> SampleFrames;
+			SampleFrames.SetNumUninitialized(NumFrames);
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				SampleFrames[Frame] = static_cast<double>(FirstFrame + Frame) / Context.TargetFps;
+			}
+			Context.Warp.ToSource(SampleFrames, SampleFrames);
+			for (double& Sample : SampleFrames)
+			{
+				Sample *= Context.SourceFps;
+			}
+
+			TArray<double> Resampled;
+			Resampled.SetNumUninitialized(NumFrames * TransformChannels);
+			AAANKPoseMath::ResampleLinear(KeyFrames, Values, TransformChannels, SampleFrames, Resampled);
+
+			NewKeys.SetNum(NumFrames);
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				const double* Row = &Resampled[Frame * TransformChannels];
+				NewKeys[Frame].Frame = FirstFrame + Frame;
+				NewKeys[Frame].Location = FVector(Row[0], Row[1], Row[2]);
+				NewKeys[Frame].Rotation = FRotator(Row[3], Row[4], Row[5]);
+			}
+		}
+		else
+		{
+			NewKeys.Reserve(Keys.Num());
+			for (const FAAANKPoseTransformKey& Key : Keys)
+			{
+				// Keys that land on the same output frame collapse to the later one
+				const int32 Frame = Context.ToOutputFrame(Key.Frame);
+				if (NewKeys.Num() > 0 && NewKeys.Last().Frame == Frame)
+				{
+					NewKeys.Pop(EAllowShrinking::No);
+				}
+				FAAANKPoseTransformKey& NewKey = NewKeys.Add_GetRef(Key);
+				NewKey.Frame = Frame;
+			}
+		}
+
+		OutKeys = NewKeys.Num();
+		if (bChunked)
+		{
+			// Windows keep their length in seconds
+			const int32 WindowFrames = FMath::Max(FMath::RoundToInt32(static_cast<double>(Index.WindowFrames) * Context.TargetFps / Context.SourceFps), 1);
+			return FAAANKPoseTrackFolder::SaveTransformChunks(ActorFolder, NewKeys, WindowFrames);
+		}
+		return FAAANKPoseTrackFolder::SaveTransformKeys(ActorFolder, NewKeys);
+	}
+
+	/** Transform track, the plan a root motion bake kept aside, and every other track file in the actor's folder */
+	static bool RetimeActor(const FString& ActorFolder, const FRetimeContext& Context, int32& OutKeys)
+	{
+		bool bSucceeded = RetimeTransform(ActorFolder, Context, OutKeys);
+
+		// The next bake starts from planned/ when it is there, so it has to move to the new frames too
+		int32 PlannedKeys = 0;
+		bSucceeded &= RetimeTransform(FPaths::Combine(ActorFolder, TEXT("planned")), Context, PlannedKeys);
+
+		TArray<FString> Files;
+		IFileManager::Get().FindFiles(Files, *FPaths::Combine(ActorFolder, TEXT("*.json")), /*Files*/ true, /*Directories*/ false);
+		for (const FString& File : Files)
+		{
+			if (File == TEXT("transform.json"))
+			{
+				continue;
+			}
+
+			const FString FilePath = FPaths::Combine(ActorFolder, File);
+			TSharedPtr<FJsonValue> Root = LoadJson(FilePath);
+			if (!Root.IsValid())
+			{
+				bSucceeded = false;
+				continue;
+			}
+			if (File == TEXT("animation.json"))
+			{
+				ScaleAnimationSpeeds(Root, Context);
+			}
+			RemapFields(Root, Context, /*bDurations*/ false);
+			bSucceeded &= SaveJson(FilePath, Root);
+		}
+		return bSucceeded;
+	}
+
+	/** Track files are small; a straight copy keeps the retime itself in-place only */
+	static bool CopyFolder(const FString& From, const FString& To)
+	{
+		IFileManager& FileManager = IFileManager::Get();
+		FileManager.DeleteDirectory(*To, false, true);
+
+		TArray<FString> Files;
+		FileManager.FindFilesRecursive(Files, *From, TEXT("*"), /*Files*/ true, /*Directories*/ false);
+		const FString Root = FPaths::ConvertRelativePathToFull(From) / TEXT("");
+		for (const FString& File : Files)
+		{
+			const FString FullPath = FPaths::ConvertRelativePathToFull(File);
+			const FString Target = FPaths::Combine(To, FullPath.RightChop(Root.Len()));
+			if (FileManager.Copy(*Target, *FullPath) != COPY_OK)
+			{
+				UE_LOG(LogTemp, Error, TEXT("Retime: Failed to copy '%s' to '%s'"), *FullPath, *Target);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** Sequence plus every subsequence below it, each once */
+	static void GatherSequences(UMovieSceneSequence* Sequence, TArray<UMovieSceneSequence*>& OutSequences)
+	{
+		if (!Sequence || !Sequence->GetMovieScene() || OutSequences.Contains(Sequence))
+		{
+			return;
+		}
+		OutSequences.Add(Sequence);
+		for (UMovieSceneSection* Section : Sequence->GetMovieScene()->GetAllSections())
+		{
+			if (UMovieSceneSubSection* SubSection = Cast<UMovieSceneSubSection>(Section))
+			{
+				GatherSequences(SubSection->GetSequence(), OutSequences);
+			}
+		}
+	}
+
+	static TRange<FFrameNumber> RemapRange(const TRange<FFrameNumber>& Range, TFunctionRef<FFrameNumber(FFrameNumber)> Remap)
+	{
+		TRange<FFrameNumber> Result = Range;
+		if (Range.GetLowerBound().IsClosed())
+		{
+			Result.SetLowerBoundValue(Remap(Range.GetLowerBoundValue()));
+		}
+		if (Range.GetUpperBound().IsClosed())
+		{
+			Result.SetUpperBoundValue(Remap(Range.GetUpperBoundValue()));
+		}
+		return Result;
+	}
+}
+
+FAAANKPoseRetimeResult FAAANKPoseRetime::RetimeTrackFolder(const FString& MovieFolder, const FString& OutputFolder, const FAAANKPoseRetimeSettings& Settings)
+{
+	using namespace AAANKPoseRetime;
+
+	FAAANKPoseRetimeResult Result;
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	FRetimeContext Context;
+	Context.Warp.Points = Settings.WarpCurve;
+	Context.Warp.Speed = Settings.Speed;
+	if (!Context.Warp.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("RetimeTrackFolder: Speed must be positive and the warp curve needs two or more strictly increasing points"));
+		return Result;
+	}
+
+	FAAANKPoseMovieMeta Meta;
+	const FString MetaPath = FPaths::Combine(MovieFolder, TEXT("meta.json"));
+	TSharedPtr<FJsonValue> MetaRoot = LoadJson(MetaPath);
+	const TSharedPtr<FJsonObject>* MetaObject = nullptr;
+	if (!FAAANKPoseTrackFolder::LoadMeta(MovieFolder, Meta) || !MetaRoot.IsValid() || !MetaRoot->TryGetObject(MetaObject))
+	{
+		return Result;
+	}
+
+	FString Folder = MovieFolder;
+	if (!OutputFolder.IsEmpty() && !FPaths::IsSamePath(OutputFolder, MovieFolder))
+	{
+		if (!CopyFolder(MovieFolder, OutputFolder))
+		{
+			return Result;
+		}
+		Folder = OutputFolder;
+		(*MetaObject)->SetStringField(TEXT("name"), FPaths::GetPathLeaf(OutputFolder));
+	}
+
+	Context.SourceFps = FMath::Max(Meta.Fps, 1);
+	Context.TargetFps = Settings.TargetFps > 0 ? Settings.TargetFps : Context.SourceFps;
+	Result.SourceFps = Context.SourceFps;
+	Result.TargetFps = Context.TargetFps;
+
+	double SourceDuration = 0.0;
+	(*MetaObject)->TryGetNumberField(TEXT("duration"), SourceDuration);
+	Result.SourceDuration = static_cast<float>(SourceDuration);
+	Result.Duration = static_cast<float>(Context.Warp.ToOutput(SourceDuration) - Context.Warp.ToOutput(0.0));
+	(*MetaObject)->SetNumberField(TEXT("fps"), Context.TargetFps);
+	(*MetaObject)->SetNumberField(TEXT("duration"), Result.Duration);
+	bool bSucceeded = SaveJson(FPaths::Combine(Folder, TEXT("meta.json")), MetaRoot);
+
+	// Actors are independent: one job each, all sharing the context
+	TArray<int32> ActorKeys;
+	TArray<bool> ActorSucceeded;
+	ActorKeys.SetNumZeroed(Meta.Actors.Num());
+	ActorSucceeded.SetNumZeroed(Meta.Actors.Num());
+	ParallelFor(Meta.Actors.Num(), [&](int32 ActorIndex)
+	{
+		ActorSucceeded[ActorIndex] = RetimeActor(FPaths::Combine(Folder, Meta.Actors[ActorIndex]), Context, ActorKeys[ActorIndex]);
+	});
+	for (int32 ActorIndex = 0; ActorIndex < Meta.Actors.Num(); ++ActorIndex)
+	{
+		bSucceeded &= ActorSucceeded[ActorIndex];
+		Result.Keys += ActorKeys[ActorIndex];
+	}
+	Result.Retimed = Meta.Actors.Num();
+
+	// Movie-level tracks: cuts and audio are in seconds; scene commands also carry durations
+	for (const TCHAR* File : { TEXT("camera_cuts.json"), TEXT("audio.json"), TEXT("scene.json") })
+	{
+		const FString FilePath = FPaths::Combine(Folder, File);
+		if (!FPaths::FileExists(FilePath))
+		{
+			continue;
+		}
+		TSharedPtr<FJsonValue> Root = LoadJson(FilePath);
+		if (!Root.IsValid())
+		{
+			bSucceeded = false;
+			continue;
+		}
+		RemapFields(Root, Context, /*bDurations*/ FCString::Strcmp(File, TEXT("scene.json")) == 0);
+		bSucceeded &= SaveJson(FilePath, Root);
+	}
+
+	Result.bSucceeded = bSucceeded;
+	Result.Seconds = static_cast<float>(FPlatformTime::Seconds() - StartSeconds);
+	UE_LOG(LogTemp, Log, TEXT("RetimeTrackFolder: %s %d fps %.2f s -> %s %d fps %.2f s, %d actor(s), %d transform key(s) in %.1f ms"),
+		*MovieFolder, Result.SourceFps, Result.SourceDuration, *Folder, Result.TargetFps, Result.Duration, Result.Retimed, Result.Keys, Result.Seconds * 1000.0f);
+	return Result;
+}
+
+FAAANKPoseRetimeResult FAAANKPoseRetime::RetimeSequence(ULevelSequence* Sequence, const FAAANKPoseRetimeSettings& Settings)
+{
+	using namespace AAANKPoseRetime;
+
+	FAAANKPoseRetimeResult Result;
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	AAANKPoseMath::FTimeWarp Warp;
+	Warp.Points = Settings.WarpCurve;
+	Warp.Speed = Settings.Speed;
+	if (!Sequence || !Sequence->GetMovieScene() || !Warp.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("RetimeSequence: Needs a sequence, a positive speed and a strictly increasing warp curve"));
+		return Result;
+	}
+
+	UMovieScene* RootScene = Sequence->GetMovieScene();
+	const FFrameRate SourceRate = RootScene->GetDisplayRate();
+	Result.SourceFps = FMath::RoundToInt32(SourceRate.AsDecimal());
+	Result.TargetFps = Settings.TargetFps > 0 ? Settings.TargetFps : Result.SourceFps;
+	const TRange<FFrameNumber> RootRange = RootScene->GetPlaybackRange();
+	const double RootStart = RootScene->GetTickResolution().AsSeconds(UE::MovieScene::DiscreteInclusiveLower(RootRange));
+	const double RootEnd = RootScene->GetTickResolution().AsSeconds(UE::MovieScene::DiscreteExclusiveUpper(RootRange));
+	Result.SourceDuration = static_cast<float>(RootEnd - RootStart);
+	Result.Duration = static_cast<float>(Warp.ToOutput(RootEnd) - Warp.ToOutput(RootStart));
+
+	// Shots keep the master's frame numbers, so one warp in seconds is right at every level
+	TArray<UMovieSceneSequence*> Sequences;
+	GatherSequences(Sequence, Sequences);
+
+	TArray<FFrameNumber> Times;
+	TArray<FKeyHandle> Handles;
+	for (UMovieSceneSequence* Each : Sequences)
+	{
+		UMovieScene* MovieScene = Each->GetMovieScene();
+		MovieScene->Modify();
+		const FFrameRate TickResolution = MovieScene->GetTickResolution();
+		auto Remap = [&Warp, TickResolution](FFrameNumber Tick)
+		{
+			return (Warp.ToOutput(TickResolution.AsSeconds(Tick)) * TickResolution).RoundToFrame();
+		};
+
+		for (UMovieSceneSection* Section : MovieScene->GetAllSections())
+		{
+			Section->Modify();
+			const TRange<FFrameNumber> Range = Section->GetRange();
+
+			if (UMovieSceneSkeletalAnimationSection* AnimSection = Cast<UMovieSceneSkeletalAnimationSection>(Section))
+			{
+				const double Start = TickResolution.AsSeconds(Range.HasLowerBound() ? Range.GetLowerBoundValue() : FFrameNumber(0));
+				const double End = Range.HasUpperBound() ? TickResolution.AsSeconds(Range.GetUpperBoundValue()) : Start + 1.0 / Result.TargetFps;
+				const double OutputStart = Warp.ToOutput(Start);
+				AnimSection->Params.PlayRate *= Warp.Rate(OutputStart, FMath::Max(Warp.ToOutput(End), OutputStart + 1.0 / Result.TargetFps));
+			}
+
+			for (const FMovieSceneChannelEntry& Entry : Section->GetChannelProxy().GetAllEntries())
+			{
+				for (FMovieSceneChannel* Channel : Entry.GetChannels())
+				{
+					Times.Reset();
+					Handles.Reset();
+					Channel->GetKeys(TRange<FFrameNumber>::All(), &Times, &Handles);
+					for (FFrameNumber& Time : Times)
+					{
+						Time = Remap(Time);
+					}
+					Channel->SetKeyTimes(Handles, Times);
+					Result.Keys += Times.Num();
+				}
+			}
+
+			Section->SetRange(RemapRange(Range, Remap));
+			++Result.Retimed;
+		}
+
+		MovieScene->SetPlaybackRange(RemapRange(MovieScene->GetPlaybackRange(), Remap));
+		MovieScene->SetDisplayRate(FFrameRate(Result.TargetFps, 1));
+		MovieScene->MarkAsChanged();
+
+		// The content no longer matches what the stamps describe; a rebuild must not reuse it
+		if (ULevelSequence* LevelSequence = Cast<ULevelSequence>(Each))
+		{
+			if (UAAANKPoseShotMetaData* ShotMeta = LevelSequence->FindMetaData<UAAANKPoseShotMetaData>())
+			{
+				ShotMeta->ContentHash.Empty();
+			}
+			if (UAAANKPoseBuildCacheMetaData* CacheMeta = LevelSequence->FindMetaData<UAAANKPoseBuildCacheMetaData>())
+			{
+				CacheMeta->Fingerprint.Empty();
+			}
+			LevelSequence->MarkPackageDirty();
+		}
+	}
+
+	Result.bSucceeded = true;
+	Result.Seconds = static_cast<float>(FPlatformTime::Seconds() - StartSeconds);
+	UE_LOG(LogTemp, Log, TEXT("RetimeSequence: %s %d fps %.2f s -> %d fps %.2f s, %d section(s), %d key(s) in %.1f ms"),
+		*Sequence->GetName(), Result.SourceFps, Result.SourceDuration, Result.TargetFps, Result.Duration, Result.Retimed, Result.Keys, Result.Seconds * 1000.0f);
+	return Result;
+}
+
+FAAANKPoseRetimeResult UAAANKPoseRetimeLibrary::RetimeTrackFolder(const FString& MovieFolder, const FString& OutputFolder, const FAAANKPoseRetimeSettings& Settings)
+{
+	return FAAANKPoseRetime::RetimeTrackFolder(MovieFolder, OutputFolder, Settings);
+}
+
+FAAANKPoseRetimeResult UAAANKPoseRetimeLibrary::RetimeSequence(ULevelSequence* Sequence, const FAAANKPoseRetimeSettings& Settings)
+{
+	return FAAANKPoseRetime::RetimeSequence(Sequence, Settings);
+}
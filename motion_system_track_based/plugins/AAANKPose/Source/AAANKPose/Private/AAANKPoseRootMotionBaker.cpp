@@ -0,0 +1,190 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseRootMotionBaker.h"
+#include "AAANKPoseTrackFolder.h"
+#include "Animation/AnimSequence.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+
+namespace AAANKPoseRootMotionBaker
+{
+	/** The planned track is kept here on the first bake, so re-baking starts from the plan rather than the last bake */
+	static const TCHAR* PlannedFolderName = TEXT("planned");
+
+	/**
+	 * Folder holding the planned transform track, copied out of the actor folder (in the same layout) the first time
+	 * @return Empty if the actor has no transform track
+	 */
+	static FString PreservePlannedTrack(const FString& ActorFolder)
+	{
+		const FString PlannedFolder = FPaths::Combine(ActorFolder, PlannedFolderName);
+		if (FAAANKPoseTransformReader(PlannedFolder).IsValid())
+		{
+			return PlannedFolder;
+		}
+
+		TArray<FAAANKPoseTransformKey> Keys;
+		if (!FAAANKPoseTrackFolder::LoadTransformKeys(ActorFolder, Keys) || Keys.Num() == 0)
+		{
+			return FString();
+		}
+
+		IFileManager::Get().MakeDirectory(*PlannedFolder, true);
+		FAAANKPoseTrackChunkIndex Index;
+		const bool bSaved = FAAANKPoseTrackFolder::LoadTransformIndex(ActorFolder, Index)
+			? FAAANKPoseTrackFolder::SaveTransformChunks(PlannedFolder, Keys, Index.WindowFrames)
+			: FAAANKPoseTrackFolder::SaveTransformKeys(PlannedFolder, Keys);
+		return bSaved ? PlannedFolder : FString();
+	}
+
+	/** Root motion between two times of a section that loops the asset, as Sequencer plays it */
+	static FTransform ExtractLoopedRootMotion(const UAnimSequence* Anim, double StartTime, double EndTime)
+	{
+		const double Length = Anim->GetPlayLength();
+		if (Length <= UE_KINDA_SMALL_NUMBER || EndTime <= StartTime)
+		{
+			return FTransform::Identity;
+		}
+
+		const FAnimExtractContext Context;
+		FTransform Accumulated = FTransform::Identity;
+		double Cursor = FMath::Fmod(StartTime, Length);
+		double Remaining = EndTime - StartTime;
+
+		while (Remaining > UE_KINDA_SMALL_NUMBER)
+		{
+			const double Step = FMath::Min(Remaining, Length - Cursor);
+			// Same accumulation order as FRootMotionMovementParams::Accumulate
+			Accumulated = Anim->ExtractRootMotionFromRange(Cursor, Cursor + Step, Context) * Accumulated;
+			Remaining -= Step;
+			Cursor = 0.0;
+		}
+		return Accumulated;
+	}
+
+	static const FAAANKPoseAnimationSection* FindActiveSection(const TArray<FAAANKPoseAnimationSection>& Sections, int32 Frame)
+	{
+		// Later sections win on overlap, matching the order keyframe_applier adds them
+		for (int32 Index = Sections.Num() - 1; Index >= 0; --Index)
+		{
+			if (Sections[Index].StartFrame <= Frame && Frame < Sections[Index].EndFrame)
+			{
+				return &Sections[Index];
+			}
+		}
+		return nullptr;
+	}
+}
+
+int32 UAAANKPoseRootMotionBakerLibrary::BakeRootMotionTracks(const FString& MovieFolder, float MeshYawOffset, int32 KeyInterval)
+{
+	using namespace AAANKPoseRootMotionBaker;
+
+	FAAANKPoseMovieMeta Meta;
+	if (!FAAANKPoseTrackFolder::LoadMeta(MovieFolder, Meta))
+	{
+		return 0;
+	}
+
+	const double Fps = FMath::Max(Meta.Fps, 1);
+	KeyInterval = FMath::Max(KeyInterval, 1);
+
+	// One load per asset for the whole movie
+	TMap<FString, UAnimSequence*> AnimCache;
+	int32 BakedCount = 0;
+
+	for (const FString& ActorName : Meta.Actors)
+	{
+		const FString ActorFolder = FPaths::Combine(MovieFolder, ActorName);
+
+		TArray<FAAANKPoseAnimationSection> Sections;
+		if (!FAAANKPoseTrackFolder::LoadAnimationSections(ActorFolder, Sections) || Sections.Num() == 0)
+		{
+			continue;
+		}
+		// Frames are walked in order, so a chunked plan is read one window at a time
+		const FString PlannedFolder = PreservePlannedTrack(ActorFolder);
+		FAAANKPoseTransformReader PlannedPath(PlannedFolder);
+		if (PlannedFolder.IsEmpty() || !PlannedPath.IsValid())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("BakeRootMotionTracks: '%s' has animations but no transform track to take a heading from"), *ActorName);
+			continue;
+		}
+
+		for (const FAAANKPoseAnimationSection& Section : Sections)
+		{
+			if (!AnimCache.Contains(Section.Name))
+			{
+				const FString AnimPath = FAAANKPoseTrackFolder::ResolveAnimationPath(Section.Name);
+				UAnimSequence* Anim = LoadObject<UAnimSequence>(nullptr, *AnimPath);
+				if (!Anim)
+				{
+					UE_LOG(LogTemp, Warning, TEXT("BakeRootMotionTracks: Animation '%s' not found at %s"), *Section.Name, *AnimPath);
+				}
+				AnimCache.Add(Section.Name, Anim);
+			}
+		}
+
+		// Nothing drives the actor after the last section, so the bake ends there
+		const int32 FirstFrame = FMath::Min(PlannedPath.GetFirstFrame(), Sections[0].StartFrame);
+		int32 LastFrame = Sections[0].EndFrame;
+		for (const FAAANKPoseAnimationSection& Section : Sections)
+		{
+			LastFrame = FMath::Max(LastFrame, Section.EndFrame);
+		}
+
+		TArray<FAAANKPoseTransformKey> BakedKeys;
+		BakedKeys.Reserve((LastFrame - FirstFrame) / KeyInterval + 2);
+
+		FVector Position = PlannedPath.Sample(FirstFrame).Location;
+		double MaxDeviation = 0.0;
+
+		for (int32 Frame = FirstFrame; Frame <= LastFrame; ++Frame)
+		{
+			const FAAANKPoseTransformKey Planned = PlannedPath.Sample(Frame);
+			Position.Z = Planned.Location.Z;
+			MaxDeviation = FMath::Max(MaxDeviation, FVector::Dist2D(Position, Planned.Location));
+
+			if ((Frame - FirstFrame) % KeyInterval == 0 || Frame == LastFrame)
+			{
+				FAAANKPoseTransformKey& Key = BakedKeys.AddDefaulted_GetRef();
+				Key.Frame = Frame;
+				Key.Location = Position;
+				Key.Rotation = Planned.Rotation;
+			}
+
+			// Advance to the next frame by the root motion of the section playing across it
+			const FAAANKPoseAnimationSection* Section = FindActiveSection(Sections, Frame);
+			const UAnimSequence* Anim = Section ? AnimCache.FindRef(Section->Name) : nullptr;
+			if (!Anim)
+			{
+				// No animation plays across this frame: move only as far as the plan itself does
+				const FVector PlannedStep = PlannedPath.Sample(Frame + 1).Location - Planned.Location;
+				Position.X += PlannedStep.X;
+				Position.Y += PlannedStep.Y;
+				continue;
+			}
+
+			const double Rate = Section->SpeedMultiplier;
+			const double StartTime = (Frame - Section->StartFrame) / Fps * Rate;
+			const FTransform Delta = ExtractLoopedRootMotion(Anim, StartTime, StartTime + Rate / Fps);
+
+			// Heading sampled mid-frame so the step follows the curve rather than lagging it
+			const double Heading = PlannedPath.Sample(Frame + 0.5).Rotation.Yaw;
+			const FVector Step = FRotator(0.0, Heading + MeshYawOffset, 0.0).RotateVector(Delta.GetTranslation());
+			Position.X += Step.X;
+			Position.Y += Step.Y;
+		}
+
+		if (FAAANKPoseTrackFolder::SaveTransformKeys(ActorFolder, BakedKeys))
+		{
+			BakedCount++;
+			UE_LOG(LogTemp, Log, TEXT("Baked %d root motion keys for '%s' (max drift from planned path: %.1f cm)"),
+				BakedKeys.Num(), *ActorName, MaxDeviation);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("BakeRootMotionTracks: %d/%d actors baked in '%s'"), BakedCount, Meta.Actors.Num(), *MovieFolder);
+	return BakedCount;
+}
@@ -0,0 +1,158 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseSaveService.h"
+#include "AAANKPoseSceneBuild.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/PackageName.h"
+#include "PoseSearch/PoseSearchDatabase.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+#include "UObject/UObjectIterator.h"
+
+
+namespace AAANKPoseSaveService
+{
+	static TArray<TWeakObjectPtr<UPackage>> CollectedPackages;
+	static FDelegateHandle MarkedDirtyHandle;
+
+	/**
+	 * Only the build's own sequence assets and the PoseSearch databases it fills; maps and their external
+	 * actor packages stay with FEditorFileUtils so a build never saves the level behind the user's back
+	 */
+	static bool IsBuildPackage(const UPackage* Package)
+	{
+		if (!Package || Package->HasAnyFlags(RF_Transient) || Package->ContainsMap())
+		{
+			return false;
+		}
+		// External actor packages live under /Game/__ExternalActors__, so the prefix excludes them too
+		if (Package->GetName().StartsWith(FString::Printf(TEXT("%s/"), FAAANKPoseSceneBuild::SequenceFolder)))
+		{
+			return true;
+		}
+		return Cast<UPoseSearchDatabase>(Package->FindAssetInPackage()) != nullptr;
+	}
+
+	static void OnPackageMarkedDirty(UPackage* Package, bool /*bWasDirty*/)
+	{
+		if (IsBuildPackage(Package))
+		{
+			CollectedPackages.AddUnique(Package);
+		}
+	}
+
+	static bool IsSaveablePackage(const UPackage* Package)
+	{
+		return Package
+			&& Package->IsDirty()
+			&& !Package->HasAnyFlags(RF_Transient)
+			&& !Package->HasAnyPackageFlags(PKG_CompiledIn)
+			&& !FPackageName::IsTempPackage(Package->GetName());
+	}
+}
+
+void UAAANKPoseSaveLibrary::BeginPackageCollection()
+{
+	using namespace AAANKPoseSaveService;
+
+	if (!MarkedDirtyHandle.IsValid())
+	{
+		MarkedDirtyHandle = UPackage::PackageMarkedDirtyEvent.AddStatic(&OnPackageMarkedDirty);
+	}
+	CollectedPackages.Reset();
+}
+
+int32 UAAANKPoseSaveLibrary::EndPackageCollection()
+{
+	using namespace AAANKPoseSaveService;
+
+	if (MarkedDirtyHandle.IsValid())
+	{
+		UPackage::PackageMarkedDirtyEvent.Remove(MarkedDirtyHandle);
+		MarkedDirtyHandle.Reset();
+	}
+	return CollectedPackages.Num();
+}
+
+TArray<FAAANKPosePackageSaveResult> UAAANKPoseSaveLibrary::SaveCollectedPackages()
+{
+	using namespace AAANKPoseSaveService;
+
+	EndPackageCollection();
+
+	TArray<UPackage*> Packages;
+	for (const TWeakObjectPtr<UPackage>& Package : CollectedPackages)
+	{
+		if (IsSaveablePackage(Package.Get()) && IsBuildPackage(Package.Get()))
+		{
+			Packages.Add(Package.Get());
+		}
+	}
+	CollectedPackages.Reset();
+
+	return SavePackagesBatched(Packages);
+}
+
+TArray<FAAANKPosePackageSaveResult> UAAANKPoseSaveLibrary::SaveDirtyPackagesUnderPath(const FString& PathPrefix)
+{
+	TArray<UPackage*> Packages;
+	for (TObjectIterator<UPackage> It; It; ++It)
+	{
+		if (AAANKPoseSaveService::IsSaveablePackage(*It) && It->GetName().StartsWith(PathPrefix))
+		{
+			Packages.Add(*It);
+		}
+	}
+	return SavePackagesBatched(Packages);
+}
+
+TArray<FAAANKPosePackageSaveResult> UAAANKPoseSaveLibrary::SavePackagesBatched(const TArray<UPackage*>& Packages)
+{
+	TArray<FAAANKPosePackageSaveResult> Results;
+
+#if WITH_EDITOR
+	const double BatchStart = FPlatformTime::Seconds();
+
+	// Serialize every package first; SAVE_Async hands the bytes to background writers
+	for (UPackage* Package : Packages)
+	{
+		FAAANKPosePackageSaveResult& Result = Results.AddDefaulted_GetRef();
+		Result.PackageName = Package->GetName();
+
+		const double Start = FPlatformTime::Seconds();
+
+		UObject* Asset = Package->FindAssetInPackage();
+		const FString& Extension = Package->ContainsMap()
+			? FPackageName::GetMapPackageExtension()
+			: FPackageName::GetAssetPackageExtension();
+		const FString PackageFileName = FPackageName::LongPackageNameToFilename(Result.PackageName, Extension);
+
+		FSavePackageArgs SaveArgs;
+		SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+		SaveArgs.SaveFlags = SAVE_NoError | SAVE_Async;
+
+		Result.bSaved = UPackage::SavePackage(Package, Asset, *PackageFileName, SaveArgs);
+		Result.Seconds = FPlatformTime::Seconds() - Start;
+
+		if (!Result.bSaved)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to save package '%s'"), *Result.PackageName);
+		}
+	}
+
+	const double WriteStart = FPlatformTime::Seconds();
+	UPackage::WaitForAsyncFileWrites();
+	const double Now = FPlatformTime::Seconds();
+
+	for (const FAAANKPosePackageSaveResult& Result : Results)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  Saved %s in %.1f ms"), *Result.PackageName, Result.Seconds * 1000.0);
+	}
+	UE_LOG(LogTemp, Log, TEXT("Saved %d packages in %.1f ms (%.1f ms waiting on file writes)"),
+		Results.Num(), (Now - BatchStart) * 1000.0, (Now - WriteStart) * 1000.0);
+#else
+	UE_LOG(LogTemp, Warning, TEXT("SavePackagesBatched is only available in editor builds"));
+#endif
+
+	return Results;
+}
@@ -0,0 +1,1155 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseSceneBuild.h"
+#include "AAANKPoseBuildCache.h"
+#include "AAANKPoseBuildTelemetry.h"
+#include "AAANKPoseLevelTemplate.h"
+#include "AAANKPoseMannequin.h"
+#include "AAANKPoseMaterialPool.h"
+#include "AAANKPoseSpawnLibrary.h"
+#include "CineCameraActor.h"
+#include "CineCameraComponent.h"
+#include "Channels/MovieSceneDoubleChannel.h"
+#include "Channels/MovieSceneFloatChannel.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Dom/JsonObject.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "LevelSequence.h"
+#include "Materials/MaterialInterface.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "MovieScene.h"
+#include "Sections/MovieScene3DTransformSection.h"
+#include "Sections/MovieSceneCameraCutSection.h"
+#include "Sections/MovieSceneCinematicShotSection.h"
+#include "Sections/MovieSceneFloatSection.h"
+#include "Sections/MovieSceneSkeletalAnimationSection.h"
+#include "Tracks/MovieScene3DTransformTrack.h"
+#include "Tracks/MovieSceneCameraCutTrack.h"
+#include "Tracks/MovieSceneCinematicShotTrack.h"
+#include "Tracks/MovieSceneFloatTrack.h"
+#include "Tracks/MovieSceneSkeletalAnimationTrack.h"
+#include "UObject/Package.h"
+
+#if WITH_EDITOR
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Editor.h"
+#endif
+
+
+namespace AAANKPoseSceneBuild
+{
+	static const FName DebugTag(TEXT("MotionSystemDebug"));
+	static const TCHAR* DefaultMannequinMesh = TEXT("/Game/ParagonLtBelica/Characters/Heroes/Belica/Meshes/Belica.Belica");
+	static const TCHAR* DefaultMarkerMesh = TEXT("/Engine/BasicShapes/Cylinder.Cylinder");
+
+	/** Same names as assets.Materials.COLORS; unknown names fall back to red */
+	static FLinearColor GetMarkerColor(const FString& ColorName)
+	{
+		static const TMap<FString, FLinearColor> Colors = {
+			{ TEXT("red"), FLinearColor(1.0f, 0.0f, 0.0f) },
+			{ TEXT("blue"), FLinearColor(0.0f, 0.0f, 1.0f) },
+			{ TEXT("green"), FLinearColor(0.0f, 1.0f, 0.0f) },
+			{ TEXT("yellow"), FLinearColor(1.0f, 1.0f, 0.0f) },
+			{ TEXT("purple"), FLinearColor(1.0f, 0.0f, 1.0f) },
+			{ TEXT("orange"), FLinearColor(1.0f, 0.5f, 0.0f) },
+			{ TEXT("cyan"), FLinearColor(0.0f, 1.0f, 1.0f) },
+			{ TEXT("white"), FLinearColor(1.0f, 1.0f, 1.0f) },
+		};
+		const FLinearColor* Color = Colors.Find(ColorName.ToLower());
+		return Color ? *Color : FLinearColor(1.0f, 0.0f, 0.0f);
+	}
+
+	/** Reads a field from settings.json, then from its nested "properties" object */
+	static FString GetSettingString(const TSharedPtr<FJsonObject>& Settings, const TCHAR* Field)
+	{
+		FString Value;
+		if (!Settings.IsValid())
+		{
+			return Value;
+		}
+		if (Settings->TryGetStringField(Field, Value) && !Value.IsEmpty())
+		{
+			return Value;
+		}
+		const TSharedPtr<FJsonObject>* Properties = nullptr;
+		if (Settings->TryGetObjectField(TEXT("properties"), Properties))
+		{
+			(*Properties)->TryGetStringField(Field, Value);
+		}
+		return Value;
+	}
+
+	static EAAANKPoseSceneActorType ClassifyActor(const TSharedPtr<FJsonObject>& Settings)
+	{
+		if (!Settings.IsValid())
+		{
+			return EAAANKPoseSceneActorType::Mannequin;
+		}
+
+		FString ActorType = TEXT("camera");
+		Settings->TryGetStringField(TEXT("actor_type"), ActorType);
+
+		if (ActorType == TEXT("camera") || Settings->HasField(TEXT("fov")))
+		{
+			return EAAANKPoseSceneActorType::Camera;
+		}
+		if (ActorType == TEXT("light") || Settings->HasField(TEXT("light_type")) || ActorType == TEXT("spline"))
+		{
+			return EAAANKPoseSceneActorType::Unsupported;
+		}
+		if (ActorType == TEXT("marker"))
+		{
+			return EAAANKPoseSceneActorType::Marker;
+		}
+		return EAAANKPoseSceneActorType::Mannequin;
+	}
+
+	static FString MakeSequencePackageName(const FString& SceneName)
+	{
+		const FString BaseName = FAAANKPoseSceneBuild::GetSequenceBaseName(SceneName);
+		for (int32 Number = 1; ; ++Number)
+		{
+			const FString PackageName = FString::Printf(TEXT("%s/%s_%03d"), FAAANKPoseSceneBuild::SequenceFolder, *BaseName, Number);
+			if (!FindPackage(nullptr, *PackageName) && !FPackageName::DoesPackageExist(PackageName))
+			{
+				return PackageName;
+			}
+		}
+	}
+
+	/** Unlike the master, a shot keeps the same path across builds so its content hash can be compared */
+	static FString MakeShotPackageName(const FString& SceneName, int32 ShotIndex)
+	{
+		const FString BaseName = FAAANKPoseSceneBuild::GetSequenceBaseName(SceneName);
+		return FString::Printf(TEXT("%s/Shots/%s/%s_Shot%03d"), FAAANKPoseSceneBuild::SequenceFolder, *BaseName, *BaseName, ShotIndex);
+	}
+
+	static FGuid BindChild(ULevelSequence& Target, const FGuid& Parent, UObject& Component, AActor& Owner)
+	{
+		UMovieScene* TargetScene = Target.GetMovieScene();
+		const FGuid ComponentBinding = TargetScene->AddPossessable(Component.GetName(), Component.GetClass());
+		if (FMovieScenePossessable* Possessable = TargetScene->FindPossessable(ComponentBinding))
+		{
+			Possessable->SetParent(Parent, TargetScene);
+		}
+		Target.BindPossessableObject(ComponentBinding, Component, &Owner);
+		return ComponentBinding;
+	}
+
+	/** Telephoto keys would otherwise be clamped by the default lens limits */
+	static void RaiseLensLimit(UCineCameraComponent& CameraComponent, const TArray<TPair<int32, float>>& Keys)
+	{
+		float MaxFocalLength = 0.0f;
+		for (const TPair<int32, float>& Key : Keys)
+		{
+			MaxFocalLength = FMath::Max(MaxFocalLength, Key.Value);
+		}
+		if (MaxFocalLength > CameraComponent.LensSettings.MaxFocalLength)
+		{
+			CameraComponent.LensSettings.MaxFocalLength = MaxFocalLength + 100.0f;
+		}
+	}
+
+	/** Focal length that gives the camera's filmback this horizontal field of view */
+	static float GetFocalLengthForFov(const UCineCameraComponent& CameraComponent, double FovDegrees)
+	{
+		const double HalfFov = FMath::DegreesToRadians(FMath::Clamp(FovDegrees, 1.0, 170.0)) * 0.5;
+		return static_cast<float>(CameraComponent.Filmback.SensorWidth * 0.5 / FMath::Tan(HalfFov));
+	}
+
+	/**
+	 * Descriptor for one scene actor, spawned where its transform track starts
+	 * @return False for actors the native build leaves to the Python path
+	 */
+	static bool MakeSpawnDescriptor(const FAAANKPoseSceneActor& SceneActor, FAAANKPoseSpawnDescriptor& Descriptor)
+	{
+		if (SceneActor.Type == EAAANKPoseSceneActorType::Unsupported)
+		{
+			return false;
+		}
+
+		Descriptor.Label = SceneActor.Name;
+		Descriptor.Tags.Add(AAAANKPoseMannequin::MotionSystemTag);
+		if (SceneActor.TransformKeys.Num() > 0)
+		{
+			const FAAANKPoseTransformKey& First = SceneActor.TransformKeys[0];
+			Descriptor.Transform = FTransform(First.Rotation, First.Location);
+		}
+
+		switch (SceneActor.Type)
+		{
+		case EAAANKPoseSceneActorType::Camera:
+			Descriptor.ActorClass = ACineCameraActor::StaticClass();
+			break;
+
+		case EAAANKPoseSceneActorType::Marker:
+		{
+			Descriptor.ActorClass = AStaticMeshActor::StaticClass();
+			const FString MeshPath = GetSettingString(SceneActor.Settings, TEXT("mesh_path"));
+			Descriptor.Mesh = TSoftObjectPtr<UObject>(FSoftObjectPath(MeshPath.IsEmpty() ? DefaultMarkerMesh : *MeshPath));
+
+			FVector Scale(0.1);
+			const TArray<TSharedPtr<FJsonValue>>* ScaleValues = nullptr;
+			if (SceneActor.Settings->TryGetArrayField(TEXT("mesh_scale"), ScaleValues) && ScaleValues->Num() == 3)
+			{
+				Scale = FVector((*ScaleValues)[0]->AsNumber(), (*ScaleValues)[1]->AsNumber(), (*ScaleValues)[2]->AsNumber());
+			}
+			Descriptor.Transform.SetScale3D(Scale);
+
+			FString Color = TEXT("Blue");
+			SceneActor.Settings->TryGetStringField(TEXT("color"), Color);
+			// One pooled material per color, shared with the Python markers
+			Descriptor.Materials.Add(TSoftObjectPtr<UMaterialInterface>(FAAANKPoseMaterialPool::GetColorMaterial(GetMarkerColor(Color))));
+			break;
+		}
+
+		default:
+		{
+			const FString MeshPath = GetSettingString(SceneActor.Settings, TEXT("mesh_path"));
+
+			// Blueprint characters are spawned from their class, like mannequin_setup.create_mannequin
+			if (MeshPath.Contains(TEXT("BP_")) || MeshPath.EndsWith(TEXT("_C")))
+			{
+				const FString ClassPath = MeshPath.EndsWith(TEXT("_C")) ? MeshPath : MeshPath + TEXT("_C");
+				Descriptor.ActorClass = LoadClass<AActor>(nullptr, *ClassPath);
+			}
+			else
+			{
+				Descriptor.ActorClass = AAAANKPoseMannequin::StaticClass();
+				Descriptor.Mesh = TSoftObjectPtr<UObject>(FSoftObjectPath(MeshPath.IsEmpty() ? DefaultMannequinMesh : *MeshPath));
+			}
+			break;
+		}
+		}
+		return true;
+	}
+
+	/** Unkeyed scale channels default to 1, which would undo marker scaling */
+	static void SetScaleDefaults(UMovieScene3DTransformSection& Section, const AActor& Actor)
+	{
+		TArrayView<FMovieSceneDoubleChannel*> Channels = Section.GetChannelProxy().GetChannels<FMovieSceneDoubleChannel>();
+		const FVector Scale = Actor.GetActorScale3D();
+		Channels[6]->SetDefault(Scale.X);
+		Channels[7]->SetDefault(Scale.Y);
+		Channels[8]->SetDefault(Scale.Z);
+	}
+
+	static void SetCubicKeys(FMovieSceneDoubleChannel& Channel, const TArray<FFrameNumber>& Times, TArray<FMovieSceneDoubleValue>&& Values)
+	{
+		for (FMovieSceneDoubleValue& Value : Values)
+		{
+			Value.InterpMode = RCIM_Cubic;
+			Value.TangentMode = RCTM_Auto;
+		}
+		Channel.Set(Times, MoveTemp(Values));
+		Channel.AutoSetTangents();
+	}
+}
+
+FAAANKPoseSceneBuild::FAAANKPoseSceneBuild(const FString& InMovieFolder, UWorld* InWorld)
+	: MovieFolder(InMovieFolder)
+	, World(InWorld)
+{
+}
+
+void FAAANKPoseSceneBuild::SetShotPartition(EAAANKPoseShotPartition InPartition, float InWindowSeconds)
+{
+	Partition = InPartition;
+	ShotWindowSeconds = FMath::Max(InWindowSeconds, 0.1f);
+}
+
+void FAAANKPoseSceneBuild::SetUseBuildCache(bool bInUseBuildCache)
+{
+	bUseBuildCache = bInUseBuildCache;
+}
+
+void FAAANKPoseSceneBuild::SetPrewarmTimeout(float InSeconds)
+{
+	PrewarmTimeoutSeconds = FMath::Max(InSeconds, 0.0f);
+}
+
+FString FAAANKPoseSceneBuild::GetBuildOptions() const
+{
+	// Window length only changes the output when windows are used
+	if (Partition == EAAANKPoseShotPartition::TimeWindows)
+	{
+		return FString::Printf(TEXT("native;shots=%d;window=%.3f"), static_cast<int32>(Partition), ShotWindowSeconds);
+	}
+	return FString::Printf(TEXT("native;shots=%d"), static_cast<int32>(Partition));
+}
+
+bool FAAANKPoseSceneBuild::Tick(double DeadlineSeconds)
+{
+	do
+	{
+		if (IsFinished())
+		{
+			return true;
+		}
+		RunUnit();
+
+		// Streaming progresses between frames, not between units; give the rest of the frame back
+		if (Step == EAAANKPoseSceneBuildStep::Prewarm && Cursor > 0)
+		{
+			break;
+		}
+	}
+	while (FPlatformTime::Seconds() < DeadlineSeconds);
+
+	return IsFinished();
+}
+
+bool FAAANKPoseSceneBuild::RunToCompletion()
+{
+	bBlocking = true;
+	while (!IsFinished())
+	{
+		RunUnit();
+	}
+	return Succeeded();
+}
+
+void FAAANKPoseSceneBuild::Cancel()
+{
+	if (!IsFinished())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SceneBuild: Cancelled '%s' during step %d"), *MovieFolder, static_cast<int32>(Step));
+		bCancelled = true;
+		Step = EAAANKPoseSceneBuildStep::Done;
+	}
+}
+
+float FAAANKPoseSceneBuild::GetProgress() const
+{
+	const int32 NumSteps = static_cast<int32>(EAAANKPoseSceneBuildStep::Done);
+	const int32 StepIndex = static_cast<int32>(Step);
+	if (StepIndex >= NumSteps)
+	{
+		return 1.0f;
+	}
+
+	// Only the per-actor steps have more than one unit worth reporting
+	float StepFraction = 0.0f;
+	if (Step == EAAANKPoseSceneBuildStep::Cleanup && ActorsToDelete.Num() > 0)
+	{
+		StepFraction = static_cast<float>(Cursor) / ActorsToDelete.Num();
+	}
+	else if (Step == EAAANKPoseSceneBuildStep::KeyActors && Shots.Num() > 0)
+	{
+		StepFraction = static_cast<float>(Cursor) / Shots.Num();
+	}
+	else if ((Step == EAAANKPoseSceneBuildStep::LoadTracks || Step == EAAANKPoseSceneBuildStep::Spawn || Step == EAAANKPoseSceneBuildStep::KeyActors)
+		&& SceneActors.Num() > 0)
+	{
+		StepFraction = static_cast<float>(Cursor) / SceneActors.Num();
+	}
+	return (StepIndex + FMath::Clamp(StepFraction, 0.0f, 1.0f)) / NumSteps;
+}
+
+void FAAANKPoseSceneBuild::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObjects(ActorsToDelete);
+	Collector.AddReferencedObject(Sequence);
+	Collector.AddReferencedObject(MovieScene);
+	Collector.AddReferencedObjects(ShotSequences);
+	for (FAAANKPoseSceneActor& SceneActor : SceneActors)
+	{
+		Collector.AddReferencedObject(SceneActor.Actor);
+	}
+}
+
+void FAAANKPoseSceneBuild::RunUnit()
+{
+	if (!World.IsValid())
+	{
+		Fail(TEXT("World went away during the build"));
+		return;
+	}
+
+	FAAANKPoseScopedPhase Phase(StaticEnum<EAAANKPoseSceneBuildStep>()->GetNameStringByValue(static_cast<int64>(Step)));
+	switch (Step)
+	{
+	case EAAANKPoseSceneBuildStep::CheckCache:		RunCheckCache(); break;
+	case EAAANKPoseSceneBuildStep::Cleanup:			RunCleanupUnit(); break;
+	case EAAANKPoseSceneBuildStep::LoadTracks:		RunLoadTracksUnit(); break;
+	case EAAANKPoseSceneBuildStep::CreateSequence:	RunCreateSequence(); break;
+	case EAAANKPoseSceneBuildStep::Spawn:			RunSpawn(); break;
+	case EAAANKPoseSceneBuildStep::PartitionShots:	RunPartitionShots(); break;
+	case EAAANKPoseSceneBuildStep::KeyActors:		RunKeyActorUnit(); break;
+	case EAAANKPoseSceneBuildStep::CameraCuts:		RunCameraCuts(); break;
+	case EAAANKPoseSceneBuildStep::Finalize:		RunFinalize(); break;
+	case EAAANKPoseSceneBuildStep::Prewarm:			RunPrewarm(); break;
+	default: break;
+	}
+}
+
+void FAAANKPoseSceneBuild::Advance()
+{
+	if (!IsFinished())
+	{
+		Step = static_cast<EAAANKPoseSceneBuildStep>(static_cast<uint8>(Step) + 1);
+		Cursor = 0;
+	}
+}
+
+void FAAANKPoseSceneBuild::Fail(const FString& Message)
+{
+	UE_LOG(LogTemp, Error, TEXT("SceneBuild: %s"), *Message);
+	Error = Message;
+	Step = EAAANKPoseSceneBuildStep::Done;
+}
+
+const int32 FAAANKPoseSceneBuild::TailFrames = 60;
+const TCHAR* const FAAANKPoseSceneBuild::SequenceFolder = TEXT("/Game/Sequences");
+
+FString FAAANKPoseSceneBuild::GetSequenceBaseName(const FString& SceneName)
+{
+	FString BaseName = SceneName.IsEmpty() ? TEXT("Untitled_Scene") : SceneName;
+	BaseName.ReplaceCharInline(TEXT(' '), TEXT('_'));
+	BaseName.ReplaceCharInline(TEXT('-'), TEXT('_'));
+	return BaseName;
+}
+
+FFrameNumber FAAANKPoseSceneBuild::ToTick(double DisplayFrame) const
+{
+	return DisplayFrameToTick(*MovieScene, DisplayFrame);
+}
+
+FFrameNumber FAAANKPoseSceneBuild::DisplayFrameToTick(const UMovieScene& InMovieScene, double DisplayFrame)
+{
+	return FFrameRate::TransformTime(FFrameTime::FromDecimal(DisplayFrame), InMovieScene.GetDisplayRate(), InMovieScene.GetTickResolution()).RoundToFrame();
+}
+
+void FAAANKPoseSceneBuild::RunCheckCache()
+{
+	// New-level movies switch to their own level first, like run_scene, so the cache and cleanup see that world
+	if (FAAANKPoseTrackFolder::LoadMeta(MovieFolder, Meta) && Meta.bCreateNewLevel)
+	{
+		const FString LevelPath = FAAANKPoseLevelTemplate::GetMovieLevelPath(Meta.Name);
+		if (!FAAANKPoseLevelTemplate::CreateMovieLevel(LevelPath, FString(), FAAANKPoseLevelOverrides()))
+		{
+			Fail(FString::Printf(TEXT("Could not open the movie level %s"), *LevelPath));
+			return;
+		}
+#if WITH_EDITOR
+		World = GEditor->GetEditorWorldContext().World();
+#endif
+	}
+
+	// Computed before anything is torn down, so the stamp describes the folder this build read
+	Fingerprint = FAAANKPoseBuildCache::ComputeFingerprint(MovieFolder, GetBuildOptions());
+	if (bUseBuildCache)
+	{
+		if (ULevelSequence* Cached = FAAANKPoseBuildCache::FindReusableSequence(World.Get(), MovieFolder, Fingerprint))
+		{
+			Sequence = Cached;
+			MovieScene = Cached->GetMovieScene();
+			bReusedSequence = true;
+			UE_LOG(LogTemp, Log, TEXT("SceneBuild: '%s' is unchanged since %s was built; skipping the build"), *MovieFolder, *Cached->GetName());
+			// A reloaded sequence hitches on first play just like a fresh one
+			Step = EAAANKPoseSceneBuildStep::Prewarm;
+			Cursor = 0;
+			return;
+		}
+	}
+	Advance();
+}
+
+void FAAANKPoseSceneBuild::RunCleanupUnit()
+{
+	// First unit gathers, every following unit destroys one actor
+	if (Cursor == 0 && ActorsToDelete.Num() == 0)
+	{
+		for (TActorIterator<AActor> It(World.Get()); It; ++It)
+		{
+			if (It->ActorHasTag(AAAANKPoseMannequin::MotionSystemTag) || It->ActorHasTag(AAANKPoseSceneBuild::DebugTag))
+			{
+				ActorsToDelete.Add(*It);
+			}
+		}
+		if (ActorsToDelete.Num() == 0)
+		{
+			Advance();
+		}
+		return;
+	}
+
+	if (AActor* Actor = ActorsToDelete[Cursor])
+	{
+#if WITH_EDITOR
+		World->EditorDestroyActor(Actor, /*bShouldModifyLevel*/ true);
+#else
+		Actor->Destroy();
+#endif
+	}
+
+	if (++Cursor >= ActorsToDelete.Num())
+	{
+		UE_LOG(LogTemp, Log, TEXT("SceneBuild: Deleted %d old actor(s)"), ActorsToDelete.Num());
+		ActorsToDelete.Reset();
+		Advance();
+	}
+}
+
+void FAAANKPoseSceneBuild::RunLoadTracksUnit()
+{
+	using namespace AAANKPoseSceneBuild;
+
+	if (Cursor == 0 && SceneActors.Num() == 0)
+	{
+		if (!FAAANKPoseTrackFolder::LoadMeta(MovieFolder, Meta))
+		{
+			Fail(FString::Printf(TEXT("meta.json not found in %s"), *MovieFolder));
+			return;
+		}
+		for (const FString& ActorName : Meta.Actors)
+		{
+			FAAANKPoseSceneActor& SceneActor = SceneActors.AddDefaulted_GetRef();
+			SceneActor.Name = ActorName;
+			SceneActor.Folder = FPaths::Combine(MovieFolder, ActorName);
+		}
+		if (SceneActors.Num() == 0)
+		{
+			Advance();
+		}
+		return;
+	}
+
+	FAAANKPoseSceneActor& SceneActor = SceneActors[Cursor];
+	if (FPaths::DirectoryExists(SceneActor.Folder))
+	{
+		SceneActor.Settings = FAAANKPoseTrackFolder::LoadSettings(SceneActor.Folder);
+		SceneActor.Type = ClassifyActor(SceneActor.Settings);
+		FAAANKPoseTrackChunkIndex TransformIndex;
+		if (FAAANKPoseTrackFolder::LoadTransformIndex(SceneActor.Folder, TransformIndex) && TransformIndex.IsValid())
+		{
+			// Long takes stay on disk until keyed; spawning only needs the first key
+			FAAANKPoseTrackFolder::LoadTransformWindow(SceneActor.Folder, TransformIndex, TransformIndex.FirstFrame, TransformIndex.FirstFrame, SceneActor.TransformKeys);
+			SceneActor.TransformKeys.SetNum(FMath::Min(SceneActor.TransformKeys.Num(), 1));
+			SceneActor.bStreamTransform = true;
+			TotalFrames = FMath::Max(TotalFrames, TransformIndex.LastFrame);
+		}
+		else
+		{
+			FAAANKPoseTrackFolder::LoadTransformKeys(SceneActor.Folder, SceneActor.TransformKeys);
+		}
+		FAAANKPoseTrackFolder::LoadAnimationSections(SceneActor.Folder, SceneActor.AnimationSections);
+		FAAANKPoseTrackFolder::LoadFocalLengthKeys(SceneActor.Folder, SceneActor.FocalLengthKeys);
+
+		if (SceneActor.TransformKeys.Num() > 0)
+		{
+			TotalFrames = FMath::Max(TotalFrames, SceneActor.TransformKeys.Last().Frame);
+		}
+		if (SceneActor.Type == EAAANKPoseSceneActorType::Unsupported)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SceneBuild: '%s' is a light or spline; leaving it to the Python path"), *SceneActor.Name);
+		}
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SceneBuild: Folder not found for %s"), *SceneActor.Name);
+		SceneActor.Type = EAAANKPoseSceneActorType::Unsupported;
+	}
+
+	if (++Cursor >= SceneActors.Num())
+	{
+		Advance();
+	}
+}
+
+void FAAANKPoseSceneBuild::RunCreateSequence()
+{
+	const FString PackageName = AAANKPoseSceneBuild::MakeSequencePackageName(Meta.Name);
+	UPackage* Package = CreatePackage(*PackageName);
+	if (!Package)
+	{
+		Fail(FString::Printf(TEXT("Could not create package %s"), *PackageName));
+		return;
+	}
+
+	Sequence = NewObject<ULevelSequence>(Package, *FPackageName::GetShortName(PackageName), RF_Public | RF_Standalone | RF_Transactional);
+	Sequence->Initialize();
+	MovieScene = Sequence->GetMovieScene();
+	MovieScene->SetDisplayRate(FFrameRate(FMath::Max(Meta.Fps, 1), 1));
+
+#if WITH_EDITOR
+	FAssetRegistryModule::AssetCreated(Sequence);
+#endif
+	Package->MarkPackageDirty();
+
+	UE_LOG(LogTemp, Log, TEXT("SceneBuild: Created sequence %s at %d fps"), *PackageName, Meta.Fps);
+	Advance();
+}
+
+void FAAANKPoseSceneBuild::RunSpawn()
+{
+	using namespace AAANKPoseSceneBuild;
+
+	if (SceneActors.Num() == 0)
+	{
+		Advance();
+		return;
+	}
+
+	// One actor per unit, like KeyActors, so a sliced build can yield between spawns
+	FAAANKPoseSceneActor& SceneActor = SceneActors[Cursor];
+	FAAANKPoseSpawnDescriptor Descriptor;
+	if (MakeSpawnDescriptor(SceneActor, Descriptor))
+	{
+		SceneActor.Actor = UAAANKPoseSpawnLibrary::SpawnActorsBatch(World.Get(), { Descriptor })[0];
+	}
+
+	if (SceneActor.Actor)
+	{
+		double Fov = 0.0;
+		ACineCameraActor* Camera = Cast<ACineCameraActor>(SceneActor.Actor);
+		if (Camera && SceneActor.Settings.IsValid() && SceneActor.Settings->TryGetNumberField(TEXT("fov"), Fov))
+		{
+			// A cine camera derives its FOV from the lens, so the lens is what has to change
+			UCineCameraComponent* CameraComponent = Camera->GetCineCameraComponent();
+			CameraComponent->SetCurrentFocalLength(GetFocalLengthForFov(*CameraComponent, Fov));
+		}
+
+		// Partitioned builds bind actors in each shot instead of the master
+		if (Partition == EAAANKPoseShotPartition::None)
+		{
+			SceneActor.Binding = MovieScene->AddPossessable(SceneActor.Name, SceneActor.Actor->GetClass());
+			Sequence->BindPossessableObject(SceneActor.Binding, *SceneActor.Actor, World.Get());
+		}
+		else if (Camera && SceneActor.FocalLengthKeys.Num() > 0)
+		{
+			RaiseLensLimit(*Camera->GetCineCameraComponent(), SceneActor.FocalLengthKeys);
+		}
+	}
+
+	if (++Cursor >= SceneActors.Num())
+	{
+		Advance();
+	}
+}
+
+void FAAANKPoseSceneBuild::RunPartitionShots()
+{
+	if (Partition == EAAANKPoseShotPartition::None)
+	{
+		Advance();
+		return;
+	}
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	TArray<FAAANKPoseCameraCut> Cuts;
+	FAAANKPoseTrackFolder::LoadCameraCuts(MovieFolder, Cuts);
+	FAAANKPoseShotPartition::MakeShots(Partition, Cuts, Meta.Fps, ShotWindowSeconds, TotalFrames + TailFrames, Shots);
+	FAAANKPoseShotPartition::PrepareShots(SceneActors, Meta.Fps, Shots);
+
+	UE_LOG(LogTemp, Log, TEXT("SceneBuild: Prepared %d shot(s) in %.1f ms"), Shots.Num(), (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+	Advance();
+}
+
+void FAAANKPoseSceneBuild::RunKeyActorUnit()
+{
+	if (Shots.Num() > 0)
+	{
+		RunShotUnit();
+		return;
+	}
+
+	if (SceneActors.Num() == 0)
+	{
+		Advance();
+		return;
+	}
+
+	FAAANKPoseSceneActor& SceneActor = SceneActors[Cursor];
+	if (SceneActor.Actor && SceneActor.Binding.IsValid())
+	{
+		KeyTransform(SceneActor);
+		KeyAnimations(SceneActor);
+		KeyFocalLength(SceneActor);
+	}
+
+	if (++Cursor >= SceneActors.Num())
+	{
+		Advance();
+	}
+}
+
+FGuid FAAANKPoseSceneBuild::BindComponent(FAAANKPoseSceneActor& SceneActor, UObject* Component)
+{
+	return AAANKPoseSceneBuild::BindChild(*Sequence, SceneActor.Binding, *Component, *SceneActor.Actor);
+}
+
+void FAAANKPoseSceneBuild::RunShotUnit()
+{
+	using namespace AAANKPoseSceneBuild;
+
+	FAAANKPoseShot& Shot = Shots[Cursor];
+	const FString PackageName = MakeShotPackageName(Meta.Name, Cursor);
+
+	ULevelSequence* ShotSequence = nullptr;
+	if (FPackageName::DoesPackageExist(PackageName) || FindPackage(nullptr, *PackageName))
+	{
+		ShotSequence = LoadObject<ULevelSequence>(nullptr, *(PackageName + TEXT(".") + FPackageName::GetShortName(PackageName)));
+		FAAANKPoseBuildTelemetry::AddCounter(FAAANKPoseBuildTelemetry::AssetsLoaded);
+	}
+	if (!ShotSequence)
+	{
+		UPackage* Package = CreatePackage(*PackageName);
+		ShotSequence = NewObject<ULevelSequence>(Package, *FPackageName::GetShortName(PackageName), RF_Public | RF_Standalone | RF_Transactional);
+		ShotSequence->Initialize();
+#if WITH_EDITOR
+		FAssetRegistryModule::AssetCreated(ShotSequence);
+#endif
+	}
+	ShotSequences.Add(ShotSequence);
+
+	UAAANKPoseShotMetaData* ShotMeta = ShotSequence->FindOrAddMetaData<UAAANKPoseShotMetaData>();
+	if (ShotMeta->ContentHash == Shot.ContentHash && RebindShot(*ShotSequence, Shot))
+	{
+		++ShotsSkipped;
+	}
+	else
+	{
+		KeyShot(*ShotSequence, Shot);
+		ShotMeta->ContentHash = Shot.ContentHash;
+		ShotMeta->StartFrame = Shot.StartFrame;
+		ShotMeta->EndFrame = Shot.EndFrame;
+	}
+	ShotSequence->MarkPackageDirty();
+
+	UMovieSceneCinematicShotTrack* ShotTrack = MovieScene->FindTrack<UMovieSceneCinematicShotTrack>();
+	if (!ShotTrack)
+	{
+		ShotTrack = MovieScene->AddTrack<UMovieSceneCinematicShotTrack>();
+	}
+	const FFrameNumber Start = ToTick(Shot.StartFrame);
+	ShotTrack->AddSequence(ShotSequence, Start, (ToTick(Shot.EndFrame) - Start).Value);
+
+	// The sliced tracks are in the subsequence now
+	Shot.Actors.Empty();
+
+	if (++Cursor >= Shots.Num())
+	{
+		UE_LOG(LogTemp, Log, TEXT("SceneBuild: Built %d shot(s), %d unchanged"), Shots.Num(), ShotsSkipped);
+		Advance();
+	}
+}
+
+void FAAANKPoseSceneBuild::KeyShot(ULevelSequence& ShotSequence, const FAAANKPoseShot& Shot)
+{
+	using namespace AAANKPoseSceneBuild;
+
+	UMovieScene* ShotScene = ShotSequence.GetMovieScene();
+	ShotScene->Modify();
+
+	// Start from an empty shot; possessables take their tracks with them
+	while (ShotScene->GetPossessableCount() > 0)
+	{
+		const FGuid Guid = ShotScene->GetPossessable(ShotScene->GetPossessableCount() - 1).GetGuid();
+		ShotSequence.UnbindPossessableObjects(Guid);
+		ShotScene->RemovePossessable(Guid);
+	}
+	ShotScene->RemoveCameraCutTrack();
+
+	ShotScene->SetDisplayRate(MovieScene->GetDisplayRate());
+	ShotScene->SetTickResolutionDirectly(MovieScene->GetTickResolution());
+
+	// Shots keep the master's frame numbers; the shot section maps its playback start onto the master
+	const TRange<FFrameNumber> Range(ToTick(Shot.StartFrame), ToTick(Shot.EndFrame));
+	TMap<FString, FGuid> Bindings;
+	for (const FAAANKPoseShotActor& ShotActor : Shot.Actors)
+	{
+		const FAAANKPoseSceneActor& SceneActor = SceneActors[ShotActor.ActorIndex];
+		if (!SceneActor.Actor)
+		{
+			continue;
+		}
+
+		const FGuid Binding = ShotScene->AddPossessable(SceneActor.Name, SceneActor.Actor->GetClass());
+		ShotSequence.BindPossessableObject(Binding, *SceneActor.Actor, World.Get());
+		Bindings.Add(SceneActor.Name, Binding);
+
+		if (ShotActor.TransformKeys.Num() > 0)
+		{
+			UMovieScene3DTransformTrack* Track = ShotScene->AddTrack<UMovieScene3DTransformTrack>(Binding);
+			UMovieScene3DTransformSection* Section = CastChecked<UMovieScene3DTransformSection>(Track->CreateNewSection());
+			Track->AddSection(*Section);
+			Section->SetRange(Range);
+			WriteTransformKeys(*Section, ShotActor.TransformKeys);
+			SetScaleDefaults(*Section, *SceneActor.Actor);
+		}
+
+		USkeletalMeshComponent* MeshComponent = ShotActor.AnimationSections.Num() > 0 ? SceneActor.Actor->FindComponentByClass<USkeletalMeshComponent>() : nullptr;
+		if (MeshComponent)
+		{
+			const FGuid ComponentBinding = BindChild(ShotSequence, Binding, *MeshComponent, *SceneActor.Actor);
+			UMovieSceneSkeletalAnimationTrack* Track = ShotScene->AddTrack<UMovieSceneSkeletalAnimationTrack>(ComponentBinding);
+			AddAnimationSections(*Track, ShotActor.AnimationSections, TotalFrames + TailFrames);
+		}
+
+		ACineCameraActor* Camera = Cast<ACineCameraActor>(SceneActor.Actor);
+		if (Camera && ShotActor.FocalLengthKeys.Num() > 0)
+		{
+			const FGuid ComponentBinding = BindChild(ShotSequence, Binding, *Camera->GetCineCameraComponent(), *SceneActor.Actor);
+			UMovieSceneFloatTrack* Track = ShotScene->AddTrack<UMovieSceneFloatTrack>(ComponentBinding);
+			Track->SetPropertyNameAndPath(TEXT("CurrentFocalLength"), TEXT("CurrentFocalLength"));
+			UMovieSceneFloatSection* Section = CastChecked<UMovieSceneFloatSection>(Track->CreateNewSection());
+			Track->AddSection(*Section);
+			Section->SetRange(Range);
+			WriteFocalLengthKeys(*Section, ShotActor.FocalLengthKeys);
+		}
+	}
+
+	UMovieSceneCameraCutTrack* CutTrack = nullptr;
+	for (int32 Index = 0; Index < Shot.Cuts.Num(); ++Index)
+	{
+		const FGuid* Camera = Bindings.Find(Shot.Cuts[Index].Value);
+		if (!Camera)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SceneBuild: Camera '%s' not found, skipping cut"), *Shot.Cuts[Index].Value);
+			continue;
+		}
+		if (!CutTrack)
+		{
+			CutTrack = Cast<UMovieSceneCameraCutTrack>(ShotScene->AddCameraCutTrack(UMovieSceneCameraCutTrack::StaticClass()));
+		}
+		const FFrameNumber CutStart = ToTick(Shot.Cuts[Index].Key);
+		const FFrameNumber CutEnd = Index + 1 < Shot.Cuts.Num() ? ToTick(Shot.Cuts[Index + 1].Key) : Range.GetUpperBoundValue();
+		UMovieSceneCameraCutSection* Section = CutTrack->AddNewCameraCut(UE::MovieScene::FRelativeObjectBindingID(*Camera), CutStart);
+		Section->SetRange(TRange<FFrameNumber>(CutStart, CutEnd));
+	}
+
+	ShotScene->SetPlaybackRange(Range);
+	ShotScene->MarkAsChanged();
+}
+
+bool FAAANKPoseSceneBuild::RebindShot(ULevelSequence& ShotSequence, const FAAANKPoseShot& Shot)
+{
+	UMovieScene* ShotScene = ShotSequence.GetMovieScene();
+	if (ShotScene->GetPossessableCount() == 0)
+	{
+		return false;
+	}
+
+	// Roots first so children can be resolved through their parent's new actor
+	TMap<FGuid, AActor*> RootActors;
+	for (int32 Index = 0; Index < ShotScene->GetPossessableCount(); ++Index)
+	{
+		const FMovieScenePossessable& Possessable = ShotScene->GetPossessable(Index);
+		if (Possessable.GetParent().IsValid())
+		{
+			continue;
+		}
+		const FAAANKPoseSceneActor* SceneActor = SceneActors.FindByPredicate([&Possessable](const FAAANKPoseSceneActor& Candidate)
+		{
+			return Candidate.Name == Possessable.GetName();
+		});
+		if (!SceneActor || !SceneActor->Actor)
+		{
+			return false;
+		}
+		RootActors.Add(Possessable.GetGuid(), SceneActor->Actor);
+	}
+
+	for (int32 Index = 0; Index < ShotScene->GetPossessableCount(); ++Index)
+	{
+		const FMovieScenePossessable& Possessable = ShotScene->GetPossessable(Index);
+		const FGuid Guid = Possessable.GetGuid();
+		ShotSequence.UnbindPossessableObjects(Guid);
+		if (AActor* const* Actor = RootActors.Find(Guid))
+		{
+			ShotSequence.BindPossessableObject(Guid, **Actor, World.Get());
+			continue;
+		}
+
+		AActor* const* Owner = RootActors.Find(Possessable.GetParent());
+		const UClass* ComponentClass = Possessable.GetPossessedObjectClass();
+		UActorComponent* Component = Owner && ComponentClass && ComponentClass->IsChildOf(UActorComponent::StaticClass())
+			? (*Owner)->FindComponentByClass(const_cast<UClass*>(ComponentClass)) : nullptr;
+		if (!Component)
+		{
+			return false;
+		}
+		ShotSequence.BindPossessableObject(Guid, *Component, *Owner);
+	}
+	return true;
+}
+
+void FAAANKPoseSceneBuild::KeyTransform(FAAANKPoseSceneActor& SceneActor)
+{
+	// An empty transform track would pin the actor to the origin
+	if (SceneActor.TransformKeys.Num() == 0)
+	{
+		return;
+	}
+
+	UMovieScene3DTransformTrack* Track = MovieScene->AddTrack<UMovieScene3DTransformTrack>(SceneActor.Binding);
+	UMovieScene3DTransformSection* Section = CastChecked<UMovieScene3DTransformSection>(Track->CreateNewSection());
+	Track->AddSection(*Section);
+	Section->SetRange(TRange<FFrameNumber>(0, ToTick(TotalFrames + TailFrames)));
+
+	if (SceneActor.bStreamTransform)
+	{
+		FAAANKPoseTransformReader Reader(SceneActor.Folder);
+		StreamTransformKeys(*Section, Reader);
+	}
+	else
+	{
+		WriteTransformKeys(*Section, SceneActor.TransformKeys);
+	}
+
+	AAANKPoseSceneBuild::SetScaleDefaults(*Section, *SceneActor.Actor);
+}
+
+int32 FAAANKPoseSceneBuild::WriteTransformKeys(UMovieScene3DTransformSection& Section, const TArray<FAAANKPoseTransformKey>& Keys)
+{
+	const UMovieScene& OwnerScene = *Section.GetTypedOuter<UMovieScene>();
+	const int32 NumKeys = Keys.Num();
+	TArray<FFrameNumber> Times;
+	Times.Reserve(NumKeys);
+	TArray<FMovieSceneDoubleValue> Values[6];
+	for (TArray<FMovieSceneDoubleValue>& Channel : Values)
+	{
+		Channel.Reserve(NumKeys);
+	}
+
+	for (const FAAANKPoseTransformKey& Key : Keys)
+	{
+		Times.Add(DisplayFrameToTick(OwnerScene, Key.Frame));
+		Values[0].Emplace(Key.Location.X);
+		Values[1].Emplace(Key.Location.Y);
+		Values[2].Emplace(Key.Location.Z);
+		Values[3].Emplace(Key.Rotation.Roll);
+		Values[4].Emplace(Key.Rotation.Pitch);
+		Values[5].Emplace(Key.Rotation.Yaw);
+	}
+
+	// Location X/Y/Z, rotation roll/pitch/yaw, scale X/Y/Z; Set replaces whatever was keyed before
+	TArrayView<FMovieSceneDoubleChannel*> Channels = Section.GetChannelProxy().GetChannels<FMovieSceneDoubleChannel>();
+	for (int32 ChannelIndex = 0; ChannelIndex < 6; ++ChannelIndex)
+	{
+		AAANKPoseSceneBuild::SetCubicKeys(*Channels[ChannelIndex], Times, MoveTemp(Values[ChannelIndex]));
+	}
+	FAAANKPoseBuildTelemetry::AddCounter(FAAANKPoseBuildTelemetry::KeysWritten, NumKeys * 6);
+	return NumKeys * 6;
+}
+
+int32 FAAANKPoseSceneBuild::StreamTransformKeys(UMovieScene3DTransformSection& Section, FAAANKPoseTransformReader& Reader)
+{
+	const UMovieScene& OwnerScene = *Section.GetTypedOuter<UMovieScene>();
+	TArrayView<FMovieSceneDoubleChannel*> Channels = Section.GetChannelProxy().GetChannels<FMovieSceneDoubleChannel>();
+	for (int32 ChannelIndex = 0; ChannelIndex < 6; ++ChannelIndex)
+	{
+		Channels[ChannelIndex]->Reset();
+	}
+
+	// Windows arrive in frame order, so every key lands at the end of its channel
+	int32 NumKeys = 0;
+	TArray<FAAANKPoseTransformKey> Window;
+	while (Reader.NextWindow(Window))
+	{
+		for (int32 ChannelIndex = 0; ChannelIndex < 6; ++ChannelIndex)
+		{
+			TMovieSceneChannelData<FMovieSceneDoubleValue> Data = Channels[ChannelIndex]->GetData();
+			for (const FAAANKPoseTransformKey& Key : Window)
+			{
+				const double Values[6] = { Key.Location.X, Key.Location.Y, Key.Location.Z, Key.Rotation.Roll, Key.Rotation.Pitch, Key.Rotation.Yaw };
+				FMovieSceneDoubleValue Value(Values[ChannelIndex]);
+				Value.InterpMode = RCIM_Cubic;
+				Value.TangentMode = RCTM_Auto;
+				Data.AddKey(DisplayFrameToTick(OwnerScene, Key.Frame), Value);
+			}
+		}
+		NumKeys += Window.Num();
+	}
+
+	for (int32 ChannelIndex = 0; ChannelIndex < 6; ++ChannelIndex)
+	{
+		Channels[ChannelIndex]->AutoSetTangents();
+	}
+	FAAANKPoseBuildTelemetry::AddCounter(FAAANKPoseBuildTelemetry::KeysWritten, NumKeys * 6);
+	return NumKeys * 6;
+}
+
+void FAAANKPoseSceneBuild::KeyAnimations(FAAANKPoseSceneActor& SceneActor)
+{
+	if (SceneActor.AnimationSections.Num() == 0)
+	{
+		return;
+	}
+
+	USkeletalMeshComponent* MeshComponent = SceneActor.Actor->FindComponentByClass<USkeletalMeshComponent>();
+	if (!MeshComponent)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SceneBuild: '%s' has animations but no skeletal mesh"), *SceneActor.Name);
+		return;
+	}
+
+	const FGuid ComponentBinding = BindComponent(SceneActor, MeshComponent);
+	UMovieSceneSkeletalAnimationTrack* Track = MovieScene->AddTrack<UMovieSceneSkeletalAnimationTrack>(ComponentBinding);
+
+	AddAnimationSections(*Track, SceneActor.AnimationSections, TotalFrames + TailFrames);
+}
+
+void FAAANKPoseSceneBuild::AddAnimationSections(UMovieSceneSkeletalAnimationTrack& Track, const TArray<FAAANKPoseAnimationSection>& Sections, int32 DefaultEndFrame)
+{
+	const UMovieScene& OwnerScene = *Track.GetTypedOuter<UMovieScene>();
+	for (const FAAANKPoseAnimationSection& Section : Sections)
+	{
+		const FString AnimPath = FAAANKPoseTrackFolder::ResolveAnimationPath(Section.Name);
+		UAnimSequenceBase* Animation = LoadObject<UAnimSequenceBase>(nullptr, *AnimPath);
+		FAAANKPoseBuildTelemetry::AddCounter(FAAANKPoseBuildTelemetry::AssetsLoaded);
+		if (!Animation)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SceneBuild: Animation '%s' not found at %s"), *Section.Name, *AnimPath);
+			continue;
+		}
+
+		const FFrameNumber Start = DisplayFrameToTick(OwnerScene, Section.StartFrame);
+		const int32 EndFrame = Section.EndFrame > Section.StartFrame ? Section.EndFrame : DefaultEndFrame;
+		UMovieSceneSkeletalAnimationSection* AnimSection = Cast<UMovieSceneSkeletalAnimationSection>(Track.AddNewAnimation(Start, Animation));
+		if (AnimSection)
+		{
+			AnimSection->SetRange(TRange<FFrameNumber>(Start, DisplayFrameToTick(OwnerScene, EndFrame)));
+			AnimSection->Params.PlayRate.Set(Section.SpeedMultiplier);
+		}
+	}
+}
+
+void FAAANKPoseSceneBuild::KeyFocalLength(FAAANKPoseSceneActor& SceneActor)
+{
+	ACineCameraActor* Camera = Cast<ACineCameraActor>(SceneActor.Actor);
+	if (!Camera || SceneActor.FocalLengthKeys.Num() == 0)
+	{
+		return;
+	}
+
+	UCineCameraComponent* CameraComponent = Camera->GetCineCameraComponent();
+	AAANKPoseSceneBuild::RaiseLensLimit(*CameraComponent, SceneActor.FocalLengthKeys);
+
+	const FGuid ComponentBinding = BindComponent(SceneActor, CameraComponent);
+	UMovieSceneFloatTrack* Track = MovieScene->AddTrack<UMovieSceneFloatTrack>(ComponentBinding);
+	Track->SetPropertyNameAndPath(TEXT("CurrentFocalLength"), TEXT("CurrentFocalLength"));
+
+	UMovieSceneFloatSection* Section = CastChecked<UMovieSceneFloatSection>(Track->CreateNewSection());
+	Track->AddSection(*Section);
+	Section->SetRange(TRange<FFrameNumber>(0, ToTick(TotalFrames + TailFrames)));
+
+	WriteFocalLengthKeys(*Section, SceneActor.FocalLengthKeys);
+}
+
+int32 FAAANKPoseSceneBuild::WriteFocalLengthKeys(UMovieSceneFloatSection& Section, const TArray<TPair<int32, float>>& Keys)
+{
+	const UMovieScene& OwnerScene = *Section.GetTypedOuter<UMovieScene>();
+	FMovieSceneFloatChannel* Channel = Section.GetChannelProxy().GetChannel<FMovieSceneFloatChannel>(0);
+	Channel->Reset();
+	TMovieSceneChannelData<FMovieSceneFloatValue> Data = Channel->GetData();
+	for (const TPair<int32, float>& Key : Keys)
+	{
+		FMovieSceneFloatValue Value(Key.Value);
+		Value.InterpMode = RCIM_Cubic;
+		Value.TangentMode = RCTM_Auto;
+		Data.AddKey(DisplayFrameToTick(OwnerScene, Key.Key), Value);
+	}
+	Channel->AutoSetTangents();
+	FAAANKPoseBuildTelemetry::AddCounter(FAAANKPoseBuildTelemetry::KeysWritten, Keys.Num());
+	return Keys.Num();
+}
+
+void FAAANKPoseSceneBuild::RunCameraCuts()
+{
+	// Each shot carries its own cuts
+	if (Shots.Num() > 0)
+	{
+		Advance();
+		return;
+	}
+
+	TArray<FAAANKPoseCameraCut> Cuts;
+	FAAANKPoseTrackFolder::LoadCameraCuts(MovieFolder, Cuts);
+
+	TArray<TPair<FFrameNumber, FGuid>> Resolved;
+	for (const FAAANKPoseCameraCut& Cut : Cuts)
+	{
+		const FAAANKPoseSceneActor* Camera = SceneActors.FindByPredicate([&Cut](const FAAANKPoseSceneActor& SceneActor)
+		{
+			return SceneActor.Name == Cut.Camera;
+		});
+		if (!Camera || !Camera->Binding.IsValid())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SceneBuild: Camera '%s' not found, skipping cut"), *Cut.Camera);
+			continue;
+		}
+		Resolved.Emplace(ToTick(FMath::FloorToDouble(Cut.Time * Meta.Fps)), Camera->Binding);
+	}
+
+	if (Resolved.Num() > 0)
+	{
+		UMovieSceneCameraCutTrack* Track = Cast<UMovieSceneCameraCutTrack>(MovieScene->GetCameraCutTrack());
+		if (!Track)
+		{
+			Track = Cast<UMovieSceneCameraCutTrack>(MovieScene->AddCameraCutTrack(UMovieSceneCameraCutTrack::StaticClass()));
+		}
+
+		const FFrameNumber End = ToTick(TotalFrames + TailFrames);
+		for (int32 Index = 0; Index < Resolved.Num(); ++Index)
+		{
+			UMovieSceneCameraCutSection* Section = Track->AddNewCameraCut(UE::MovieScene::FRelativeObjectBindingID(Resolved[Index].Value), Resolved[Index].Key);
+			const FFrameNumber SectionEnd = Index + 1 < Resolved.Num() ? Resolved[Index + 1].Key : End;
+			Section->SetRange(TRange<FFrameNumber>(Resolved[Index].Key, SectionEnd));
+		}
+		UE_LOG(LogTemp, Log, TEXT("SceneBuild: Applied %d camera cut(s)"), Resolved.Num());
+	}
+
+	Advance();
+}
+
+void FAAANKPoseSceneBuild::RunFinalize()
+{
+	MovieScene->SetPlaybackRange(TRange<FFrameNumber>(0, ToTick(TotalFrames + TailFrames)));
+	FAAANKPoseBuildCache::StampSequence(Sequence, MovieFolder, Fingerprint);
+	Sequence->MarkPackageDirty();
+
+	UE_LOG(LogTemp, Log, TEXT("SceneBuild: Finished %s (%d actors, %d frames, %d shots)"), *Sequence->GetName(), SceneActors.Num(), TotalFrames + TailFrames, Shots.Num());
+	Advance();
+}
+
+void FAAANKPoseSceneBuild::RunPrewarm()
+{
+	if (PrewarmTimeoutSeconds <= 0.0f)
+	{
+		Advance();
+		return;
+	}
+
+	// First unit starts the requests; later ones wait for them a unit at a time, or all at once when blocking
+	if (Cursor++ == 0)
+	{
+		TArray<AActor*> Actors;
+		for (const FAAANKPoseSceneActor& SceneActor : SceneActors)
+		{
+			if (SceneActor.Actor)
+			{
+				Actors.Add(SceneActor.Actor);
+			}
+		}
+		if (bReusedSequence)
+		{
+			Actors = FAAANKPoseSequencePrewarm::FindBoundActors(*Sequence, *World);
+		}
+		Prewarm.Begin(Sequence, Actors, PrewarmTimeoutSeconds);
+		return;
+	}
+
+	if (bBlocking)
+	{
+		Prewarm.Wait();
+	}
+	if (Prewarm.Poll())
+	{
+		Advance();
+	}
+}
@@ -0,0 +1,163 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseSceneBuildExecutor.h"
+#include "AAANKPoseBuildTelemetry.h"
+#include "AAANKPoseSpawnLibrary.h"
+#include "LevelSequence.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+
+namespace AAANKPoseSceneBuildExecutor
+{
+	static EAAANKPoseBuildOutcome GetOutcome(const FAAANKPoseSceneBuild& Build)
+	{
+		if (!Build.Succeeded())
+		{
+			return EAAANKPoseBuildOutcome::Failed;
+		}
+		return Build.ReusedSequence() ? EAAANKPoseBuildOutcome::Skipped : EAAANKPoseBuildOutcome::Completed;
+	}
+}
+
+UAAANKPoseSceneBuildExecutor* UAAANKPoseSceneBuildExecutor::StartSceneBuild(UObject* WorldContextObject, const FString& MovieFolder, float BudgetMilliseconds,
+	EAAANKPoseShotPartition Partition, float ShotWindowSeconds, bool bForceRebuild)
+{
+	UWorld* World = UAAANKPoseSpawnLibrary::ResolveWorld(WorldContextObject);
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("StartSceneBuild: No world to build in"));
+		return nullptr;
+	}
+
+	UAAANKPoseSceneBuildExecutor* Executor = NewObject<UAAANKPoseSceneBuildExecutor>(GetTransientPackage());
+	Executor->Build = MakeUnique<FAAANKPoseSceneBuild>(MovieFolder, World);
+	Executor->Build->SetShotPartition(Partition, ShotWindowSeconds);
+	Executor->Build->SetUseBuildCache(!bForceRebuild);
+	Executor->SetBudgetMilliseconds(BudgetMilliseconds);
+	Executor->StartSeconds = FPlatformTime::Seconds();
+	FAAANKPoseBuildTelemetry::BeginBuild(FPaths::GetCleanFilename(MovieFolder));
+
+	// Rooted while ticking so a caller that drops the handle doesn't abort the build
+	Executor->AddToRoot();
+	Executor->TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(Executor, &UAAANKPoseSceneBuildExecutor::TickBuild));
+
+	UE_LOG(LogTemp, Log, TEXT("StartSceneBuild: Building '%s' in %.1f ms slices"), *MovieFolder, Executor->BudgetMilliseconds);
+	return Executor;
+}
+
+ULevelSequence* UAAANKPoseSceneBuildExecutor::BuildSceneNow(UObject* WorldContextObject, const FString& MovieFolder,
+	EAAANKPoseShotPartition Partition, float ShotWindowSeconds, bool bForceRebuild)
+{
+	UWorld* World = UAAANKPoseSpawnLibrary::ResolveWorld(WorldContextObject);
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("BuildSceneNow: No world to build in"));
+		return nullptr;
+	}
+
+	FAAANKPoseBuildTelemetry::BeginBuild(FPaths::GetCleanFilename(MovieFolder));
+	FAAANKPoseSceneBuild SceneBuild(MovieFolder, World);
+	SceneBuild.SetShotPartition(Partition, ShotWindowSeconds);
+	SceneBuild.SetUseBuildCache(!bForceRebuild);
+	const bool bSucceeded = SceneBuild.RunToCompletion();
+	FAAANKPoseBuildTelemetry::SetOutcome(AAANKPoseSceneBuildExecutor::GetOutcome(SceneBuild));
+	FAAANKPoseBuildTelemetry::EndBuild();
+	return bSucceeded ? SceneBuild.GetSequence() : nullptr;
+}
+
+void UAAANKPoseSceneBuildExecutor::Cancel()
+{
+	if (IsRunning())
+	{
+		Build->Cancel();
+		Finish();
+	}
+}
+
+bool UAAANKPoseSceneBuildExecutor::IsRunning() const
+{
+	return Build.IsValid() && TickerHandle.IsValid();
+}
+
+float UAAANKPoseSceneBuildExecutor::GetProgress() const
+{
+	return Build.IsValid() ? Build->GetProgress() : 0.0f;
+}
+
+EAAANKPoseSceneBuildStep UAAANKPoseSceneBuildExecutor::GetCurrentStep() const
+{
+	return Build.IsValid() ? Build->GetStep() : EAAANKPoseSceneBuildStep::Done;
+}
+
+ULevelSequence* UAAANKPoseSceneBuildExecutor::GetSequence() const
+{
+	return Build.IsValid() ? Build->GetSequence() : nullptr;
+}
+
+bool UAAANKPoseSceneBuildExecutor::ReusedSequence() const
+{
+	return Build.IsValid() && Build->ReusedSequence();
+}
+
+TArray<ULevelSequence*> UAAANKPoseSceneBuildExecutor::GetShotSequences() const
+{
+	TArray<ULevelSequence*> Result;
+	if (Build.IsValid())
+	{
+		for (ULevelSequence* ShotSequence : Build->GetShotSequences())
+		{
+			Result.Add(ShotSequence);
+		}
+	}
+	return Result;
+}
+
+FString UAAANKPoseSceneBuildExecutor::GetError() const
+{
+	return Build.IsValid() ? Build->GetError() : FString();
+}
+
+void UAAANKPoseSceneBuildExecutor::SetBudgetMilliseconds(float InBudgetMilliseconds)
+{
+	BudgetMilliseconds = FMath::Max(InBudgetMilliseconds, 0.1f);
+}
+
+void UAAANKPoseSceneBuildExecutor::BeginDestroy()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+	Super::BeginDestroy();
+}
+
+bool UAAANKPoseSceneBuildExecutor::TickBuild(float DeltaTime)
+{
+	++FramesUsed;
+	if (Build->Tick(FPlatformTime::Seconds() + BudgetMilliseconds / 1000.0))
+	{
+		Finish();
+		return false;
+	}
+	return true;
+}
+
+void UAAANKPoseSceneBuildExecutor::Finish()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+
+	const bool bSucceeded = Build->Succeeded();
+	UE_LOG(LogTemp, Log, TEXT("StartSceneBuild: '%s' %s after %.2f s over %d frames"),
+		*Build->GetMovieFolder(), bSucceeded ? TEXT("finished") : TEXT("stopped"), FPlatformTime::Seconds() - StartSeconds, FramesUsed);
+
+	FAAANKPoseBuildTelemetry::SetOutcome(AAANKPoseSceneBuildExecutor::GetOutcome(*Build));
+	FAAANKPoseBuildTelemetry::EndBuild();
+	RemoveFromRoot();
+	OnFinished.Broadcast(bSucceeded, Build->GetSequence());
+}
@@ -0,0 +1,227 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseSequencePrewarm.h"
+#include "AAANKPoseBuildCache.h"
+#include "AAANKPoseSpawnLibrary.h"
+#include "AudioDevice.h"
+#include "Compilation/MovieSceneCompiledDataManager.h"
+#include "Components/PrimitiveComponent.h"
+#include "ContentStreaming.h"
+#include "Engine/Engine.h"
+#include "HAL/PlatformProcess.h"
+#include "LevelSequence.h"
+#include "MovieScene.h"
+#include "Sections/MovieSceneAudioSection.h"
+#include "Sections/MovieSceneSkeletalAnimationSection.h"
+#include "Sections/MovieSceneSubSection.h"
+#include "Sound/SoundWave.h"
+
+#if WITH_EDITOR
+#include "AssetCompilingManager.h"
+#include "ShaderCompiler.h"
+#endif
+
+
+namespace AAANKPoseSequencePrewarm
+{
+	/** Sequence plus every subsequence below it, each once */
+	static void GatherSequences(UMovieSceneSequence* Sequence, TArray<UMovieSceneSequence*>& OutSequences)
+	{
+		if (!Sequence || !Sequence->GetMovieScene() || OutSequences.Contains(Sequence))
+		{
+			return;
+		}
+		OutSequences.Add(Sequence);
+		for (UMovieSceneSection* Section : Sequence->GetMovieScene()->GetAllSections())
+		{
+			if (UMovieSceneSubSection* SubSection = Cast<UMovieSceneSubSection>(Section))
+			{
+				GatherSequences(SubSection->GetSequence(), OutSequences);
+			}
+		}
+	}
+}
+
+void FAAANKPoseSequencePrewarm::Begin(ULevelSequence* Sequence, TConstArrayView<AActor*> Actors, float InTimeoutSeconds)
+{
+	Result = FAAANKPosePrewarmResult();
+	Assets.Reset();
+	StartSeconds = FPlatformTime::Seconds();
+	BeginFrame = GFrameCounter;
+	TimeoutSeconds = FMath::Max(InTimeoutSeconds, 0.0f);
+	bDone = false;
+
+	if (!Sequence)
+	{
+		Complete();
+		return;
+	}
+
+	// Compiling the root compiles the whole hierarchy; doing it now keeps it off the first evaluated frame
+	UMovieSceneCompiledDataManager::GetPrecompiledData()->Compile(Sequence);
+
+	TArray<UMovieSceneSequence*> Sequences;
+	AAANKPoseSequencePrewarm::GatherSequences(Sequence, Sequences);
+	Result.SequencesCompiled = Sequences.Num();
+
+	FAudioDeviceHandle AudioDevice = GEngine ? GEngine->GetMainAudioDevice() : FAudioDeviceHandle();
+	for (UMovieSceneSequence* Each : Sequences)
+	{
+		for (UMovieSceneSection* Section : Each->GetMovieScene()->GetAllSections())
+		{
+			if (const UMovieSceneSkeletalAnimationSection* AnimSection = Cast<UMovieSceneSkeletalAnimationSection>(Section))
+			{
+				if (AnimSection->Params.Animation && !Assets.Contains(AnimSection->Params.Animation))
+				{
+					Assets.Add(AnimSection->Params.Animation);
+				}
+			}
+			else if (const UMovieSceneAudioSection* AudioSection = Cast<UMovieSceneAudioSection>(Section))
+			{
+				USoundWave* SoundWave = Cast<USoundWave>(AudioSection->GetSound());
+				if (SoundWave && !Assets.Contains(SoundWave))
+				{
+					Assets.Add(SoundWave);
+					// Synchronous, so the first audible frame doesn't wait on decoding
+					if (AudioDevice)
+					{
+						AudioDevice->Precache(SoundWave, /*bSynchronous*/ true, /*bTrackMemory*/ true, /*bForceFullDecompression*/ false);
+					}
+				}
+			}
+		}
+	}
+	Result.AssetsReferenced = Assets.Num();
+
+	// Cinematic residency for the length of the wait: full mips and mesh LODs, not what the camera would pick
+	const float Seconds = static_cast<float>(TimeoutSeconds);
+	for (AActor* Actor : Actors)
+	{
+		if (!Actor)
+		{
+			continue;
+		}
+		Actor->PrestreamTextures(Seconds, /*bEnableStreaming*/ true);
+		Actor->ForEachComponent<UPrimitiveComponent>(false, [Seconds](UPrimitiveComponent* Component)
+		{
+			Component->PrestreamMeshLODs(Seconds);
+		});
+		++Result.ActorsPrestreamed;
+	}
+}
+
+int32 FAAANKPoseSequencePrewarm::CountPending() const
+{
+	int32 Pending = IStreamingManager::Get().GetNumWantingResources();
+#if WITH_EDITOR
+	// Animations, meshes and textures compile asynchronously in the editor; so do their shaders
+	Pending += FAssetCompilingManager::Get().GetNumRemainingAssets();
+	if (GShaderCompilingManager)
+	{
+		Pending += GShaderCompilingManager->GetNumRemainingJobs();
+	}
+#endif
+	return Pending;
+}
+
+bool FAAANKPoseSequencePrewarm::Poll()
+{
+	if (bDone)
+	{
+		return true;
+	}
+
+	// Streaming only registers the requests on its next update, so an empty queue means nothing before then
+	const bool bQueueSettled = GFrameCounter > BeginFrame + 1;
+	const bool bTimedOut = FPlatformTime::Seconds() - StartSeconds >= TimeoutSeconds;
+	if ((bQueueSettled && CountPending() == 0) || bTimedOut)
+	{
+		Complete();
+	}
+	return bDone;
+}
+
+void FAAANKPoseSequencePrewarm::Wait()
+{
+	if (bDone)
+	{
+		return;
+	}
+
+	const double Deadline = StartSeconds + TimeoutSeconds;
+
+#if WITH_EDITOR
+	// FinishAllCompilation has no time limit, so drain the compile queues ourselves until the deadline
+	auto NumCompiling = []()
+	{
+		return FAssetCompilingManager::Get().GetNumRemainingAssets() + (GShaderCompilingManager ? GShaderCompilingManager->GetNumRemainingJobs() : 0);
+	};
+	while (NumCompiling() > 0 && FPlatformTime::Seconds() < Deadline)
+	{
+		FAssetCompilingManager::Get().ProcessAsyncTasks(/*bLimitExecutionTime*/ true);
+		if (GShaderCompilingManager)
+		{
+			GShaderCompilingManager->ProcessAsyncResults(/*bLimitExecutionTime*/ true, /*bBlockOnGlobalShaderCompletion*/ false);
+		}
+		FPlatformProcess::Sleep(0.01f);
+	}
+#endif
+
+	// StreamAllResources treats 0 as no limit, so always pass a positive budget
+	const double Remaining = Deadline - FPlatformTime::Seconds();
+	IStreamingManager::Get().StreamAllResources(static_cast<float>(FMath::Max(Remaining, 0.01)));
+	Complete();
+}
+
+void FAAANKPoseSequencePrewarm::Complete()
+{
+	Result.Pending = CountPending();
+	Result.bResident = Result.Pending == 0;
+	Result.Seconds = static_cast<float>(FPlatformTime::Seconds() - StartSeconds);
+	Assets.Reset();
+	bDone = true;
+
+	if (Result.bResident)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Prewarm: %d sequence(s) compiled, %d asset(s) and %d actor(s) resident in %.2f s"),
+			Result.SequencesCompiled, Result.AssetsReferenced, Result.ActorsPrestreamed, Result.Seconds);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Prewarm: Gave up after %.2f s with %d request(s) pending; first playback may still hitch"), Result.Seconds, Result.Pending);
+	}
+}
+
+FAAANKPosePrewarmResult FAAANKPoseSequencePrewarm::PrewarmNow(ULevelSequence* Sequence, TConstArrayView<AActor*> Actors, float TimeoutSeconds)
+{
+	FAAANKPoseSequencePrewarm Prewarm;
+	Prewarm.Begin(Sequence, Actors, TimeoutSeconds);
+	Prewarm.Wait();
+	return Prewarm.GetResult();
+}
+
+TArray<AActor*> FAAANKPoseSequencePrewarm::FindBoundActors(const ULevelSequence& Sequence, UWorld& World)
+{
+	TArray<AActor*> Actors;
+	if (!FAAANKPoseBuildCache::ResolveRootBindings(Sequence, World, Actors))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("FindBoundActors: Some bindings of %s don't resolve; prestreaming the %d that do"), *Sequence.GetName(), Actors.Num());
+	}
+	return Actors;
+}
+
+void FAAANKPoseSequencePrewarm::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObjects(Assets);
+}
+
+FAAANKPosePrewarmResult UAAANKPosePrewarmLibrary::PrewarmSequence(UObject* WorldContextObject, ULevelSequence* Sequence, float TimeoutSeconds)
+{
+	UWorld* World = UAAANKPoseSpawnLibrary::ResolveWorld(WorldContextObject);
+	if (!Sequence || !World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PrewarmSequence: Needs a sequence and a world"));
+		return FAAANKPosePrewarmResult();
+	}
+	return FAAANKPoseSequencePrewarm::PrewarmNow(Sequence, FAAANKPoseSequencePrewarm::FindBoundActors(*Sequence, *World), TimeoutSeconds);
+}
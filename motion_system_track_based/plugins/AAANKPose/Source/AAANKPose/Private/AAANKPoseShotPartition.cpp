@@ -0,0 +1,230 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseShotPartition.h"
+#include "AAANKPoseSceneBuild.h"
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+#include "Misc/SecureHash.h"
+
+
+namespace AAANKPoseShotPartition
+{
+	template <typename T>
+	static void HashValue(FSHA1& Hash, const T& Value)
+	{
+		Hash.Update(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+	}
+
+	static void HashString(FSHA1& Hash, const FString& Value)
+	{
+		HashValue(Hash, Value.Len());
+		Hash.UpdateWithString(*Value, Value.Len());
+	}
+
+	/** Everything the shot's subsequence is built from, so equal hashes mean an identical shot */
+	static FString HashShot(const FAAANKPoseShot& Shot, TConstArrayView<FAAANKPoseSceneActor> SceneActors, int32 Fps)
+	{
+		FSHA1 Hash;
+		HashValue(Hash, Fps);
+		HashValue(Hash, Shot.StartFrame);
+		HashValue(Hash, Shot.EndFrame);
+		for (const TPair<int32, FString>& Cut : Shot.Cuts)
+		{
+			HashValue(Hash, Cut.Key);
+			HashString(Hash, Cut.Value);
+		}
+
+		for (const FAAANKPoseShotActor& ShotActor : Shot.Actors)
+		{
+			const FAAANKPoseSceneActor& SceneActor = SceneActors[ShotActor.ActorIndex];
+			HashString(Hash, SceneActor.Name);
+			HashValue(Hash, SceneActor.Type);
+			for (const FAAANKPoseTransformKey& Key : ShotActor.TransformKeys)
+			{
+				HashValue(Hash, Key.Frame);
+				HashValue(Hash, Key.Location);
+				HashValue(Hash, Key.Rotation);
+			}
+			for (const FAAANKPoseAnimationSection& Section : ShotActor.AnimationSections)
+			{
+				HashValue(Hash, Section.StartFrame);
+				HashValue(Hash, Section.EndFrame);
+				HashValue(Hash, Section.SpeedMultiplier);
+				HashString(Hash, Section.Name);
+			}
+			for (const TPair<int32, float>& Key : ShotActor.FocalLengthKeys)
+			{
+				HashValue(Hash, Key.Key);
+				HashValue(Hash, Key.Value);
+			}
+		}
+
+		Hash.Final();
+		uint8 Digest[FSHA1::DigestSize];
+		Hash.GetHash(Digest);
+		return BytesToHex(Digest, FSHA1::DigestSize);
+	}
+
+	/** Windows of a chunked track around the shot, so the key on each side is available to SliceKeys */
+	static void LoadShotWindow(const FAAANKPoseSceneActor& SceneActor, const FAAANKPoseTrackChunkIndex& Index, const FAAANKPoseShot& Shot, TArray<FAAANKPoseTransformKey>& OutKeys)
+	{
+		const int32 FirstChunk = FMath::Max(Index.FindChunk(Shot.StartFrame) - 1, 0);
+		const int32 LastChunk = FMath::Min(Index.FindChunk(Shot.EndFrame) + 1, Index.Chunks.Num() - 1);
+		FAAANKPoseTrackFolder::LoadTransformWindow(SceneActor.Folder, Index, Index.Chunks[FirstChunk].StartFrame, Index.Chunks[LastChunk].EndFrame, OutKeys);
+	}
+}
+
+void FAAANKPoseShotPartition::MakeShots(EAAANKPoseShotPartition Mode, const TArray<FAAANKPoseCameraCut>& Cuts, int32 Fps, float WindowSeconds, int32 EndFrame, TArray<FAAANKPoseShot>& OutShots)
+{
+	OutShots.Reset();
+	if (Mode == EAAANKPoseShotPartition::None || EndFrame <= 0)
+	{
+		return;
+	}
+
+	// Same frame rounding as the single-sequence camera cuts
+	TArray<TPair<int32, FString>> CutFrames;
+	for (const FAAANKPoseCameraCut& Cut : Cuts)
+	{
+		CutFrames.Emplace(FMath::FloorToInt32(Cut.Time * Fps), Cut.Camera);
+	}
+
+	TArray<int32> Boundaries;
+	if (Mode == EAAANKPoseShotPartition::CameraCuts)
+	{
+		for (const TPair<int32, FString>& Cut : CutFrames)
+		{
+			if (Cut.Key > 0 && Cut.Key < EndFrame)
+			{
+				Boundaries.AddUnique(Cut.Key);
+			}
+		}
+	}
+	else
+	{
+		const int32 WindowFrames = FMath::Max(FMath::RoundToInt32(WindowSeconds * Fps), 1);
+		for (int32 Frame = WindowFrames; Frame < EndFrame; Frame += WindowFrames)
+		{
+			Boundaries.Add(Frame);
+		}
+	}
+	Boundaries.Sort();
+	Boundaries.Add(EndFrame);
+
+	int32 Start = 0;
+	for (const int32 End : Boundaries)
+	{
+		FAAANKPoseShot& Shot = OutShots.AddDefaulted_GetRef();
+		Shot.StartFrame = Start;
+		Shot.EndFrame = End;
+
+		// The cut already running when the shot starts, then every cut inside it
+		for (int32 Index = 0; Index < CutFrames.Num(); ++Index)
+		{
+			const int32 CutFrame = CutFrames[Index].Key;
+			const bool bActiveAtStart = CutFrame <= Start && (Index + 1 == CutFrames.Num() || CutFrames[Index + 1].Key > Start);
+			if (bActiveAtStart || (CutFrame > Start && CutFrame < End))
+			{
+				Shot.Cuts.Emplace(FMath::Max(CutFrame, Start), CutFrames[Index].Value);
+			}
+		}
+		Start = End;
+	}
+}
+
+void FAAANKPoseShotPartition::PrepareShots(TConstArrayView<FAAANKPoseSceneActor> SceneActors, int32 Fps, TArray<FAAANKPoseShot>& InOutShots)
+{
+	// Indices are read once here; each job then opens only the windows its shot touches.
+	// Actor pointers are only looked at on the game thread.
+	TArray<FAAANKPoseTrackChunkIndex> Indices;
+	TBitArray<> Included(false, SceneActors.Num());
+	Indices.SetNum(SceneActors.Num());
+	for (int32 ActorIndex = 0; ActorIndex < SceneActors.Num(); ++ActorIndex)
+	{
+		Included[ActorIndex] = SceneActors[ActorIndex].Type != EAAANKPoseSceneActorType::Unsupported && SceneActors[ActorIndex].Actor != nullptr;
+		if (SceneActors[ActorIndex].bStreamTransform)
+		{
+			FAAANKPoseTrackFolder::LoadTransformIndex(SceneActors[ActorIndex].Folder, Indices[ActorIndex]);
+		}
+	}
+
+	ParallelFor(InOutShots.Num(), [&](int32 ShotIndex)
+	{
+		FAAANKPoseShot& Shot = InOutShots[ShotIndex];
+		Shot.Actors.Reset();
+
+		for (int32 ActorIndex = 0; ActorIndex < SceneActors.Num(); ++ActorIndex)
+		{
+			const FAAANKPoseSceneActor& SceneActor = SceneActors[ActorIndex];
+			if (!Included[ActorIndex])
+			{
+				continue;
+			}
+
+			FAAANKPoseShotActor& ShotActor = Shot.Actors.AddDefaulted_GetRef();
+			ShotActor.ActorIndex = ActorIndex;
+
+			if (SceneActor.bStreamTransform && Indices[ActorIndex].IsValid())
+			{
+				TArray<FAAANKPoseTransformKey> Window;
+				AAANKPoseShotPartition::LoadShotWindow(SceneActor, Indices[ActorIndex], Shot, Window);
+				SliceKeys(Window, Shot.StartFrame, Shot.EndFrame, ShotActor.TransformKeys);
+			}
+			else
+			{
+				SliceKeys(SceneActor.TransformKeys, Shot.StartFrame, Shot.EndFrame, ShotActor.TransformKeys);
+			}
+
+			for (const FAAANKPoseAnimationSection& Section : SceneActor.AnimationSections)
+			{
+				const bool bOpenEnded = Section.EndFrame <= Section.StartFrame;
+				if (Section.StartFrame < Shot.EndFrame && (bOpenEnded || Section.EndFrame > Shot.StartFrame))
+				{
+					ShotActor.AnimationSections.Add(Section);
+				}
+			}
+
+			// Focal length keys are sparse; keep the neighbours outside the shot like transforms
+			int32 First = INDEX_NONE;
+			int32 Last = INDEX_NONE;
+			for (int32 KeyIndex = 0; KeyIndex < SceneActor.FocalLengthKeys.Num(); ++KeyIndex)
+			{
+				const int32 Frame = SceneActor.FocalLengthKeys[KeyIndex].Key;
+				if (Frame < Shot.StartFrame || First == INDEX_NONE)
+				{
+					First = KeyIndex;
+				}
+				Last = KeyIndex;
+				if (Frame >= Shot.EndFrame)
+				{
+					break;
+				}
+			}
+			if (First != INDEX_NONE)
+			{
+				ShotActor.FocalLengthKeys.Append(&SceneActor.FocalLengthKeys[First], Last - First + 1);
+			}
+		}
+
+		Shot.ContentHash = AAANKPoseShotPartition::HashShot(Shot, SceneActors, Fps);
+	});
+}
+
+void FAAANKPoseShotPartition::SliceKeys(TConstArrayView<FAAANKPoseTransformKey> Keys, int32 StartFrame, int32 EndFrame, TArray<FAAANKPoseTransformKey>& OutKeys)
+{
+	OutKeys.Reset();
+	if (Keys.Num() == 0)
+	{
+		return;
+	}
+
+	// Last key at or before the start, first key at or after the end
+	int32 First = Algo::UpperBoundBy(Keys, StartFrame, &FAAANKPoseTransformKey::Frame) - 1;
+	int32 Last = Algo::LowerBoundBy(Keys, EndFrame, &FAAANKPoseTransformKey::Frame);
+	First = FMath::Max(First, 0);
+	Last = FMath::Min(Last, Keys.Num() - 1);
+	if (Last >= First)
+	{
+		OutKeys.Append(Keys.Slice(First, Last - First + 1));
+	}
+}
@@ -0,0 +1,181 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseSpawnLibrary.h"
+#include "AAANKPoseBuildTelemetry.h"
+#include "AAANKPoseMannequin.h"
+#include "AAANKPoseQuietMode.h"
+#include "Algo/Count.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Materials/MaterialInterface.h"
+
+#if WITH_EDITOR
+#include "Editor.h"
+#endif
+
+
+namespace AAANKPoseSpawnLibrary
+{
+	static UObject* LoadCached(TMap<FSoftObjectPath, UObject*>& Cache, const FSoftObjectPath& Path)
+	{
+		if (Path.IsNull())
+		{
+			return nullptr;
+		}
+		if (UObject** Found = Cache.Find(Path))
+		{
+			return *Found;
+		}
+
+		UObject* Loaded = Path.TryLoad();
+		FAAANKPoseBuildTelemetry::AddCounter(FAAANKPoseBuildTelemetry::AssetsLoaded);
+		if (!Loaded)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SpawnActorsBatch: Could not load '%s'"), *Path.ToString());
+		}
+		Cache.Add(Path, Loaded);
+		return Loaded;
+	}
+
+	static void ApplyMesh(AActor* Actor, UObject* MeshAsset, const FRotator& MeshRotation, const TArray<UMaterialInterface*>& Materials)
+	{
+		UMeshComponent* MeshComponent = nullptr;
+
+		if (AAAANKPoseMannequin* Mannequin = Cast<AAAANKPoseMannequin>(Actor))
+		{
+			Mannequin->SetupMannequin(Cast<USkeletalMesh>(MeshAsset), MeshRotation, TArray<FName>());
+			MeshComponent = Mannequin->GetMesh();
+		}
+		else if (UStaticMesh* StaticMesh = Cast<UStaticMesh>(MeshAsset))
+		{
+			if (UStaticMeshComponent* Component = Actor->FindComponentByClass<UStaticMeshComponent>())
+			{
+				Component->SetStaticMesh(StaticMesh);
+				Component->SetRelativeRotation(MeshRotation);
+				MeshComponent = Component;
+			}
+		}
+		else if (USkeletalMesh* SkeletalMesh = Cast<USkeletalMesh>(MeshAsset))
+		{
+			if (USkeletalMeshComponent* Component = Actor->FindComponentByClass<USkeletalMeshComponent>())
+			{
+				Component->SetSkeletalMeshAsset(SkeletalMesh);
+				Component->SetRelativeRotation(MeshRotation);
+				MeshComponent = Component;
+			}
+		}
+		else
+		{
+			MeshComponent = Actor->FindComponentByClass<UMeshComponent>();
+		}
+
+		if (!MeshComponent)
+		{
+			return;
+		}
+		for (int32 Slot = 0; Slot < Materials.Num(); ++Slot)
+		{
+			if (Materials[Slot])
+			{
+				MeshComponent->SetMaterial(Slot, Materials[Slot]);
+			}
+		}
+	}
+}
+
+UWorld* UAAANKPoseSpawnLibrary::ResolveWorld(UObject* WorldContextObject)
+{
+	if (WorldContextObject)
+	{
+		return GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull);
+	}
+#if WITH_EDITOR
+	if (GEditor)
+	{
+		return GEditor->GetEditorWorldContext().World();
+	}
+#endif
+	return nullptr;
+}
+
+TArray<AActor*> UAAANKPoseSpawnLibrary::SpawnActorsBatch(UObject* WorldContextObject, const TArray<FAAANKPoseSpawnDescriptor>& Descriptors)
+{
+	using namespace AAANKPoseSpawnLibrary;
+
+	TArray<AActor*> Actors;
+	Actors.SetNumZeroed(Descriptors.Num());
+
+	UWorld* World = ResolveWorld(WorldContextObject);
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SpawnActorsBatch: No world to spawn into"));
+		return Actors;
+	}
+
+	FAAANKPoseQuietScope QuietScope;
+	TMap<FSoftObjectPath, UObject*> AssetCache;
+	TArray<UMaterialInterface*> Materials;
+
+	// Pass 1: spawn deferred and configure while nothing has been constructed yet
+	for (int32 Index = 0; Index < Descriptors.Num(); ++Index)
+	{
+		const FAAANKPoseSpawnDescriptor& Descriptor = Descriptors[Index];
+		if (!Descriptor.ActorClass)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SpawnActorsBatch: Descriptor %d ('%s') has no class"), Index, *Descriptor.Label);
+			continue;
+		}
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.bDeferConstruction = true;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParams.ObjectFlags |= RF_Transactional;
+
+		AActor* Actor = World->SpawnActor(Descriptor.ActorClass, &Descriptor.Transform, SpawnParams);
+		if (!Actor)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SpawnActorsBatch: Failed to spawn '%s'"), *Descriptor.Label);
+			continue;
+		}
+
+		for (const FName& Tag : Descriptor.Tags)
+		{
+			Actor->Tags.AddUnique(Tag);
+		}
+
+		Materials.Reset();
+		for (const TSoftObjectPtr<UMaterialInterface>& Material : Descriptor.Materials)
+		{
+			Materials.Add(Cast<UMaterialInterface>(LoadCached(AssetCache, Material.ToSoftObjectPath())));
+		}
+		ApplyMesh(Actor, LoadCached(AssetCache, Descriptor.Mesh.ToSoftObjectPath()), Descriptor.MeshRotation, Materials);
+
+#if WITH_EDITOR
+		if (!Descriptor.Label.IsEmpty())
+		{
+			Actor->SetActorLabel(Descriptor.Label, /*bMarkDirty*/ false);
+		}
+#endif
+		Actors[Index] = Actor;
+	}
+
+	// Pass 2: construction scripts and component registration for the whole batch
+	for (int32 Index = 0; Index < Descriptors.Num(); ++Index)
+	{
+		if (Actors[Index])
+		{
+			Actors[Index]->FinishSpawning(Descriptors[Index].Transform);
+		}
+	}
+
+	World->MarkPackageDirty();
+	FAAANKPoseBuildTelemetry::AddCounter(FAAANKPoseBuildTelemetry::ActorsSpawned, Actors.Num() - Algo::Count(Actors, nullptr));
+
+	UE_LOG(LogTemp, Log, TEXT("SpawnActorsBatch: Spawned %d/%d actors (%d assets loaded)"),
+		Actors.Num() - Algo::Count(Actors, nullptr), Descriptors.Num(), AssetCache.Num());
+	return Actors;
+}
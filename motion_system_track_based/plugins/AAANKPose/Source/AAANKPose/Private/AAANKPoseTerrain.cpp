@@ -0,0 +1,251 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseTerrain.h"
+#include "AAANKPoseMath.h"
+#include "AAANKPoseSpawnLibrary.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Landscape.h"
+#include "LandscapeProxy.h"
+#include "Materials/MaterialInterface.h"
+
+
+namespace AAANKPoseTerrain
+{
+	/** Quads per landscape component: 2x2 sections of 63 quads */
+	static const int32 ComponentQuads = 126;
+	static const int32 MaxComponents = 32;
+
+	/** Rows per parallel task, so per-task scratch buffers are reused across rows */
+	static const int32 RowsPerTask = 16;
+
+	template <typename RowBodyType>
+	static void ForEachRowBlock(int32 NumRows, RowBodyType&& RowBody)
+	{
+		const int32 NumTasks = FMath::DivideAndRoundUp(NumRows, RowsPerTask);
+		ParallelFor(NumTasks, [&](int32 Task)
+		{
+			TArray<float> Scratch;
+			TArray<float> Row;
+			const int32 End = FMath::Min((Task + 1) * RowsPerTask, NumRows);
+			for (int32 Y = Task * RowsPerTask; Y < End; ++Y)
+			{
+				RowBody(Y, Scratch, Row);
+			}
+		});
+	}
+
+	/** Canyon path in grid samples, densified along a spline when asked */
+	static TArray<FVector2f> ToGridPath(const FAAANKPoseCanyonPath& Canyon, float Spacing)
+	{
+		TArray<FVector2f> Path;
+		if (Canyon.bSmooth && Canyon.Points.Num() >= 3)
+		{
+			// Segments an eighth of the width long follow the curve closely; every segment costs a pass over its rows
+			TArray<AAANKPoseMath::FSplineSample> Samples;
+			AAANKPoseMath::SampleSplinePath(Canyon.Points, FMath::Max(Spacing, Canyon.Width / 8.0f), /*bClosed*/ false, Samples);
+			Path.Reserve(Samples.Num() + 1);
+			for (const AAANKPoseMath::FSplineSample& Sample : Samples)
+			{
+				Path.Emplace(Sample.Position.X / Spacing, Sample.Position.Y / Spacing);
+			}
+			// Sampling stops short of the last point
+			Path.Emplace(Canyon.Points.Last().X / Spacing, Canyon.Points.Last().Y / Spacing);
+		}
+		else
+		{
+			for (const FVector& Point : Canyon.Points)
+			{
+				Path.Emplace(Point.X / Spacing, Point.Y / Spacing);
+			}
+		}
+		return Path;
+	}
+}
+
+int32 FAAANKPoseTerrainSynthesizer::GetLandscapeSize(int32 Resolution)
+{
+	using namespace AAANKPoseTerrain;
+
+	const int32 Components = FMath::Clamp(FMath::RoundToInt32((Resolution - 1) / static_cast<float>(ComponentQuads)), 1, MaxComponents);
+	return Components * ComponentQuads + 1;
+}
+
+FAAANKPoseHeightfield FAAANKPoseTerrainSynthesizer::Generate(const FAAANKPoseTerrainSettings& Settings)
+{
+	using namespace AAANKPoseTerrain;
+
+	const double StartSeconds = FPlatformTime::Seconds();
+
+	FAAANKPoseHeightfield Result;
+	Result.Size = GetLandscapeSize(Settings.Resolution);
+	Result.SampleSpacing = FMath::Max(Settings.SampleSpacing, 1.0f);
+	const int32 Size = Result.Size;
+	TArray<float>& Heights = Result.Heights;
+	Heights.SetNumUninitialized(Size * Size);
+
+	// Noise runs in lattice cells: one cell per FeatureSize at the first octave
+	AAANKPoseMath::FFractalNoise Fbm;
+	Fbm.Seed = Settings.Seed;
+	Fbm.Octaves = Settings.Octaves;
+	Fbm.Frequency = Result.SampleSpacing / FMath::Max(Settings.FeatureSize, Result.SampleSpacing);
+	Fbm.Lacunarity = Settings.Lacunarity;
+	Fbm.Gain = Settings.Gain;
+	AAANKPoseMath::FFractalNoise RidgedNoise = Fbm;
+	RidgedNoise.bRidged = true;
+	const float Ridged = FMath::Clamp(Settings.Ridged, 0.0f, 1.0f);
+
+	ForEachRowBlock(Size, [&](int32 Y, TArray<float>& Scratch, TArray<float>& Row)
+	{
+		TArrayView<float> Out(Heights.GetData() + Y * Size, Size);
+		if (Ridged < 1.0f)
+		{
+			AAANKPoseMath::FractalNoiseRow(Fbm, 0.0f, 1.0f, static_cast<float>(Y), Out, Scratch);
+		}
+		if (Ridged > 0.0f)
+		{
+			Row.SetNumUninitialized(Size, EAllowShrinking::No);
+			AAANKPoseMath::FractalNoiseRow(RidgedNoise, 0.0f, 1.0f, static_cast<float>(Y), Row, Scratch);
+			for (int32 X = 0; X < Size; ++X)
+			{
+				Out[X] = Ridged < 1.0f ? FMath::Lerp(Out[X], Row[X], Ridged) : Row[X];
+			}
+		}
+		for (int32 X = 0; X < Size; ++X)
+		{
+			Out[X] *= Settings.Relief;
+		}
+	});
+
+	// Each pass reads the previous buffer and writes the other, so rows never see each other's writes
+	if (Settings.ErosionIterations > 0)
+	{
+		TArray<float> Eroded;
+		Eroded.SetNumUninitialized(Heights.Num());
+		const float Rate = FMath::Clamp(Settings.ErosionRate, 0.0f, 1.0f);
+		for (int32 Iteration = 0; Iteration < Settings.ErosionIterations; ++Iteration)
+		{
+			ForEachRowBlock(Size, [&](int32 Y, TArray<float>&, TArray<float>&)
+			{
+				AAANKPoseMath::ThermalErosionRow(Heights, Size, Y, Settings.Talus, Rate, TArrayView<float>(Eroded.GetData() + Y * Size, Size));
+			});
+			Swap(Heights, Eroded);
+		}
+	}
+
+	if (Settings.Canyons.Num() > 0)
+	{
+		TArray<TArray<FVector2f>> Paths;
+		TArray<AAANKPoseMath::FCanyonProfile> Profiles;
+		for (const FAAANKPoseCanyonPath& Canyon : Settings.Canyons)
+		{
+			AAANKPoseMath::FCanyonProfile& Profile = Profiles.AddDefaulted_GetRef();
+			Profile.HalfWidth = Canyon.Width * 0.5f / Result.SampleSpacing;
+			Profile.Depth = Canyon.Depth;
+			Profile.FloorFraction = Canyon.FloorFraction;
+			Profile.WallExponent = Canyon.WallExponent;
+			Profile.Terraces = Canyon.Terraces;
+			Paths.Add(ToGridPath(Canyon, Result.SampleSpacing));
+		}
+
+		ForEachRowBlock(Size, [&](int32 Y, TArray<float>& Scratch, TArray<float>&)
+		{
+			TArrayView<float> Out(Heights.GetData() + Y * Size, Size);
+			for (int32 Index = 0; Index < Paths.Num(); ++Index)
+			{
+				AAANKPoseMath::CarveCanyonRow(Paths[Index], Profiles[Index], Y, Out, Scratch);
+			}
+		});
+	}
+
+	Result.MinHeight = FMath::Min(Heights);
+	Result.MaxHeight = FMath::Max(Heights);
+	Result.Seconds = FPlatformTime::Seconds() - StartSeconds;
+
+	UE_LOG(LogTemp, Log, TEXT("GenerateHeightfield: %dx%d samples (seed %d) in %.2fs, heights %.0f..%.0f cm"),
+		Size, Size, Settings.Seed, Result.Seconds, Result.MinHeight, Result.MaxHeight);
+	return Result;
+}
+
+ALandscape* FAAANKPoseTerrainSynthesizer::CreateLandscape(UWorld* World, const FAAANKPoseHeightfield& Heightfield, const FVector& Location,
+	UMaterialInterface* Material, const FString& Label)
+{
+#if WITH_EDITOR
+	using namespace AAANKPoseTerrain;
+
+	const int32 Size = Heightfield.Size;
+	if (!World)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CreateLandscape: No world to spawn into"));
+		return nullptr;
+	}
+	if (Size < 2 || (Size - 1) % ComponentQuads != 0 || Heightfield.Heights.Num() != Size * Size)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CreateLandscape: %d heights are not a %d-quad-component landscape"), Heightfield.Heights.Num(), ComponentQuads);
+		return nullptr;
+	}
+
+	// Spread the heights over the whole 16-bit range; a landscape's local Z is (Value - 32768) / 128 * ScaleZ
+	const float MinHeight = Heightfield.MinHeight;
+	const float Span = FMath::Max(Heightfield.MaxHeight - MinHeight, 1.0f);
+	TArray<uint16> Values;
+	Values.SetNumUninitialized(Heightfield.Heights.Num());
+	ParallelFor(Size, [&](int32 Y)
+	{
+		for (int32 Index = Y * Size; Index < (Y + 1) * Size; ++Index)
+		{
+			Values[Index] = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt32((Heightfield.Heights[Index] - MinHeight) / Span * 65535.0f), 0, 65535));
+		}
+	});
+	const float ScaleZ = Span * 128.0f / 65535.0f;
+	const FVector Origin(Location.X, Location.Y, Location.Z + MinHeight + 32768.0f * Span / 65535.0f);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags |= RF_Transactional;
+	ALandscape* Landscape = World->SpawnActor<ALandscape>(Origin, FRotator::ZeroRotator, SpawnParams);
+	if (!Landscape)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CreateLandscape: Failed to spawn the landscape"));
+		return nullptr;
+	}
+	Landscape->SetActorRelativeScale3D(FVector(Heightfield.SampleSpacing, Heightfield.SampleSpacing, ScaleZ));
+	Landscape->LandscapeMaterial = Material;
+
+	TMap<FGuid, TArray<uint16>> HeightData;
+	HeightData.Add(FGuid(), MoveTemp(Values));
+	TMap<FGuid, TArray<FLandscapeImportLayerInfo>> LayerData;
+	LayerData.Add(FGuid());
+	Landscape->Import(FGuid::NewGuid(), 0, 0, Size - 1, Size - 1, /*NumSubsections*/ 2, /*SubsectionSizeQuads*/ ComponentQuads / 2,
+		HeightData, nullptr, LayerData, ELandscapeImportAlphamapType::Additive);
+
+	if (!Label.IsEmpty())
+	{
+		Landscape->SetActorLabel(Label);
+	}
+	World->MarkPackageDirty();
+
+	UE_LOG(LogTemp, Log, TEXT("CreateLandscape: Imported %dx%d landscape '%s'"), Size, Size, *Landscape->GetActorLabel());
+	return Landscape;
+#else
+	UE_LOG(LogTemp, Warning, TEXT("CreateLandscape: Landscape import is editor only"));
+	return nullptr;
+#endif
+}
+
+FAAANKPoseHeightfield UAAANKPoseTerrainLibrary::GenerateHeightfield(const FAAANKPoseTerrainSettings& Settings)
+{
+	return FAAANKPoseTerrainSynthesizer::Generate(Settings);
+}
+
+ALandscape* UAAANKPoseTerrainLibrary::CreateLandscape(UObject* WorldContextObject, const FAAANKPoseHeightfield& Heightfield, FVector Location,
+	UMaterialInterface* Material, const FString& Label)
+{
+	return FAAANKPoseTerrainSynthesizer::CreateLandscape(UAAANKPoseSpawnLibrary::ResolveWorld(WorldContextObject), Heightfield, Location, Material, Label);
+}
+
+ALandscape* UAAANKPoseTerrainLibrary::SynthesizeLandscape(UObject* WorldContextObject, const FAAANKPoseTerrainSettings& Settings, FVector Location,
+	UMaterialInterface* Material, const FString& Label)
+{
+	return CreateLandscape(WorldContextObject, FAAANKPoseTerrainSynthesizer::Generate(Settings), Location, Material, Label);
+}
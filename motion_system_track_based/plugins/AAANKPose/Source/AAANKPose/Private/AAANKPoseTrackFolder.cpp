@@ -0,0 +1,564 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseTrackFolder.h"
+#include "AAANKPoseMath.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Dom/JsonValue.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+
+namespace AAANKPoseTrackFolder
+{
+	static TSharedPtr<FJsonValue> LoadJsonFile(const FString& FilePath)
+	{
+		FString Contents;
+		if (!FFileHelper::LoadFileToString(Contents, *FilePath))
+		{
+			return nullptr;
+		}
+
+		TSharedPtr<FJsonValue> Root;
+		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Contents);
+		if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to parse JSON file '%s'"), *FilePath);
+			return nullptr;
+		}
+		return Root;
+	}
+
+	static double GetNumber(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field, double Default = 0.0)
+	{
+		double Value = Default;
+		Object->TryGetNumberField(Field, Value);
+		return Value;
+	}
+
+	/** Chunked tracks live in <actor>/transform/ next to where transform.json would be */
+	static const TCHAR* ChunkFolderName = TEXT("transform");
+	static const TCHAR* IndexFileName = TEXT("index.json");
+
+	static FString GetChunkFolder(const FString& ActorFolder)
+	{
+		return FPaths::Combine(ActorFolder, ChunkFolderName);
+	}
+
+	/** Appends the entries of one transform array file, unsorted */
+	static bool AppendTransformFile(const FString& FilePath, TArray<FAAANKPoseTransformKey>& OutKeys)
+	{
+		TSharedPtr<FJsonValue> Root = LoadJsonFile(FilePath);
+		const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+		if (!Root.IsValid() || !Root->TryGetArray(Entries))
+		{
+			return false;
+		}
+
+		OutKeys.Reserve(OutKeys.Num() + Entries->Num());
+		for (const TSharedPtr<FJsonValue>& Entry : *Entries)
+		{
+			const TSharedPtr<FJsonObject>* Object = nullptr;
+			if (!Entry->TryGetObject(Object))
+			{
+				continue;
+			}
+
+			FAAANKPoseTransformKey& Key = OutKeys.AddDefaulted_GetRef();
+			Key.Frame = FMath::RoundToInt(GetNumber(*Object, TEXT("frame")));
+			Key.Location = FVector(GetNumber(*Object, TEXT("x")), GetNumber(*Object, TEXT("y")), GetNumber(*Object, TEXT("z")));
+			Key.Rotation = FRotator(GetNumber(*Object, TEXT("pitch")), GetNumber(*Object, TEXT("yaw")), GetNumber(*Object, TEXT("roll")));
+		}
+		return true;
+	}
+
+	static void SortKeys(TArray<FAAANKPoseTransformKey>& Keys)
+	{
+		Keys.StableSort([](const FAAANKPoseTransformKey& A, const FAAANKPoseTransformKey& B)
+		{
+			return A.Frame < B.Frame;
+		});
+	}
+
+	static bool LoadChunk(const FString& ActorFolder, const FAAANKPoseTrackChunk& Chunk, TArray<FAAANKPoseTransformKey>& OutKeys)
+	{
+		if (!AppendTransformFile(FPaths::Combine(GetChunkFolder(ActorFolder), Chunk.File), OutKeys))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Transform window '%s' listed in the index of '%s' is missing"), *Chunk.File, *ActorFolder);
+			return false;
+		}
+		return true;
+	}
+
+	static bool WriteTransformFile(const FString& FilePath, TConstArrayView<FAAANKPoseTransformKey> Keys)
+	{
+		FString Output;
+		TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+
+		Writer->WriteArrayStart();
+		for (const FAAANKPoseTransformKey& Key : Keys)
+		{
+			Writer->WriteObjectStart();
+			Writer->WriteValue(TEXT("frame"), Key.Frame);
+			Writer->WriteValue(TEXT("x"), Key.Location.X);
+			Writer->WriteValue(TEXT("y"), Key.Location.Y);
+			Writer->WriteValue(TEXT("z"), Key.Location.Z);
+			Writer->WriteValue(TEXT("roll"), Key.Rotation.Roll);
+			Writer->WriteValue(TEXT("pitch"), Key.Rotation.Pitch);
+			Writer->WriteValue(TEXT("yaw"), Key.Rotation.Yaw);
+			Writer->WriteObjectEnd();
+		}
+		Writer->WriteArrayEnd();
+		Writer->Close();
+
+		if (!FFileHelper::SaveStringToFile(Output, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to write '%s'"), *FilePath);
+			return false;
+		}
+		return true;
+	}
+}
+
+int32 FAAANKPoseTrackChunkIndex::FindChunk(double Frame) const
+{
+	if (Chunks.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	// Last chunk starting at or before Frame
+	int32 Low = 0;
+	int32 High = Chunks.Num() - 1;
+	while (Low < High)
+	{
+		const int32 Mid = (Low + High + 1) / 2;
+		if (Chunks[Mid].StartFrame <= Frame)
+		{
+			Low = Mid;
+		}
+		else
+		{
+			High = Mid - 1;
+		}
+	}
+	return Low;
+}
+
+bool FAAANKPoseTrackFolder::LoadMeta(const FString& MovieFolder, FAAANKPoseMovieMeta& OutMeta)
+{
+	TSharedPtr<FJsonValue> Root = AAANKPoseTrackFolder::LoadJsonFile(FPaths::Combine(MovieFolder, TEXT("meta.json")));
+	const TSharedPtr<FJsonObject>* Object = nullptr;
+	if (!Root.IsValid() || !Root->TryGetObject(Object))
+	{
+		UE_LOG(LogTemp, Error, TEXT("meta.json not found or invalid in '%s'"), *MovieFolder);
+		return false;
+	}
+
+	OutMeta = FAAANKPoseMovieMeta();
+	(*Object)->TryGetStringField(TEXT("name"), OutMeta.Name);
+	OutMeta.Fps = FMath::RoundToInt(AAANKPoseTrackFolder::GetNumber(*Object, TEXT("fps"), 60.0));
+	(*Object)->TryGetStringArrayField(TEXT("actors"), OutMeta.Actors);
+	(*Object)->TryGetBoolField(TEXT("create_new_level"), OutMeta.bCreateNewLevel);
+	return true;
+}
+
+bool FAAANKPoseTrackFolder::LoadTransformKeys(const FString& ActorFolder, TArray<FAAANKPoseTransformKey>& OutKeys)
+{
+	OutKeys.Reset();
+
+	FAAANKPoseTrackChunkIndex Index;
+	if (LoadTransformIndex(ActorFolder, Index))
+	{
+		OutKeys.Reserve(Index.NumKeys);
+		for (const FAAANKPoseTrackChunk& Chunk : Index.Chunks)
+		{
+			AAANKPoseTrackFolder::LoadChunk(ActorFolder, Chunk, OutKeys);
+		}
+	}
+	else if (!AAANKPoseTrackFolder::AppendTransformFile(FPaths::Combine(ActorFolder, TEXT("transform.json")), OutKeys))
+	{
+		return false;
+	}
+
+	AAANKPoseTrackFolder::SortKeys(OutKeys);
+	return true;
+}
+
+bool FAAANKPoseTrackFolder::SaveTransformKeys(const FString& ActorFolder, const TArray<FAAANKPoseTransformKey>& Keys)
+{
+	FAAANKPoseTrackChunkIndex Index;
+	if (LoadTransformIndex(ActorFolder, Index))
+	{
+		return SaveTransformChunks(ActorFolder, Keys, Index.WindowFrames);
+	}
+	return AAANKPoseTrackFolder::WriteTransformFile(FPaths::Combine(ActorFolder, TEXT("transform.json")), Keys);
+}
+
+bool FAAANKPoseTrackFolder::SaveTransformChunks(const FString& ActorFolder, const TArray<FAAANKPoseTransformKey>& Keys, int32 WindowFrames)
+{
+	if (WindowFrames <= 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SaveTransformChunks: Invalid window of %d frames for '%s'"), WindowFrames, *ActorFolder);
+		return false;
+	}
+
+	// Stale windows from a longer take would otherwise stay on disk unlisted
+	const FString ChunkFolder = AAANKPoseTrackFolder::GetChunkFolder(ActorFolder);
+	IFileManager& FileManager = IFileManager::Get();
+	FileManager.DeleteDirectory(*ChunkFolder, false, true);
+	FileManager.MakeDirectory(*ChunkFolder, true);
+
+	TArray<FAAANKPoseTransformKey> Sorted = Keys;
+	AAANKPoseTrackFolder::SortKeys(Sorted);
+
+	TSharedRef<FJsonObject> IndexObject = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> ChunkValues;
+	int32 Start = 0;
+	while (Start < Sorted.Num())
+	{
+		const int32 Window = FMath::FloorToInt32(static_cast<double>(Sorted[Start].Frame) / WindowFrames);
+		int32 End = Start + 1;
+		while (End < Sorted.Num() && FMath::FloorToInt32(static_cast<double>(Sorted[End].Frame) / WindowFrames) == Window)
+		{
+			++End;
+		}
+
+		const FString File = FString::Printf(TEXT("%06d.json"), Window);
+		if (!AAANKPoseTrackFolder::WriteTransformFile(FPaths::Combine(ChunkFolder, File), MakeArrayView(Sorted).Slice(Start, End - Start)))
+		{
+			return false;
+		}
+
+		TSharedRef<FJsonObject> ChunkObject = MakeShared<FJsonObject>();
+		ChunkObject->SetStringField(TEXT("file"), File);
+		ChunkObject->SetNumberField(TEXT("start_frame"), Sorted[Start].Frame);
+		ChunkObject->SetNumberField(TEXT("end_frame"), Sorted[End - 1].Frame);
+		ChunkObject->SetNumberField(TEXT("count"), End - Start);
+		ChunkValues.Add(MakeShared<FJsonValueObject>(ChunkObject));
+		Start = End;
+	}
+
+	IndexObject->SetStringField(TEXT("format"), TEXT("chunked"));
+	IndexObject->SetNumberField(TEXT("window_frames"), WindowFrames);
+	IndexObject->SetNumberField(TEXT("first_frame"), Sorted.Num() > 0 ? Sorted[0].Frame : 0);
+	IndexObject->SetNumberField(TEXT("last_frame"), Sorted.Num() > 0 ? Sorted.Last().Frame : 0);
+	IndexObject->SetNumberField(TEXT("count"), Sorted.Num());
+	IndexObject->SetArrayField(TEXT("chunks"), ChunkValues);
+
+	FString Output;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	FJsonSerializer::Serialize(IndexObject, Writer);
+
+	// The index goes last so a reader never sees it listing a window that isn't written yet
+	const FString IndexPath = FPaths::Combine(ChunkFolder, AAANKPoseTrackFolder::IndexFileName);
+	if (!FFileHelper::SaveStringToFile(Output, *IndexPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to write '%s'"), *IndexPath);
+		return false;
+	}
+	FileManager.Delete(*FPaths::Combine(ActorFolder, TEXT("transform.json")), false, false, true);
+	return true;
+}
+
+bool FAAANKPoseTrackFolder::LoadTransformIndex(const FString& ActorFolder, FAAANKPoseTrackChunkIndex& OutIndex)
+{
+	OutIndex = FAAANKPoseTrackChunkIndex();
+
+	const FString IndexPath = FPaths::Combine(AAANKPoseTrackFolder::GetChunkFolder(ActorFolder), AAANKPoseTrackFolder::IndexFileName);
+	if (!FPaths::FileExists(IndexPath))
+	{
+		return false;
+	}
+
+	TSharedPtr<FJsonValue> Root = AAANKPoseTrackFolder::LoadJsonFile(IndexPath);
+	const TSharedPtr<FJsonObject>* Object = nullptr;
+	const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+	if (!Root.IsValid() || !Root->TryGetObject(Object) || !(*Object)->TryGetArrayField(TEXT("chunks"), Entries))
+	{
+		return false;
+	}
+
+	using AAANKPoseTrackFolder::GetNumber;
+	OutIndex.WindowFrames = FMath::RoundToInt(GetNumber(*Object, TEXT("window_frames")));
+	OutIndex.FirstFrame = FMath::RoundToInt(GetNumber(*Object, TEXT("first_frame")));
+	OutIndex.LastFrame = FMath::RoundToInt(GetNumber(*Object, TEXT("last_frame")));
+	OutIndex.NumKeys = FMath::RoundToInt(GetNumber(*Object, TEXT("count")));
+	for (const TSharedPtr<FJsonValue>& Entry : *Entries)
+	{
+		const TSharedPtr<FJsonObject>* ChunkObject = nullptr;
+		if (!Entry->TryGetObject(ChunkObject))
+		{
+			continue;
+		}
+
+		FAAANKPoseTrackChunk& Chunk = OutIndex.Chunks.AddDefaulted_GetRef();
+		(*ChunkObject)->TryGetStringField(TEXT("file"), Chunk.File);
+		Chunk.StartFrame = FMath::RoundToInt(GetNumber(*ChunkObject, TEXT("start_frame")));
+		Chunk.EndFrame = FMath::RoundToInt(GetNumber(*ChunkObject, TEXT("end_frame")));
+		Chunk.NumKeys = FMath::RoundToInt(GetNumber(*ChunkObject, TEXT("count")));
+	}
+
+	OutIndex.Chunks.StableSort([](const FAAANKPoseTrackChunk& A, const FAAANKPoseTrackChunk& B)
+	{
+		return A.StartFrame < B.StartFrame;
+	});
+	return OutIndex.WindowFrames > 0;
+}
+
+bool FAAANKPoseTrackFolder::LoadTransformWindow(const FString& ActorFolder, const FAAANKPoseTrackChunkIndex& Index, int32 StartFrame, int32 EndFrame, TArray<FAAANKPoseTransformKey>& OutKeys)
+{
+	OutKeys.Reset();
+	bool bAllLoaded = true;
+	for (const FAAANKPoseTrackChunk& Chunk : Index.Chunks)
+	{
+		if (Chunk.EndFrame >= StartFrame && Chunk.StartFrame <= EndFrame)
+		{
+			bAllLoaded &= AAANKPoseTrackFolder::LoadChunk(ActorFolder, Chunk, OutKeys);
+		}
+	}
+	AAANKPoseTrackFolder::SortKeys(OutKeys);
+	return bAllLoaded;
+}
+
+bool FAAANKPoseTrackFolder::LoadAnimationSections(const FString& ActorFolder, TArray<FAAANKPoseAnimationSection>& OutSections)
+{
+	OutSections.Reset();
+
+	TSharedPtr<FJsonValue> Root = AAANKPoseTrackFolder::LoadJsonFile(FPaths::Combine(ActorFolder, TEXT("animation.json")));
+	const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+	if (!Root.IsValid() || !Root->TryGetArray(Entries))
+	{
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& Entry : *Entries)
+	{
+		const TSharedPtr<FJsonObject>* Object = nullptr;
+		if (!Entry->TryGetObject(Object))
+		{
+			continue;
+		}
+
+		using AAANKPoseTrackFolder::GetNumber;
+		FAAANKPoseAnimationSection& Section = OutSections.AddDefaulted_GetRef();
+		Section.StartFrame = FMath::RoundToInt(GetNumber(*Object, TEXT("start_frame")));
+		Section.EndFrame = FMath::RoundToInt(GetNumber(*Object, TEXT("end_frame"), Section.StartFrame));
+		(*Object)->TryGetStringField(TEXT("name"), Section.Name);
+		Section.SpeedMultiplier = GetNumber(*Object, TEXT("speed_multiplier"), GetNumber(*Object, TEXT("speed"), 1.0));
+	}
+
+	OutSections.StableSort([](const FAAANKPoseAnimationSection& A, const FAAANKPoseAnimationSection& B)
+	{
+		return A.StartFrame < B.StartFrame;
+	});
+	return true;
+}
+
+bool FAAANKPoseTrackFolder::LoadFocalLengthKeys(const FString& ActorFolder, TArray<TPair<int32, float>>& OutKeys)
+{
+	OutKeys.Reset();
+
+	TSharedPtr<FJsonValue> Root = AAANKPoseTrackFolder::LoadJsonFile(FPaths::Combine(ActorFolder, TEXT("focal_length.json")));
+	const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+	if (!Root.IsValid() || !Root->TryGetArray(Entries))
+	{
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& Entry : *Entries)
+	{
+		const TSharedPtr<FJsonObject>* Object = nullptr;
+		double Frame = 0.0;
+		double Value = 0.0;
+		if (Entry->TryGetObject(Object) && (*Object)->TryGetNumberField(TEXT("frame"), Frame) && (*Object)->TryGetNumberField(TEXT("value"), Value))
+		{
+			OutKeys.Emplace(FMath::RoundToInt32(Frame), static_cast<float>(Value));
+		}
+	}
+	return true;
+}
+
+bool FAAANKPoseTrackFolder::LoadCameraCuts(const FString& MovieFolder, TArray<FAAANKPoseCameraCut>& OutCuts)
+{
+	OutCuts.Reset();
+
+	TSharedPtr<FJsonValue> Root = AAANKPoseTrackFolder::LoadJsonFile(FPaths::Combine(MovieFolder, TEXT("camera_cuts.json")));
+	const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+	if (!Root.IsValid() || !Root->TryGetArray(Entries))
+	{
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& Entry : *Entries)
+	{
+		const TSharedPtr<FJsonObject>* Object = nullptr;
+		if (Entry->TryGetObject(Object))
+		{
+			FAAANKPoseCameraCut& Cut = OutCuts.AddDefaulted_GetRef();
+			Cut.Time = AAANKPoseTrackFolder::GetNumber(*Object, TEXT("time"));
+			(*Object)->TryGetStringField(TEXT("camera"), Cut.Camera);
+		}
+	}
+
+	OutCuts.StableSort([](const FAAANKPoseCameraCut& A, const FAAANKPoseCameraCut& B)
+	{
+		return A.Time < B.Time;
+	});
+	return true;
+}
+
+TSharedPtr<FJsonObject> FAAANKPoseTrackFolder::LoadSettings(const FString& ActorFolder)
+{
+	const FString FilePath = FPaths::Combine(ActorFolder, TEXT("settings.json"));
+	if (!FPaths::FileExists(FilePath))
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FJsonValue> Root = AAANKPoseTrackFolder::LoadJsonFile(FilePath);
+	const TSharedPtr<FJsonObject>* Object = nullptr;
+	return Root.IsValid() && Root->TryGetObject(Object) ? *Object : nullptr;
+}
+
+FString FAAANKPoseTrackFolder::ResolveAnimationPath(const FString& AnimName)
+{
+	if (AnimName.StartsWith(TEXT("/Game/")))
+	{
+		return AnimName;
+	}
+	return FString::Printf(TEXT("/Game/ParagonLtBelica/Characters/Heroes/Belica/Animations/%s.%s"), *AnimName, *AnimName);
+}
+
+FAAANKPoseTransformKey FAAANKPoseTrackFolder::SampleTransform(const TArray<FAAANKPoseTransformKey>& Keys, double Frame)
+{
+	double Alpha = 0.0;
+	const int32 Index = AAANKPoseMath::FindKeySegment(MakeArrayView(Keys), Frame, [](const FAAANKPoseTransformKey& Key) { return (double)Key.Frame; }, Alpha);
+	if (Index == INDEX_NONE)
+	{
+		return FAAANKPoseTransformKey();
+	}
+	if (Index == Keys.Num() - 1 || Alpha <= 0.0)
+	{
+		return Keys[Index];
+	}
+
+	const FAAANKPoseTransformKey& A = Keys[Index];
+	const FAAANKPoseTransformKey& B = Keys[Index + 1];
+
+	FAAANKPoseTransformKey Result;
+	Result.Frame = FMath::RoundToInt(Frame);
+	Result.Location = FMath::Lerp(A.Location, B.Location, Alpha);
+	Result.Rotation = AAANKPoseMath::LerpRotatorComponents(A.Rotation, B.Rotation, Alpha);
+	return Result;
+}
+
+FAAANKPoseTransformReader::FAAANKPoseTransformReader(const FString& InActorFolder)
+	: ActorFolder(InActorFolder)
+{
+	bChunked = FAAANKPoseTrackFolder::LoadTransformIndex(ActorFolder, Index);
+	if (!bChunked)
+	{
+		FAAANKPoseTrackFolder::LoadTransformKeys(ActorFolder, AllKeys);
+		WindowsLoaded = AllKeys.Num() > 0 ? 1 : 0;
+	}
+}
+
+int32 FAAANKPoseTransformReader::GetFirstFrame() const
+{
+	if (bChunked)
+	{
+		return Index.FirstFrame;
+	}
+	return AllKeys.Num() > 0 ? AllKeys[0].Frame : 0;
+}
+
+int32 FAAANKPoseTransformReader::GetLastFrame() const
+{
+	if (bChunked)
+	{
+		return Index.LastFrame;
+	}
+	return AllKeys.Num() > 0 ? AllKeys.Last().Frame : 0;
+}
+
+const TArray<FAAANKPoseTransformKey>& FAAANKPoseTransformReader::GetChunk(int32 ChunkIndex)
+{
+	if (const TArray<FAAANKPoseTransformKey>* Keys = ResidentChunks.Find(ChunkIndex))
+	{
+		return *Keys;
+	}
+
+	// Only neighbours of the requested window can still be needed to interpolate across a window boundary
+	for (auto It = ResidentChunks.CreateIterator(); It; ++It)
+	{
+		if (It.Key() != ChunkIndex - 1 && It.Key() != ChunkIndex + 1)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	TArray<FAAANKPoseTransformKey>& Keys = ResidentChunks.Add(ChunkIndex);
+	AAANKPoseTrackFolder::LoadChunk(ActorFolder, Index.Chunks[ChunkIndex], Keys);
+	AAANKPoseTrackFolder::SortKeys(Keys);
+	++WindowsLoaded;
+	return Keys;
+}
+
+FAAANKPoseTransformKey FAAANKPoseTransformReader::Sample(double Frame)
+{
+	if (!bChunked)
+	{
+		return FAAANKPoseTrackFolder::SampleTransform(AllKeys, Frame);
+	}
+
+	const int32 ChunkIndex = Index.FindChunk(Frame);
+	if (ChunkIndex == INDEX_NONE)
+	{
+		return FAAANKPoseTransformKey();
+	}
+
+	const FAAANKPoseTrackChunk& Chunk = Index.Chunks[ChunkIndex];
+	if (Frame <= Chunk.EndFrame || ChunkIndex == Index.Chunks.Num() - 1)
+	{
+		return FAAANKPoseTrackFolder::SampleTransform(GetChunk(ChunkIndex), Frame);
+	}
+
+	// Between two windows: interpolate from the last key of one to the first key of the next
+	TArray<FAAANKPoseTransformKey> Bridge;
+	if (GetChunk(ChunkIndex).Num() > 0)
+	{
+		Bridge.Add(GetChunk(ChunkIndex).Last());
+	}
+	if (GetChunk(ChunkIndex + 1).Num() > 0)
+	{
+		Bridge.Add(GetChunk(ChunkIndex + 1)[0]);
+	}
+	return FAAANKPoseTrackFolder::SampleTransform(Bridge, Frame);
+}
+
+bool FAAANKPoseTransformReader::NextWindow(TArray<FAAANKPoseTransformKey>& OutKeys)
+{
+	OutKeys.Reset();
+	if (!bChunked)
+	{
+		if (NextWindowIndex++ > 0 || AllKeys.Num() == 0)
+		{
+			return false;
+		}
+		OutKeys = AllKeys;
+		return true;
+	}
+
+	if (NextWindowIndex >= Index.Chunks.Num())
+	{
+		return false;
+	}
+	AAANKPoseTrackFolder::LoadChunk(ActorFolder, Index.Chunks[NextWindowIndex++], OutKeys);
+	AAANKPoseTrackFolder::SortKeys(OutKeys);
+	++WindowsLoaded;
+	return true;
+}
@@ -2,7 +2,12 @@
 
 #pragma once
 
+#include "Containers/Ticker.h"
+#include "Misc/SecureHash.h"
 #include "Modules/ModuleManager.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class ULevelSequence;
 
 class FAAANKPoseModule : public IModuleInterface
 {
@@ -14,4 +19,36 @@ public:
 
 	/** Returns "Hello World" to the caller */
 	static FString HelloWorld();
+
+	static FAAANKPoseModule& Get() { return FModuleManager::LoadModuleChecked<FAAANKPoseModule>("AAANKPose"); }
+
+	/**
+	 * Watch a dist/<movie> folder and re-key Sequence when actor track files change (editor only).
+	 * Writes are debounced, and a file only counts as changed when its content hash differs from the last one
+	 * seen, so a save_to_tracks burst that rewrites every file re-keys only the actors that actually changed.
+	 */
+	bool WatchMovieFolder(const FString& MovieFolder, ULevelSequence* Sequence);
+	bool UnwatchMovieFolder(const FString& MovieFolder);
+	TArray<FString> GetWatchedMovieFolders() const;
+
+private:
+	struct FWatchedMovieFolder
+	{
+		TWeakObjectPtr<ULevelSequence> Sequence;
+		FDelegateHandle WatchHandle;
+		/** Files written since the last tick that applied, relative to the folder; compared by hash once writes settle */
+		TSet<FString> WrittenFiles;
+		/** Content hash of every track and scene file as last seen */
+		TMap<FString, FMD5Hash> FileHashes;
+		double LastChangeSeconds = 0.0;
+	};
+
+	void OnMovieFolderChanged(const TArray<struct FFileChangeData>& Changes, FString MovieFolder);
+	/** Hash the written files and sort the ones whose content changed into actors to re-key or a rebuild */
+	void CollectChanges(const FString& MovieFolder, FWatchedMovieFolder& Watched, TSet<FString>& OutActors, bool& bOutNeedsRebuild);
+	bool TickLiveApply(float DeltaTime);
+
+	/** Keyed by normalized absolute folder */
+	TMap<FString, FWatchedMovieFolder> WatchedFolders;
+	FTSTicker::FDelegateHandle LiveApplyTickerHandle;
 };
@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AAANKPoseBenchmarkCommandlet.generated.h"
+
+
+/**
+ * Builds every track folder under a root through the native scene build in a fresh world and gates
+ * the timings against a budgets file. Meant to run headless:
+ *
+ *   UnrealEditor-Cmd.exe <Project>.uproject -run=AAANKPoseBenchmark -nullrhi -unattended
+ *       -TracksRoot=<dir> [-Budgets=<budgets.json>] [-Margin=0.2] [-Iterations=3] [-Report=<out.json>]
+ *       [-Movies=a,b] [-RecordBudgets]
+ *
+ * Returns non-zero when any movie fails to build, has no budget, or exceeds its budgeted build time or peak memory
+ * by more than Margin. Without -Budgets the run only reports; an unreadable or empty budgets file is an error.
+ */
+UCLASS()
+class UAAANKPoseBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UAAANKPoseBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,133 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AAANKPoseBufferBridge.generated.h"
+
+
+UENUM(BlueprintType)
+enum class EAAANKPoseBufferType : uint8
+{
+	Float,
+	Double,
+	Int32,
+};
+
+/**
+ * A contiguous array in a named shared memory region. Python maps the same region by KernelName (mmap tagname
+ * on Windows, multiprocessing.shared_memory elsewhere) and reads or writes it as a memoryview or numpy
+ * array, so only the handle crosses the reflection layer.
+ */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseBufferHandle
+{
+	GENERATED_BODY()
+
+	/** Registry key */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Buffers")
+	FString Name;
+
+	/** Name of the OS object behind the region, which the platform may have prefixed (Global\ on Windows) */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Buffers")
+	FString KernelName;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Buffers")
+	EAAANKPoseBufferType Type = EAAANKPoseBufferType::Float;
+
+	/** Elements, not bytes */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Buffers")
+	int32 Num = 0;
+
+	bool IsValid() const { return !Name.IsEmpty() && Num > 0; }
+};
+
+
+/** Element type of each buffer type, for typed views */
+template <typename T> struct TAAANKPoseBufferType;
+template <> struct TAAANKPoseBufferType<float> { static constexpr EAAANKPoseBufferType Value = EAAANKPoseBufferType::Float; };
+template <> struct TAAANKPoseBufferType<double> { static constexpr EAAANKPoseBufferType Value = EAAANKPoseBufferType::Double; };
+template <> struct TAAANKPoseBufferType<int32> { static constexpr EAAANKPoseBufferType Value = EAAANKPoseBufferType::Int32; };
+
+/**
+ * Owns the shared regions behind buffer handles. Regions live until released or until the module shuts
+ * down; native code reads and writes them in place through typed views. Game thread only.
+ */
+class AAANKPOSE_API FAAANKPoseBufferRegistry
+{
+public:
+	static FAAANKPoseBufferHandle Create(EAAANKPoseBufferType Type, int32 Num);
+	static bool Release(const FAAANKPoseBufferHandle& Handle);
+	static int32 ReleaseAll();
+
+	static int32 GetElementSize(EAAANKPoseBufferType Type);
+
+	/** The handle's elements, or an empty view if it is unknown or holds another type */
+	template <typename T>
+	static TArrayView<T> View(const FAAANKPoseBufferHandle& Handle)
+	{
+		if (Handle.Type != TAAANKPoseBufferType<T>::Value)
+		{
+			return TArrayView<T>();
+		}
+		void* Data = Find(Handle);
+		return Data ? TArrayView<T>(static_cast<T*>(Data), Handle.Num) : TArrayView<T>();
+	}
+
+private:
+	/** Start of the region, if it is registered and large enough for the handle */
+	static void* Find(const FAAANKPoseBufferHandle& Handle);
+};
+
+
+/**
+ * Shared buffers for Python callers, and batch kernels that read their inputs from and write their
+ * results to buffers without per-element conversion.
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseBufferLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/** Allocate a zeroed shared buffer of Num elements */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Buffers")
+	static FAAANKPoseBufferHandle CreateSharedBuffer(EAAANKPoseBufferType Type, int32 Num);
+
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Buffers")
+	static bool ReleaseSharedBuffer(const FAAANKPoseBufferHandle& Handle);
+
+	/** Size of one element in bytes, so callers can map the region without knowing the enum */
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Buffers")
+	static int32 GetBufferElementSize(EAAANKPoseBufferType Type);
+
+	/**
+	 * Arc-length sample a Catmull-Rom path
+	 * @param Points - Double buffer of x, y, z control points
+	 * @param OutSamples - Float buffer receiving x, y, z, tangent x, y, z, distance, slope per sample
+	 * @return Samples produced; if larger than OutSamples holds, only the first ones were written
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Buffers")
+	static int32 SampleSplinePathToBuffer(const FAAANKPoseBufferHandle& Points, float SampleInterval, bool bClosed, const FAAANKPoseBufferHandle& OutSamples);
+
+	/**
+	 * Look-at rotation and focal length per frame
+	 * @param CameraLocations - Double buffer of x, y, z per frame
+	 * @param SubjectLocations - Double buffer of x, y, z per frame
+	 * @param OutCamera - Float buffer receiving pitch, yaw, roll, focal length per frame
+	 * @return Frames solved, or -1 if the buffers don't match
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Buffers")
+	static int32 SolveCameraTrackToBuffer(const FAAANKPoseBufferHandle& CameraLocations, const FAAANKPoseBufferHandle& SubjectLocations,
+		float SubjectHeight, float Coverage, const FAAANKPoseBufferHandle& OutCamera);
+
+	/**
+	 * Indices of the points to keep so no dropped point is further than Tolerance from the kept curve
+	 * @param Points - Double buffer of x, y, z points
+	 * @param OutKeptIndices - Int32 buffer receiving the kept indices in order
+	 * @return Indices kept; if larger than OutKeptIndices holds, only the first ones were written
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Buffers")
+	static int32 ReduceCurveToBuffer(const FAAANKPoseBufferHandle& Points, float Tolerance, const FAAANKPoseBufferHandle& OutKeptIndices);
+};
@@ -0,0 +1,104 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "UObject/Object.h"
+#include "AAANKPoseBuildCache.generated.h"
+
+class AActor;
+class ULevelSequence;
+class UWorld;
+
+
+/** Stored on a generated sequence: what it was built from */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseBuildCacheMetaData : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	FString Fingerprint;
+
+	UPROPERTY()
+	FString MovieFolder;
+
+	UPROPERTY()
+	FString PluginVersion;
+
+	UPROPERTY()
+	FDateTime BuiltAt;
+};
+
+
+/**
+ * Whole-build result cache. A track folder's fingerprint covers every file in it plus the plugin
+ * version and build options, so a movie re-run from a byte-identical dist/<movie> can reuse the
+ * last sequence built for it instead of tearing the scene down and rebuilding it.
+ */
+class AAANKPOSE_API FAAANKPoseBuildCache
+{
+public:
+	/** VersionName from AAANKPose.uplugin */
+	static FString GetPluginVersion();
+
+	/**
+	 * SHA-1 over the relative path and contents of every file under MovieFolder, the plugin version and BuildOptions.
+	 * BuildOptions keeps builds of the same folder that produce different sequences (Python vs native, shots) apart.
+	 * Empty if the folder does not exist.
+	 */
+	static FString ComputeFingerprint(const FString& MovieFolder, const FString& BuildOptions);
+
+	/** Highest numbered /Game/Sequences/<Scene>_NNN, as both build paths name them; editor only */
+	static ULevelSequence* FindLatestSequence(const FString& SceneName);
+
+	/** Fingerprint stamped by StampSequence, or empty */
+	static FString GetSequenceFingerprint(const ULevelSequence* Sequence);
+
+	/**
+	 * Resolve the actor (root) bindings of Sequence and of the subsequences on its cinematic shot track in World.
+	 * False if any binding doesn't resolve; an actor that merely carries a binding's label is not enough.
+	 * @param OutActors - The resolved actors, each once
+	 */
+	static bool ResolveRootBindings(const ULevelSequence& Sequence, UWorld& World, TArray<AActor*>& OutActors);
+
+	/**
+	 * The last sequence built from MovieFolder if its fingerprint matches and all its bindings still resolve in the level.
+	 * Anything else means the build has to run.
+	 */
+	static ULevelSequence* FindReusableSequence(UWorld* World, const FString& MovieFolder, const FString& Fingerprint);
+
+	/** Record what Sequence was built from; call once the build has succeeded, before saving */
+	static void StampSequence(ULevelSequence* Sequence, const FString& MovieFolder, const FString& Fingerprint);
+};
+
+
+/**
+ * Python usage:
+ *   fingerprint = unreal.AAANKPoseBuildCacheLibrary.compute_track_folder_fingerprint(folder, "python")
+ *   sequence = unreal.AAANKPoseBuildCacheLibrary.find_reusable_sequence(None, folder, fingerprint)
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseBuildCacheLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Scene")
+	static FString ComputeTrackFolderFingerprint(const FString& MovieFolder, const FString& BuildOptions);
+
+	/** The up-to-date sequence for MovieFolder, or null if the build has to run */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Scene", meta = (WorldContext = "WorldContextObject"))
+	static ULevelSequence* FindReusableSequence(UObject* WorldContextObject, const FString& MovieFolder, const FString& Fingerprint);
+
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Scene")
+	static void StampSequence(ULevelSequence* Sequence, const FString& MovieFolder, const FString& Fingerprint);
+
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Scene")
+	static FString GetSequenceFingerprint(ULevelSequence* Sequence);
+
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Scene")
+	static FString GetPluginVersion();
+};
@@ -0,0 +1,153 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AAANKPoseBuildTelemetry.generated.h"
+
+
+/** How a build ended; only completed builds are compared with or feed the history's medians */
+UENUM(BlueprintType)
+enum class EAAANKPoseBuildOutcome : uint8
+{
+	Completed,
+	/** Reused an up-to-date sequence instead of building */
+	Skipped,
+	/** Stopped early with an error or was cancelled */
+	Failed
+};
+
+/** Time spent in one phase of a build, compared with the movie's history */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPosePhaseTiming
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Telemetry")
+	FString Name;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Telemetry")
+	double Seconds = 0.0;
+
+	/** Rolling median over previous builds of the same movie; 0 when there is no history */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Telemetry")
+	double MedianSeconds = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Telemetry")
+	bool bRegressed = false;
+};
+
+/** Result of one build, as appended to the movie's history */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseBuildReport
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Telemetry")
+	FString Movie;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Telemetry")
+	EAAANKPoseBuildOutcome Outcome = EAAANKPoseBuildOutcome::Completed;
+
+	/** Wall time from begin to end, including frames a time-sliced build spent idle */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Telemetry")
+	FAAANKPosePhaseTiming Total;
+
+	/** In the order each phase first started */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Telemetry")
+	TArray<FAAANKPosePhaseTiming> Phases;
+
+	/** ActorsSpawned, KeysWritten, AssetsLoaded and anything callers add */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Telemetry")
+	TMap<FString, int64> Counters;
+
+	/** Number of previous builds the medians were taken over */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Telemetry")
+	int32 HistorySamples = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Telemetry")
+	bool bAnyRegressed = false;
+};
+
+
+/**
+ * Phase timers and counters for one scene build at a time, persisted per movie as JSON lines in
+ * Saved/AAANKPose/BuildHistory/<movie>.jsonl. Begin/End nest so the Python and native paths can
+ * both report into the same build; game thread only.
+ */
+class AAANKPOSE_API FAAANKPoseBuildTelemetry
+{
+public:
+	static void BeginBuild(const FString& MovieName);
+
+	/**
+	 * Close the outermost build, append it to the history and flag regressions. Skipped and failed builds
+	 * are recorded with their outcome but never flagged, and are left out of later medians.
+	 * @param RegressionThreshold - Fraction above the rolling median that counts as a regression
+	 */
+	static FAAANKPoseBuildReport EndBuild(float RegressionThreshold = 0.25f);
+
+	static bool IsActive();
+
+	/** Outcome of the active build; the most severe one reported wins, so nested callers can't mask a failure */
+	static void SetOutcome(EAAANKPoseBuildOutcome Outcome);
+
+	/** Phases with the same name accumulate, so a time-sliced step can be timed unit by unit */
+	static void AddPhaseTime(const FString& PhaseName, double Seconds);
+	static void AddCounter(const FString& CounterName, int64 Delta = 1);
+
+	static FString GetHistoryPath(const FString& MovieName);
+
+	/** Standard counter names */
+	static const FString ActorsSpawned;
+	static const FString KeysWritten;
+	static const FString AssetsLoaded;
+};
+
+/** Times the enclosing scope into a phase; a no-op when no build is active */
+class AAANKPOSE_API FAAANKPoseScopedPhase
+{
+public:
+	explicit FAAANKPoseScopedPhase(const FString& InPhaseName);
+	~FAAANKPoseScopedPhase();
+
+private:
+	FString PhaseName;
+	double StartSeconds;
+};
+
+
+/**
+ * FAAANKPoseBuildTelemetry for Python callers
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseTelemetryLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Telemetry")
+	static void BeginBuildTelemetry(const FString& MovieName);
+
+	/** Returns the finished report; Movie is empty if this call did not close the outermost build */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Telemetry")
+	static FAAANKPoseBuildReport EndBuildTelemetry(float RegressionThreshold = 0.25f);
+
+	/** Start timing a phase; phases opened from Python do not nest, a new one closes the previous */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Telemetry")
+	static void BeginPhase(const FString& PhaseName);
+
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Telemetry")
+	static void EndPhase();
+
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Telemetry")
+	static void SetBuildOutcome(EAAANKPoseBuildOutcome Outcome);
+
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Telemetry")
+	static void AddBuildCounter(const FString& CounterName, int64 Delta = 1);
+
+	/** The last MaxEntries builds of a movie, oldest first, as raw JSON lines */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Telemetry")
+	static TArray<FString> GetBuildHistory(const FString& MovieName, int32 MaxEntries = 20);
+};
@@ -0,0 +1,68 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AAANKPoseCallProfiler.generated.h"
+
+
+/** Aggregated cost of one reflected API as called from one place during one build phase */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseCallStat
+{
+	GENERATED_BODY()
+
+	/** Reflected owner and function, e.g. "MovieSceneScriptingDoubleChannel.add_key" */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Profiler")
+	FString Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Profiler")
+	FString Phase;
+
+	/** Python file:line of the caller; empty in rolled-up reports */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Profiler")
+	FString CallSite;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Profiler")
+	int64 Calls = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Profiler")
+	double TotalSeconds = 0.0;
+};
+
+
+/**
+ * Aggregates Python-to-reflection call samples per build phase and ranks the crossings worth replacing
+ * with native batch calls. The Python side (motion_includes/call_profiler.py) collects samples with
+ * sys.setprofile and submits them once per phase, so profiling adds no crossings of its own.
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseCallProfilerLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/** Drop everything collected so far */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Profiler")
+	static void ResetCallProfile();
+
+	/**
+	 * Add samples; the arrays are parallel and samples with the same name, phase and call site accumulate
+	 * @return Number of samples accepted
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Profiler")
+	static int32 SubmitCallSamples(const FString& Phase, const TArray<FString>& Names, const TArray<FString>& CallSites, const TArray<int64>& Calls, const TArray<double>& Seconds);
+
+	/**
+	 * Highest total time first
+	 * @param bByCallSite - Keep call sites separate instead of rolling them up per function and phase
+	 * @param MaxEntries - 0 for all
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Profiler")
+	static TArray<FAAANKPoseCallStat> GetRankedCallReport(bool bByCallSite = false, int32 MaxEntries = 25);
+
+	/** Write the full per-call-site profile as CSV under Saved/AAANKPose/CallProfiles; returns the file path */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Profiler")
+	static FString WriteCallReport(const FString& MovieName);
+};
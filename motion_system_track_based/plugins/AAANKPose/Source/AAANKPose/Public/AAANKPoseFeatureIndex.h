@@ -0,0 +1,125 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AAANKPoseFeatureIndex.generated.h"
+
+class UPoseSearchDatabase;
+
+
+/**
+ * Flat trajectory feature index for one PoseSearch database.
+ * Row R occupies Values[R * Dimension .. (R + 1) * Dimension) and samples RowAssets[R] at RowTimes[R].
+ */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseFeatureIndex
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Index")
+	FString DatabasePath;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Index")
+	int32 Dimension = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Index")
+	int32 SampleRate = 0;
+
+	/** Object paths of the indexed animations, in database order */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Index")
+	TArray<FString> AssetPaths;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Index")
+	TArray<int32> RowAssets;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Index")
+	TArray<float> RowTimes;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Index")
+	TArray<float> Values;
+
+	int32 NumRows() const { return RowTimes.Num(); }
+};
+
+/** How QueryFeatureIndex walks the rows */
+UENUM(BlueprintType)
+enum class EAAANKPoseSearchMode : uint8
+{
+	/** Every row, every feature */
+	Exhaustive,
+	/** Every row, abandoning a row once it is worse than the best so far; same result as Exhaustive */
+	EarlyOut,
+	/** Every 4th row, then the neighbourhood of the best; approximate */
+	Coarse,
+};
+
+/** Best row of a feature index query */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseQueryResult
+{
+	GENERATED_BODY()
+
+	/** INDEX_NONE when the index was empty or the query had the wrong dimension */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Index")
+	int32 Row = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Index")
+	FString AssetPath;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Index")
+	float Time = 0.0f;
+
+	/** Squared feature distance */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Index")
+	float Cost = 0.0f;
+
+	bool IsValid() const { return Row != INDEX_NONE; }
+};
+
+
+/**
+ * Parallel trajectory index build and nearest-row queries over PoseSearch databases' animations
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseFeatureIndexLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/** Root trajectory offsets (seconds) sampled for every row; each contributes X and Y */
+	static const TArray<float>& GetTrajectorySampleOffsets();
+
+	/**
+	 * Build the plugin's trajectory feature index for a database, with per-asset extraction sharded across
+	 * the task graph. This is separate from the engine's search index, which BuildDatabase rebuilds.
+	 * @param Database - The PoseSearch database whose animations are indexed
+	 * @param MaxAssetsInFlight - Assets extracted concurrently; bounds peak memory of the build
+	 * @param OutIndex - Rows merged in database order, so output is identical for any thread count
+	 * @return True if successful
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Index")
+	static bool BuildFeatureIndex(UPoseSearchDatabase* Database, FAAANKPoseFeatureIndex& OutIndex, int32 MaxAssetsInFlight = 32);
+
+	/**
+	 * Index for the database, built with BuildFeatureIndex on first use and kept for the session.
+	 * @return Null if the database could not be indexed
+	 */
+	static const FAAANKPoseFeatureIndex* GetCachedIndex(UPoseSearchDatabase* Database);
+
+	/** Query row for a root moving at a constant Velocity (cm/s) and facing along it */
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Index")
+	static TArray<float> MakeTrajectoryQuery(FVector Velocity);
+
+	/** Nearest row to Query; recorded to the query trace when one is open */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Index")
+	static FAAANKPoseQueryResult QueryFeatureIndex(const FAAANKPoseFeatureIndex& Index, const TArray<float>& Query, EAAANKPoseSearchMode Mode = EAAANKPoseSearchMode::Exhaustive);
+
+	/** QueryFeatureIndex on the database's cached index with a constant-velocity trajectory */
+	UFUNCTION(BlueprintCallable, Category = "PoseSearch|Python")
+	static FAAANKPoseQueryResult QueryDatabase(UPoseSearchDatabase* Database, FVector Velocity, EAAANKPoseSearchMode Mode = EAAANKPoseSearchMode::Exhaustive);
+
+	/** Search without recording or logging; used by QueryFeatureIndex and trace replay */
+	static FAAANKPoseQueryResult SearchIndex(const FAAANKPoseFeatureIndex& Index, TConstArrayView<float> Query, EAAANKPoseSearchMode Mode);
+};
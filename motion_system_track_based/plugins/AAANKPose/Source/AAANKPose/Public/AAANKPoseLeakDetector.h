@@ -0,0 +1,96 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AAANKPoseLeakDetector.generated.h"
+
+
+/** Live state of the editor at one point in time */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseLeakSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Leaks")
+	FString Label;
+
+	/** Live UObjects by class name */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Leaks")
+	TMap<FString, int32> ObjectCounts;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Leaks")
+	int32 TotalObjects = 0;
+
+	/** Tick callbacks the caller knows about, e.g. Slate post-tick handles held by Python */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Leaks")
+	TMap<FString, int32> CallbackCounts;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Leaks")
+	int64 UsedPhysicalBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Leaks")
+	int64 UsedVirtualBytes = 0;
+};
+
+/** One counter that grew between snapshots */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseLeakGrowth
+{
+	GENERATED_BODY()
+
+	/** Class name, callback name, or "UsedPhysicalBytes"/"UsedVirtualBytes" */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Leaks")
+	FString Name;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Leaks")
+	int64 First = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Leaks")
+	int64 Last = 0;
+
+	/** Average growth per run (or Last - First for a plain diff) */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Leaks")
+	double GrowthPerRun = 0.0;
+};
+
+
+/**
+ * Snapshot/diff of UObject counts, caller-registered tick callbacks and memory, kept per movie for the
+ * editor session so growth across repeated builds of the same movie can be spotted.
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseLeakDetectorLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @param CallbackCounts - Counts only the caller can see (Python tick handles and the like)
+	 * @param bCollectGarbageFirst - Run a full GC so only reachable objects are counted
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Leaks")
+	static FAAANKPoseLeakSnapshot TakeLeakSnapshot(const FString& Label, const TMap<FString, int32>& CallbackCounts, bool bCollectGarbageFirst = true);
+
+	/** Everything that grew by at least MinGrowth objects (or bytes for the memory counters) */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Leaks")
+	static TArray<FAAANKPoseLeakGrowth> DiffLeakSnapshots(const FAAANKPoseLeakSnapshot& Before, const FAAANKPoseLeakSnapshot& After, int64 MinGrowth = 1);
+
+	/** Take a snapshot after a build and add it to the movie's run series */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Leaks")
+	static FAAANKPoseLeakSnapshot RecordRunSnapshot(const FString& MovieName, const TMap<FString, int32>& CallbackCounts);
+
+	/**
+	 * Counters that grew on every one of the last NumRuns runs of the movie, largest growth first.
+	 * Memory counters only count as growing when they rise by more than MemoryNoiseBytes (4 MB by default) per run.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Leaks")
+	static TArray<FAAANKPoseLeakGrowth> AnalyzeRunGrowth(const FString& MovieName, int32 NumRuns = 3, int64 MemoryNoiseBytes = 4194304);
+
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Leaks")
+	static int32 GetRecordedRunCount(const FString& MovieName);
+
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Leaks")
+	static void ResetRunHistory(const FString& MovieName);
+};
@@ -0,0 +1,116 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AAANKPoseLevelTemplate.generated.h"
+
+class UWorld;
+
+
+/** Per-movie changes to a cloned template level; anything not enabled keeps the template's value */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseLevelOverrides
+{
+	GENERATED_BODY()
+
+	/** Fog fields below, as scene.json's add_atmosphere command with presets already resolved */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Level")
+	bool bOverrideFog = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Level")
+	float FogDensity = 0.02f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Level")
+	FLinearColor FogColor = FLinearColor(0.6f, 0.7f, 1.0f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Level")
+	float FogHeightFalloff = 0.2f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Level")
+	float FogMaxOpacity = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Level")
+	float FogStartDistance = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Level")
+	bool bVolumetricFog = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Level")
+	float VolumetricScattering = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Level")
+	FLinearColor VolumetricAlbedo = FLinearColor(0.9f, 0.9f, 0.9f);
+
+	/** Rotation and lux of the template's directional light */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Level")
+	bool bOverrideSun = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Level")
+	FRotator SunRotation = FRotator(-45.0f, 0.0f, 0.0f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Level")
+	float SunIntensity = 10.0f;
+};
+
+
+/**
+ * New-level movies start from a prepared template map (floor, sun, sky, fog already placed) that is
+ * duplicated in one step, instead of spawning the basic level actor by actor and saving it each run.
+ * Editor only; every function fails cleanly in other builds.
+ */
+class AAANKPOSE_API FAAANKPoseLevelTemplate
+{
+public:
+	/** Where PrepareTemplate puts the movie template */
+	static const TCHAR* DefaultTemplate;
+
+	/** Engine Basic map the movie template is first made from */
+	static const TCHAR* EngineTemplate;
+
+	/** /Game/Movies/Levels/<Scene>, named like the movie's sequence (FAAANKPoseSceneBuild::GetSequenceBaseName) */
+	static FString GetMovieLevelPath(const FString& SceneName);
+
+	/**
+	 * Make sure TemplatePath exists: the first call copies the engine Basic map there and saves it once,
+	 * later calls only check the asset registry. The map can then be dressed by hand.
+	 */
+	static bool PrepareTemplate(const FString& TemplatePath);
+
+	/**
+	 * Open LevelPath as a copy of TemplatePath with Overrides applied. A level already cloned for this movie
+	 * is opened as it is, so re-runs don't duplicate again.
+	 */
+	static bool CreateMovieLevel(const FString& LevelPath, const FString& TemplatePath, const FAAANKPoseLevelOverrides& Overrides);
+
+	/** Apply Overrides to the first fog and directional light in World; false if one it needs is missing */
+	static bool ApplyOverrides(UWorld& World, const FAAANKPoseLevelOverrides& Overrides);
+};
+
+
+/**
+ * Python usage:
+ *   overrides = unreal.AAANKPoseLevelOverrides(override_fog=True, fog_density=0.05)
+ *   path = unreal.AAANKPoseLevelTemplateLibrary.get_movie_level_path(scene_name)
+ *   unreal.AAANKPoseLevelTemplateLibrary.create_movie_level(path, "", overrides)
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseLevelTemplateLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/** @param TemplatePath - Template map to clone; the default movie template (prepared on first use) when empty */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Level")
+	static bool CreateMovieLevel(const FString& LevelPath, const FString& TemplatePath, const FAAANKPoseLevelOverrides& Overrides);
+
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Level")
+	static bool PrepareTemplate(const FString& TemplatePath);
+
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Level", meta = (WorldContext = "WorldContextObject"))
+	static bool ApplyLevelOverrides(UObject* WorldContextObject, const FAAANKPoseLevelOverrides& Overrides);
+
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Level")
+	static FString GetMovieLevelPath(const FString& SceneName);
+};
@@ -0,0 +1,154 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AAANKPoseLightRig.generated.h"
+
+class AActor;
+class UWorld;
+
+
+/** Same names as motion_structs.enums.LightType */
+UENUM(BlueprintType)
+enum class EAAANKPoseLightType : uint8
+{
+	Point,
+	Directional,
+	Spot,
+	Rect,
+	Sky
+};
+
+/** One light of a rig; fields that do not apply to the light type are ignored */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseLightDescriptor
+{
+	GENERATED_BODY()
+
+	/** Actor label */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	FString Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	EAAANKPoseLightType LightType = EAAANKPoseLightType::Point;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	FTransform Transform;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	float Intensity = 5000.0f;
+
+	/** Point, Spot and Rect only */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	ELightUnits IntensityUnits = ELightUnits::Unitless;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	FLinearColor Color = FLinearColor::White;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	bool bCastShadows = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	bool bCastVolumetricShadow = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	float AttenuationRadius = 1000.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	float InnerConeAngle = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	float OuterConeAngle = 44.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	float SourceWidth = 64.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	float SourceHeight = 64.0f;
+
+	/** Directional only: drives the sky atmosphere */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	bool bAtmosphereSunLight = false;
+
+	/** Light shafts (god rays); occlusion is directional only */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	bool bEnableLightShaftBloom = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	float BloomScale = 0.2f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	float BloomThreshold = 8.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	bool bEnableLightShaftOcclusion = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	float OcclusionMaskDarkness = 0.5f;
+};
+
+/** A complete lighting setup */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseLightRig
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Lights")
+	TArray<FAAANKPoseLightDescriptor> Lights;
+};
+
+
+/**
+ * Spawns whole light rigs. Every light is spawned deferred and configured before construction
+ * finishes. Its components are already registered by then, so the settings are written straight
+ * to the component properties. Each component then recreates its render state once instead of
+ * once per setting. Named presets ("god_rays", "cathedral") are built once and kept as descriptors.
+ */
+class AAANKPOSE_API FAAANKPoseLightRigBuilder
+{
+public:
+	/** @return Spawned lights in rig order; null where a light failed */
+	static TArray<AActor*> Spawn(UWorld* World, const FAAANKPoseLightRig& Rig);
+
+	/** Cached preset, or null if no preset has that name */
+	static const FAAANKPoseLightRig* FindPreset(FName PresetName);
+
+	/** Adds or replaces a preset */
+	static void RegisterPreset(FName PresetName, const FAAANKPoseLightRig& Rig);
+
+	static TArray<FName> GetPresetNames();
+};
+
+
+/**
+ * Python usage:
+ *   light = unreal.AAANKPoseLightDescriptor(name="Sun", light_type=unreal.AAANKPoseLightType.DIRECTIONAL, intensity=10.0)
+ *   actors = unreal.AAANKPoseLightRigLibrary.spawn_light_rig(None, unreal.AAANKPoseLightRig(lights=[light]))
+ *   actors = unreal.AAANKPoseLightRigLibrary.spawn_light_rig_preset(None, "cathedral")
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseLightRigLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/** @param WorldContextObject - Any object in the target world; the editor world when null */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Lights", meta = (WorldContext = "WorldContextObject"))
+	static TArray<AActor*> SpawnLightRig(UObject* WorldContextObject, const FAAANKPoseLightRig& Rig);
+
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Lights", meta = (WorldContext = "WorldContextObject"))
+	static TArray<AActor*> SpawnLightRigPreset(UObject* WorldContextObject, FName PresetName);
+
+	/** @return False if no preset has that name */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Lights")
+	static bool GetLightRigPreset(FName PresetName, FAAANKPoseLightRig& OutRig);
+
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Lights")
+	static void RegisterLightRigPreset(FName PresetName, const FAAANKPoseLightRig& Rig);
+
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Lights")
+	static TArray<FName> GetLightRigPresetNames();
+};
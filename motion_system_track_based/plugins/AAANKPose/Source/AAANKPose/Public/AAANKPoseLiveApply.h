@@ -0,0 +1,64 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AAANKPoseLiveApply.generated.h"
+
+class ULevelSequence;
+
+
+/**
+ * Re-keys individual actors of an already built sequence from their track files, so an edit to one
+ * actor's transform track (single file or chunked), animation.json or focal_length.json shows up without
+ * rebuilding the movie.
+ * Actors are matched to possessables by name, as FAAANKPoseSceneBuild binds them, in the master
+ * sequence and in every shot subsequence of a shot partitioned build.
+ */
+class AAANKPOSE_API FAAANKPoseLiveApply
+{
+public:
+	/**
+	 * Replace the keys of the named actors with what is on disk now
+	 * @return Actors whose tracks were rewritten; actors without a binding in the sequence are skipped
+	 */
+	static int32 ApplyActorTracks(ULevelSequence* Sequence, const FString& MovieFolder, const TArray<FString>& ActorNames);
+
+	/**
+	 * Whether a change to this file (relative to the movie folder) can be applied per actor.
+	 * meta.json, camera_cuts.json and settings.json change what gets spawned, and focus_distance.json and
+	 * attach.json are only applied by the Python build; all of them need a full rebuild.
+	 * @param OutActorName - Actor the file belongs to, when it can be applied
+	 */
+	static bool IsActorTrackFile(const FString& RelativePath, FString& OutActorName);
+
+	/** True for files whose change makes the built sequence stale as a whole */
+	static bool NeedsRebuild(const FString& RelativePath);
+};
+
+
+/**
+ * Python access to live apply. Watching is editor only; the module debounces bursts of writes
+ * (save_to_tracks rewrites every file of every actor) and re-keys only actors whose file contents changed.
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseLiveApplyLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/** Re-key Sequence whenever actor track files under MovieFolder change; replaces any previous watch of the folder */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Scene")
+	static bool WatchMovieFolder(const FString& MovieFolder, ULevelSequence* Sequence);
+
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Scene")
+	static bool UnwatchMovieFolder(const FString& MovieFolder);
+
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Scene")
+	static TArray<FString> GetWatchedMovieFolders();
+
+	/** Apply now without waiting for the watcher; returns actors rewritten */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Scene")
+	static int32 ApplyChangedActors(ULevelSequence* Sequence, const FString& MovieFolder, const TArray<FString>& ActorNames);
+};
@@ -0,0 +1,53 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "AAANKPoseMannequin.generated.h"
+
+class USceneComponent;
+class USkeletalMesh;
+class USkeletalMeshComponent;
+
+
+/**
+ * Minimal character for sequencer-driven playback.
+ * A skeletal mesh under a scene root, no movement component, no input, and no actor tick;
+ * the pose is only evaluated while the mesh is rendered.
+ */
+UCLASS(BlueprintType)
+class AAANKPOSE_API AAAANKPoseMannequin : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AAAANKPoseMannequin(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
+
+	/** Tag used by cleanup.delete_old_actors to find generated actors */
+	static const FName MotionSystemTag;
+
+	/** Assign the mesh and its rotation inside the actor (CharacterData.initial_yaw) */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Mannequin")
+	void SetupMannequin(USkeletalMesh* SkeletalMesh, FRotator MeshRotation, const TArray<FName>& ExtraTags);
+
+	/**
+	 * Add a scene component that follows a mesh socket, for attach tracks to target.
+	 * @return The existing anchor if one was already added for this socket
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Mannequin")
+	USceneComponent* AddSocketAnchor(FName SocketName);
+
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Mannequin")
+	USkeletalMeshComponent* GetMesh() const { return Mesh; }
+
+private:
+	UPROPERTY(VisibleAnywhere, Category = "AAANKPose|Mannequin")
+	TObjectPtr<USceneComponent> SceneRoot;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AAANKPose|Mannequin", meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<USkeletalMeshComponent> Mesh;
+
+	UPROPERTY(VisibleAnywhere, Category = "AAANKPose|Mannequin")
+	TMap<FName, TObjectPtr<USceneComponent>> SocketAnchors;
+};
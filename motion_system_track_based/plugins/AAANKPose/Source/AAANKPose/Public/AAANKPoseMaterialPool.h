@@ -0,0 +1,55 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AAANKPoseMaterialPool.generated.h"
+
+class UMaterialInterface;
+
+
+/**
+ * One shared solid-color material per (base material, color) for markers, axis lines and other debug geometry.
+ * In the editor each is a constant instance saved under /Game/AAANKPose/MaterialPool, so it is created once
+ * and found again in later runs and sessions; other builds pool rooted dynamic instances for the session.
+ * Colors are pooled at 8-bit sRGB precision.
+ */
+class AAANKPOSE_API FAAANKPoseMaterialPool
+{
+public:
+	/** Used when no base material is given; tinted through its "Color" parameter */
+	static const TCHAR* DefaultBaseMaterial;
+
+	/** Folder the editor saves pooled instances to */
+	static const TCHAR* PoolFolder;
+
+	/**
+	 * The pooled material of Color over BaseMaterial (DefaultBaseMaterial when null), created on first use.
+	 * Falls back to the base material itself if it has no Color, BaseColor or TintColor vector parameter.
+	 */
+	static UMaterialInterface* GetColorMaterial(const FLinearColor& Color, UMaterialInterface* BaseMaterial = nullptr);
+
+	/** Materials handed out this session */
+	static int32 Num();
+};
+
+
+/**
+ * Python usage:
+ *   material = unreal.AAANKPoseMaterialPoolLibrary.get_color_material(unreal.LinearColor(1, 0, 0, 1), None)
+ *   component.set_material(0, material)
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseMaterialPoolLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/** @param BaseMaterial - Material to tint; /Engine/BasicShapes/BasicShapeMaterial when null */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Materials")
+	static UMaterialInterface* GetColorMaterial(FLinearColor Color, UMaterialInterface* BaseMaterial);
+
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Materials")
+	static int32 GetPooledMaterialCount();
+};
@@ -0,0 +1,81 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AAANKPosePropertyBatch.generated.h"
+
+
+/** One property assignment: Object.Path = Value */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPosePropertyWrite
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Properties")
+	TObjectPtr<UObject> Object = nullptr;
+
+	/**
+	 * Dot-separated property names through structs and object references, e.g. "FocusSettings.FocusMethod"
+	 * or "LightComponent.Intensity". Python spellings ("focus_settings.focus_method") match too.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Properties")
+	FString Path;
+
+	/** Property export text: "True", "0.5", "Manual", "(R=1,G=0,B=0,A=1)", an object path */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Properties")
+	FString Value;
+};
+
+/** What a batch applied */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPosePropertyBatchResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Properties")
+	int32 Applied = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Properties")
+	int32 Failed = 0;
+
+	/** Objects that received their one change notification */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Properties")
+	int32 ObjectsChanged = 0;
+
+	/** "<object>.<path>: reason" for each failed write */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Properties")
+	TArray<FString> Errors;
+};
+
+
+/**
+ * Sets many properties on many objects in one call. Paths resolve once per class into a cached property chain;
+ * each written object gets Modify and PreEditChange before its first write and a single PostEditChange after
+ * the last, instead of one round-trip and notification per set_editor_property.
+ */
+class AAANKPOSE_API FAAANKPosePropertyBatch
+{
+public:
+	static FAAANKPosePropertyBatchResult Apply(TConstArrayView<FAAANKPosePropertyWrite> Writes);
+
+	/** Drop cached chains, e.g. after classes were recompiled */
+	static void ResetCache();
+};
+
+
+/**
+ * Python usage (motion_includes/property_batch.set_properties converts values):
+ *   writes = [unreal.AAANKPosePropertyWrite(object=component, path="intensity", value="5000")]
+ *   result = unreal.AAANKPosePropertyBatchLibrary.set_properties(writes)
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPosePropertyBatchLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Properties")
+	static FAAANKPosePropertyBatchResult SetProperties(const TArray<FAAANKPosePropertyWrite>& Writes);
+};
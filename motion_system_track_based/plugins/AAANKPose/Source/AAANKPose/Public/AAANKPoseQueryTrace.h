@@ -0,0 +1,111 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AAANKPoseFeatureIndex.h"
+#include "AAANKPoseQueryTrace.generated.h"
+
+class UPoseSearchDatabase;
+
+
+/** One recorded query, as read back from a trace */
+struct AAANKPOSE_API FAAANKPoseTracedQuery
+{
+	FString DatabasePath;
+	EAAANKPoseSearchMode Mode = EAAANKPoseSearchMode::Exhaustive;
+	TArray<float> Query;
+	FAAANKPoseQueryResult Result;
+	float Microseconds = 0.0f;
+};
+
+/** Recorded vs. replayed latency and agreement of a trace */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseReplayReport
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Trace")
+	FString TracePath;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Trace")
+	int32 Queries = 0;
+
+	/** Queries skipped because their database could not be indexed or had another dimension */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Trace")
+	int32 Skipped = 0;
+
+	/** Fraction of replayed queries that picked the same asset within one sample of the recorded time */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Trace")
+	double Agreement = 0.0;
+
+	/** Mean of replayed minus recorded cost; negative means the replay found closer rows */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Trace")
+	double MeanCostDelta = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Trace")
+	double RecordedMedianMicroseconds = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Trace")
+	double RecordedP99Microseconds = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Trace")
+	double ReplayMedianMicroseconds = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Trace")
+	double ReplayP99Microseconds = 0.0;
+};
+
+
+/**
+ * Binary trace of feature index queries (query vector, database, mode, result and latency), written as
+ * queries happen so it survives an editor crash. Database and asset paths are stored once in a string
+ * table; a query record is ~60 bytes at the default dimension. Traces live in Saved/AAANKPose/QueryTraces.
+ */
+class AAANKPOSE_API FAAANKPoseQueryTrace
+{
+public:
+	static bool BeginRecording(const FString& FilePath);
+
+	/** Close the trace; returns the number of queries recorded */
+	static int32 EndRecording();
+
+	static bool IsRecording();
+
+	static void Record(const FString& DatabasePath, EAAANKPoseSearchMode Mode, TConstArrayView<float> Query, const FAAANKPoseQueryResult& Result, double Seconds);
+
+	static bool Load(const FString& FilePath, TArray<FAAANKPoseTracedQuery>& OutQueries);
+
+	static FString GetTraceDirectory();
+};
+
+
+/**
+ * Query trace recording and offline replay for Python callers
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseQueryTraceLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/** Start a trace named <Label>_<timestamp>.aqtrace; returns its path, or empty if one is already open */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Trace")
+	static FString BeginQueryTrace(const FString& Label);
+
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Trace")
+	static int32 EndQueryTrace();
+
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Trace")
+	static bool IsQueryTraceRecording();
+
+	/**
+	 * Re-run every query of a trace and compare with what was recorded
+	 * @param Database - Database to replay against; null replays each query against the database it was recorded on
+	 * @param Mode - Search mode of the replay, whatever the recorded queries used
+	 * @param Repetitions - Each query is timed this many times and the fastest counts
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Trace")
+	static FAAANKPoseReplayReport ReplayQueryTrace(const FString& TracePath, UPoseSearchDatabase* Database, EAAANKPoseSearchMode Mode = EAAANKPoseSearchMode::Exhaustive, int32 Repetitions = 5);
+};
@@ -0,0 +1,56 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AAANKPoseQuietMode.generated.h"
+
+
+/**
+ * Suspends editor UI work during bulk operations: realtime viewport redraws, selection and
+ * details-panel notifications, transaction toasts and asset registry re-queries.
+ * Scopes nest; the single refresh happens when the outermost one ends, and restores the selection.
+ */
+class AAANKPOSE_API FAAANKPoseQuietScope
+{
+public:
+	FAAANKPoseQuietScope();
+	~FAAANKPoseQuietScope();
+
+	static void Enter();
+	static void Exit();
+	static bool IsActive();
+
+private:
+	FAAANKPoseQuietScope(const FAAANKPoseQuietScope&) = delete;
+	FAAANKPoseQuietScope& operator=(const FAAANKPoseQuietScope&) = delete;
+};
+
+
+/**
+ * Begin/End pair of FAAANKPoseQuietScope for Python callers; each Begin returns a token that ends exactly its own scope
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseQuietModeLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Suspend viewport redraw and editor notifications until EndQuietMode is called with the returned token
+	 * @return Token for EndQuietMode
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Editor")
+	static int32 BeginQuietMode();
+
+	/**
+	 * Resume; the outermost scope redraws viewports and refreshes the outliner once
+	 * @return False if Token was already ended or never issued, in which case nothing changes
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Editor")
+	static bool EndQuietMode(int32 Token);
+
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Editor")
+	static bool IsQuietModeActive();
+};
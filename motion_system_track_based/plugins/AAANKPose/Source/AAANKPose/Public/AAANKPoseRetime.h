@@ -0,0 +1,111 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AAANKPoseRetime.generated.h"
+
+class ULevelSequence;
+
+
+/** How to retime a movie; the defaults leave it unchanged */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseRetimeSettings
+{
+	GENERATED_BODY()
+
+	/** Frame rate to deliver at; 0 keeps the movie's own */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	int32 TargetFps = 0;
+
+	/** Uniform playback speed when there is no warp curve: 0.5 plays at half speed and twice as long */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	float Speed = 1.0f;
+
+	/**
+	 * Optional time-warp: X = output seconds, Y = source seconds, both strictly increasing.
+	 * The curve is piecewise linear and continues past its ends along the end segments.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	TArray<FVector2D> WarpCurve;
+};
+
+/** What a retime changed */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseRetimeResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Tracks")
+	bool bSucceeded = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Tracks")
+	int32 SourceFps = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Tracks")
+	int32 TargetFps = 0;
+
+	/** Movie length in seconds before and after */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Tracks")
+	float SourceDuration = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Tracks")
+	float Duration = 0.0f;
+
+	/** Actors (track folder) or sections (sequence) whose timing was rewritten */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Tracks")
+	int32 Retimed = 0;
+
+	/** Transform keys written, or sequence keys moved */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Tracks")
+	int32 Keys = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Tracks")
+	float Seconds = 0.0f;
+};
+
+
+/**
+ * Frame-rate conversion and time-warping of an already planned movie, so a 60 fps plan can be delivered at
+ * 24/30 fps or slowed down without re-running motion_planner.
+ *
+ * Dense transform tracks (the planner's per-frame keys) are resampled at every output frame; sparse tracks
+ * (camera placements) and every other frame or seconds field keep their keys and move them through the warp.
+ * Animation sections are scaled by the warp's rate over their span so feet stay planted.
+ */
+class AAANKPOSE_API FAAANKPoseRetime
+{
+public:
+	/**
+	 * Retime the dist/<movie> folder MovieFolder into OutputFolder (in place when empty or the same folder).
+	 * A copy is renamed after its folder so building it doesn't number its sequence after the original.
+	 */
+	static FAAANKPoseRetimeResult RetimeTrackFolder(const FString& MovieFolder, const FString& OutputFolder, const FAAANKPoseRetimeSettings& Settings);
+
+	/**
+	 * Retime a built sequence in place: moves every key, section and playback range (in its shot subsequences too),
+	 * sets the display rate and scales animation play rates. Clears the build-cache and shot stamps, since the
+	 * sequence no longer matches its track folder. The caller saves.
+	 */
+	static FAAANKPoseRetimeResult RetimeSequence(ULevelSequence* Sequence, const FAAANKPoseRetimeSettings& Settings);
+};
+
+
+/**
+ * Python usage:
+ *   settings = unreal.AAANKPoseRetimeSettings(target_fps=24, speed=1.0)
+ *   result = unreal.AAANKPoseRetimeLibrary.retime_track_folder("dist/MyMovie", "dist/MyMovie_24", settings)
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseRetimeLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Tracks")
+	static FAAANKPoseRetimeResult RetimeTrackFolder(const FString& MovieFolder, const FString& OutputFolder, const FAAANKPoseRetimeSettings& Settings);
+
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Tracks")
+	static FAAANKPoseRetimeResult RetimeSequence(ULevelSequence* Sequence, const FAAANKPoseRetimeSettings& Settings);
+};
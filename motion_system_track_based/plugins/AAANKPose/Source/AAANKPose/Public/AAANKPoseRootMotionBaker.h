@@ -0,0 +1,35 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AAANKPoseRootMotionBaker.generated.h"
+
+
+/**
+ * Rewrites actor transform tracks from the root motion of their animation sections,
+ * so the path is driven by the animation instead of the other way round.
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseRootMotionBakerLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Bake transform.json for every actor in the movie folder that has animation.json.
+	 * Root motion is accumulated along the yaw of the planned transform track (the heading curve);
+	 * the planned Z, pitch and roll are kept. Frames outside every section follow the plan's own movement,
+	 * and the bake ends with the last section.
+	 * The first bake keeps the planned track in <actor>/planned/, and later bakes start from it, so baking
+	 * twice gives the same result; save_to_tracks clears it when the plan is rewritten.
+	 * @param MovieFolder - dist/<movie> folder written by save_to_tracks
+	 * @param MeshYawOffset - Relative yaw of the skeletal mesh inside the actor. Planned yaw already
+	 *                        includes CharacterData.initial_yaw, so this is 0 for actors spawned by run_scene
+	 * @param KeyInterval - Emit a key every N frames; the last frame is always keyed
+	 * @return Number of actors whose transform track was rewritten
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Tracks")
+	static int32 BakeRootMotionTracks(const FString& MovieFolder, float MeshYawOffset = 0.0f, int32 KeyInterval = 1);
+};
@@ -0,0 +1,57 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AAANKPoseSaveService.generated.h"
+
+
+/** Outcome of saving one package */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPosePackageSaveResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Save")
+	FString PackageName;
+
+	/** Time spent serializing this package; disk writes overlap and are reported once per batch */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Save")
+	float Seconds = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Save")
+	bool bSaved = false;
+};
+
+
+/**
+ * Collects the sequence and PoseSearch database assets dirtied during a build and saves them in one batch
+ * with async file writes. Packages under FAAANKPoseSceneBuild::SequenceFolder and database packages are
+ * collected; maps are left to FEditorFileUtils.
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseSaveLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/** Start recording sequence and database packages marked dirty until EndPackageCollection or a save */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Save")
+	static void BeginPackageCollection();
+
+	/** Stop recording; returns the number of packages collected so far */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Save")
+	static int32 EndPackageCollection();
+
+	/** Save everything collected since BeginPackageCollection, then stop collecting */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Save")
+	static TArray<FAAANKPosePackageSaveResult> SaveCollectedPackages();
+
+	/** Save all dirty content packages whose name starts with PathPrefix (e.g. "/Game/Sequences") */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Save")
+	static TArray<FAAANKPosePackageSaveResult> SaveDirtyPackagesUnderPath(const FString& PathPrefix);
+
+	/** Save the given packages as one batch: serialize each, then wait once for all file writes */
+	static TArray<FAAANKPosePackageSaveResult> SavePackagesBatched(const TArray<UPackage*>& Packages);
+};
@@ -0,0 +1,220 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AAANKPoseSequencePrewarm.h"
+#include "AAANKPoseShotPartition.h"
+#include "AAANKPoseTrackFolder.h"
+#include "UObject/GCObject.h"
+#include "AAANKPoseSceneBuild.generated.h"
+
+class AActor;
+class FJsonObject;
+class ULevelSequence;
+class UMovieScene;
+class UMovieScene3DTransformSection;
+class UMovieSceneFloatSection;
+class UMovieSceneSkeletalAnimationTrack;
+class UWorld;
+
+
+/** Resumable stages of a native scene build, in execution order */
+UENUM(BlueprintType)
+enum class EAAANKPoseSceneBuildStep : uint8
+{
+	/** Fingerprint the track folder; finishes the build at once if the last sequence is up to date */
+	CheckCache,
+	Cleanup,
+	LoadTracks,
+	CreateSequence,
+	/** One actor per unit */
+	Spawn,
+	/** Split into shots and prepare their tracks in parallel; nothing to do without a partition */
+	PartitionShots,
+	/** One actor per unit, or one shot subsequence per unit when partitioned */
+	KeyActors,
+	CameraCuts,
+	Finalize,
+	/** Compile the sequence and wait for its assets to be resident so the first play doesn't hitch */
+	Prewarm,
+	Done
+};
+
+/** How the native builder spawns an actor, decided from its settings.json like run_scene does */
+enum class EAAANKPoseSceneActorType : uint8
+{
+	Mannequin,
+	Camera,
+	Marker,
+	/** Lights and splines are still created by the Python path */
+	Unsupported
+};
+
+/** Everything the builder knows about one actor folder */
+struct FAAANKPoseSceneActor
+{
+	FString Name;
+	FString Folder;
+	EAAANKPoseSceneActorType Type = EAAANKPoseSceneActorType::Mannequin;
+	TSharedPtr<FJsonObject> Settings;
+
+	/** Every key, or only the first one when the track is chunked and streamed while keying */
+	TArray<FAAANKPoseTransformKey> TransformKeys;
+	bool bStreamTransform = false;
+	TArray<FAAANKPoseAnimationSection> AnimationSections;
+	/** focal_length.json as (display frame, millimetres) */
+	TArray<TPair<int32, float>> FocalLengthKeys;
+
+	TObjectPtr<AActor> Actor = nullptr;
+	FGuid Binding;
+};
+
+
+/**
+ * Native equivalent of run_scene._build_scene for track folders, split into small units of work
+ * so it can be driven a few milliseconds at a time. Lights, splines, look-at timelines, scene.json
+ * and audio are left to the Python path.
+ */
+class AAANKPOSE_API FAAANKPoseSceneBuild : public FGCObject
+{
+public:
+	FAAANKPoseSceneBuild(const FString& InMovieFolder, UWorld* InWorld);
+
+	/**
+	 * Build into one subsequence per shot under a cinematic shot track instead of keying the master directly.
+	 * Shot sequences keep a stable path per movie, so a rebuild re-keys only the shots whose content changed.
+	 * Call before the first Tick.
+	 */
+	void SetShotPartition(EAAANKPoseShotPartition InPartition, float InWindowSeconds);
+
+	/** Reuse the last sequence built from a byte-identical folder (default); false always rebuilds. Call before the first Tick. */
+	void SetUseBuildCache(bool bInUseBuildCache);
+
+	/** Longest the Prewarm step waits for streaming (default 10 s); 0 skips it */
+	void SetPrewarmTimeout(float InSeconds);
+	const FAAANKPosePrewarmResult& GetPrewarmResult() const { return Prewarm.GetResult(); }
+
+	/**
+	 * Run units of work until the build finishes or FPlatformTime::Seconds() passes the deadline.
+	 * At least one unit runs per call, so a build always makes progress.
+	 * @return true once the build is finished (successfully, with an error, or cancelled)
+	 */
+	bool Tick(double DeadlineSeconds);
+
+	/** Run to completion without yielding */
+	bool RunToCompletion();
+
+	/** Stop at the next unit boundary; actors and the sequence created so far are kept */
+	void Cancel();
+
+	bool IsFinished() const { return Step == EAAANKPoseSceneBuildStep::Done; }
+	bool Succeeded() const { return IsFinished() && !bCancelled && Error.IsEmpty(); }
+	bool WasCancelled() const { return bCancelled; }
+	/** Finished without building because the existing sequence matched the track folder's fingerprint */
+	bool ReusedSequence() const { return bReusedSequence; }
+
+	/** 0..1 across all steps */
+	float GetProgress() const;
+	EAAANKPoseSceneBuildStep GetStep() const { return Step; }
+	const FString& GetError() const { return Error; }
+	const FString& GetMovieFolder() const { return MovieFolder; }
+	const FAAANKPoseMovieMeta& GetMeta() const { return Meta; }
+	const TArray<FAAANKPoseSceneActor>& GetActors() const { return SceneActors; }
+	ULevelSequence* GetSequence() const { return Sequence; }
+	const TArray<TObjectPtr<ULevelSequence>>& GetShotSequences() const { return ShotSequences; }
+	/** Shots whose hash matched the existing subsequence and were only rebound */
+	int32 GetShotsSkipped() const { return ShotsSkipped; }
+
+	/** Replace the location and rotation keys of a transform section (cubic, auto tangents); returns keys written */
+	static int32 WriteTransformKeys(UMovieScene3DTransformSection& Section, const TArray<FAAANKPoseTransformKey>& Keys);
+
+	/** Replace the location and rotation keys with a reader's windows, one window in memory at a time; returns keys written */
+	static int32 StreamTransformKeys(UMovieScene3DTransformSection& Section, FAAANKPoseTransformReader& Reader);
+
+	/** Replace the keys of a focal length section; returns keys written */
+	static int32 WriteFocalLengthKeys(UMovieSceneFloatSection& Section, const TArray<TPair<int32, float>>& Keys);
+
+	/** Add one section per entry; sections without an end frame run to DefaultEndFrame */
+	static void AddAnimationSections(UMovieSceneSkeletalAnimationTrack& Track, const TArray<FAAANKPoseAnimationSection>& Sections, int32 DefaultEndFrame);
+
+	/** Display-rate frame to tick of the given movie scene */
+	static FFrameNumber DisplayFrameToTick(const UMovieScene& InMovieScene, double DisplayFrame);
+
+	/** run_scene keys one extra second of frames past the last key */
+	static const int32 TailFrames;
+
+	/** Content folder both build paths create sequences in, as <BaseName>_NNN */
+	static const TCHAR* const SequenceFolder;
+
+	/** meta.json's scene name as sequence_setup.create_sequence sanitizes it */
+	static FString GetSequenceBaseName(const FString& SceneName);
+
+	//~ FGCObject
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FAAANKPoseSceneBuild"); }
+
+private:
+	/** Performs one unit of the current step and advances Step/Cursor */
+	void RunUnit();
+	void Advance();
+	void Fail(const FString& Message);
+
+	void RunCheckCache();
+	void RunCleanupUnit();
+	void RunLoadTracksUnit();
+	void RunCreateSequence();
+	void RunSpawn();
+	void RunPartitionShots();
+	void RunKeyActorUnit();
+	void RunShotUnit();
+	void RunCameraCuts();
+	void RunFinalize();
+	void RunPrewarm();
+
+	void KeyTransform(FAAANKPoseSceneActor& SceneActor);
+	void KeyAnimations(FAAANKPoseSceneActor& SceneActor);
+	void KeyFocalLength(FAAANKPoseSceneActor& SceneActor);
+	FGuid BindComponent(FAAANKPoseSceneActor& SceneActor, UObject* Component);
+
+	/** Re-key a shot subsequence from its prepared tracks, replacing whatever it held */
+	void KeyShot(ULevelSequence& ShotSequence, const FAAANKPoseShot& Shot);
+	/** Point an unchanged shot's bindings at this build's actors; false if something could not be matched */
+	bool RebindShot(ULevelSequence& ShotSequence, const FAAANKPoseShot& Shot);
+
+	/** Folded into the fingerprint so differently configured builds of one folder don't match */
+	FString GetBuildOptions() const;
+
+	/** Display-rate frame to sequence tick */
+	FFrameNumber ToTick(double DisplayFrame) const;
+
+	FString MovieFolder;
+	TWeakObjectPtr<UWorld> World;
+	FAAANKPoseMovieMeta Meta;
+
+	EAAANKPoseSceneBuildStep Step = EAAANKPoseSceneBuildStep::CheckCache;
+	/** Position inside the current step; unit count is per actor for the looping steps */
+	int32 Cursor = 0;
+	bool bCancelled = false;
+	FString Error;
+	bool bUseBuildCache = true;
+	bool bReusedSequence = false;
+	FString Fingerprint;
+	/** Set by RunToCompletion: nothing streams between units, so Prewarm has to block */
+	bool bBlocking = false;
+	float PrewarmTimeoutSeconds = 10.0f;
+	FAAANKPoseSequencePrewarm Prewarm;
+
+	TArray<TObjectPtr<AActor>> ActorsToDelete;
+	TArray<FAAANKPoseSceneActor> SceneActors;
+	TObjectPtr<ULevelSequence> Sequence = nullptr;
+	TObjectPtr<UMovieScene> MovieScene = nullptr;
+	/** Last keyed display frame across all tracks */
+	int32 TotalFrames = 0;
+
+	EAAANKPoseShotPartition Partition = EAAANKPoseShotPartition::None;
+	float ShotWindowSeconds = 10.0f;
+	TArray<FAAANKPoseShot> Shots;
+	TArray<TObjectPtr<ULevelSequence>> ShotSequences;
+	int32 ShotsSkipped = 0;
+};
@@ -0,0 +1,92 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AAANKPoseSceneBuild.h"
+#include "Containers/Ticker.h"
+#include "UObject/Object.h"
+#include "AAANKPoseSceneBuildExecutor.generated.h"
+
+class ULevelSequence;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FAAANKPoseSceneBuildFinished, bool, bSucceeded, ULevelSequence*, Sequence);
+
+
+/**
+ * Drives an FAAANKPoseSceneBuild from the core ticker, spending at most a fixed budget per editor
+ * frame so viewports and Remote Control requests keep being serviced while a movie builds.
+ * Python usage: executor = unreal.AAANKPoseSceneBuildExecutor.start_scene_build(None, folder, 8.0)
+ */
+UCLASS(BlueprintType)
+class AAANKPOSE_API UAAANKPoseSceneBuildExecutor : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Begin a time-sliced build of a dist/<movie> track folder. The executor keeps itself alive until it finishes.
+	 * @param WorldContextObject - World to build in; the editor world when null
+	 * @param MovieFolder - Track folder written by save_to_tracks
+	 * @param BudgetMilliseconds - Work per frame; one unit of work always runs even if it overshoots
+	 * @param Partition - Build into shot subsequences under the returned master sequence; None keys the master directly
+	 * @param ShotWindowSeconds - Shot length for TimeWindows
+	 * @param bForceRebuild - Build even if the last sequence was built from an identical track folder
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Scene", meta = (WorldContext = "WorldContextObject"))
+	static UAAANKPoseSceneBuildExecutor* StartSceneBuild(UObject* WorldContextObject, const FString& MovieFolder, float BudgetMilliseconds = 8.0f,
+		EAAANKPoseShotPartition Partition = EAAANKPoseShotPartition::None, float ShotWindowSeconds = 10.0f, bool bForceRebuild = false);
+
+	/** Build the whole folder in one blocking call; returns the (master) sequence or null on failure */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Scene", meta = (WorldContext = "WorldContextObject"))
+	static ULevelSequence* BuildSceneNow(UObject* WorldContextObject, const FString& MovieFolder,
+		EAAANKPoseShotPartition Partition = EAAANKPoseShotPartition::None, float ShotWindowSeconds = 10.0f, bool bForceRebuild = false);
+
+	/** Stop at the next unit boundary; OnFinished fires with bSucceeded false */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Scene")
+	void Cancel();
+
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Scene")
+	bool IsRunning() const;
+
+	/** 0..1 across all build steps */
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Scene")
+	float GetProgress() const;
+
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Scene")
+	EAAANKPoseSceneBuildStep GetCurrentStep() const;
+
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Scene")
+	ULevelSequence* GetSequence() const;
+
+	/** True if the build was skipped because the track folder's fingerprint matched the last sequence */
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Scene")
+	bool ReusedSequence() const;
+
+	/** Subsequences of a partitioned build, in shot order; they need saving alongside the master */
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Scene")
+	TArray<ULevelSequence*> GetShotSequences() const;
+
+	/** Empty unless the build failed */
+	UFUNCTION(BlueprintPure, Category = "AAANKPose|Scene")
+	FString GetError() const;
+
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Scene")
+	void SetBudgetMilliseconds(float InBudgetMilliseconds);
+
+	UPROPERTY(BlueprintAssignable, Category = "AAANKPose|Scene")
+	FAAANKPoseSceneBuildFinished OnFinished;
+
+	virtual void BeginDestroy() override;
+
+private:
+	bool TickBuild(float DeltaTime);
+	void Finish();
+
+	TUniquePtr<FAAANKPoseSceneBuild> Build;
+	FTSTicker::FDelegateHandle TickerHandle;
+	float BudgetMilliseconds = 8.0f;
+	/** Frames the build has been spread over, for the completion log */
+	int32 FramesUsed = 0;
+	double StartSeconds = 0.0;
+};
@@ -0,0 +1,105 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "UObject/GCObject.h"
+#include "AAANKPoseSequencePrewarm.generated.h"
+
+class AActor;
+class ULevelSequence;
+class UObject;
+
+
+/** What a pre-warm did and whether everything ended up resident */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPosePrewarmResult
+{
+	GENERATED_BODY()
+
+	/** Sequence and subsequences compiled into evaluation data */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Scene")
+	int32 SequencesCompiled = 0;
+
+	/** Animations and sounds referenced by sections */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Scene")
+	int32 AssetsReferenced = 0;
+
+	/** Bound actors whose meshes and textures were asked to stream in */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Scene")
+	int32 ActorsPrestreamed = 0;
+
+	/** Streaming requests and asset/shader compiles still outstanding when the wait ended */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Scene")
+	int32 Pending = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Scene")
+	float Seconds = 0.0f;
+
+	/** False if the wait timed out with work pending */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Scene")
+	bool bResident = false;
+};
+
+
+/**
+ * Takes the first-play hitch out of a freshly built sequence: compiles its evaluation data up front,
+ * asks every bound actor's meshes and textures, every animation and every sound to stream in, and
+ * waits until they are resident. Begin/Poll suit a time-sliced build; Wait blocks.
+ */
+class AAANKPOSE_API FAAANKPoseSequencePrewarm : public FGCObject
+{
+public:
+	/** Compile Sequence (and its subsequences) and request streaming for everything it and Actors reference */
+	void Begin(ULevelSequence* Sequence, TConstArrayView<AActor*> Actors, float InTimeoutSeconds);
+
+	/** True once nothing is pending or the timeout passed; never blocks */
+	bool Poll();
+
+	/** Block until resident or the timeout passes */
+	void Wait();
+
+	const FAAANKPosePrewarmResult& GetResult() const { return Result; }
+
+	/** Begin then Wait */
+	static FAAANKPosePrewarmResult PrewarmNow(ULevelSequence* Sequence, TConstArrayView<AActor*> Actors, float TimeoutSeconds);
+
+	/** Actors the sequence's root bindings (and those of its shot subsequences) resolve to in World */
+	static TArray<AActor*> FindBoundActors(const ULevelSequence& Sequence, UWorld& World);
+
+	//~ FGCObject
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FAAANKPoseSequencePrewarm"); }
+
+private:
+	int32 CountPending() const;
+	void Complete();
+
+	/** Kept alive and pinned in memory until the wait ends */
+	TArray<TObjectPtr<UObject>> Assets;
+	FAAANKPosePrewarmResult Result;
+	double StartSeconds = 0.0;
+	uint64 BeginFrame = 0;
+	double TimeoutSeconds = 10.0;
+	bool bDone = true;
+};
+
+
+/**
+ * Python usage: unreal.AAANKPosePrewarmLibrary.prewarm_sequence(None, sequence, 10.0)
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPosePrewarmLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Compile Sequence and block until the assets it plays are resident, so the first play or capture runs at full speed.
+	 * @param WorldContextObject - World holding the bound actors; the editor world when null
+	 * @param TimeoutSeconds - Give up waiting after this long; bResident tells whether it did
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Scene", meta = (WorldContext = "WorldContextObject"))
+	static FAAANKPosePrewarmResult PrewarmSequence(UObject* WorldContextObject, ULevelSequence* Sequence, float TimeoutSeconds = 10.0f);
+};
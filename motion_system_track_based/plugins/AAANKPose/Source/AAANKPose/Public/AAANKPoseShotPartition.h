@@ -0,0 +1,81 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AAANKPoseTrackFolder.h"
+#include "UObject/Object.h"
+#include "AAANKPoseShotPartition.generated.h"
+
+struct FAAANKPoseSceneActor;
+
+
+/** How a native scene build splits the movie into shot subsequences */
+UENUM(BlueprintType)
+enum class EAAANKPoseShotPartition : uint8
+{
+	/** Everything keyed into the one sequence, as before */
+	None,
+	/** One shot per entry of camera_cuts.json */
+	CameraCuts,
+	/** Fixed windows of WindowSeconds */
+	TimeWindows,
+};
+
+/** Stored on each shot sequence so the next build can tell the shot is unchanged and skip re-keying it */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseShotMetaData : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	FString ContentHash;
+
+	UPROPERTY()
+	int32 StartFrame = 0;
+
+	UPROPERTY()
+	int32 EndFrame = 0;
+};
+
+/** One actor's tracks cut to a shot, keeping the key on each side so the edges interpolate like the full track */
+struct FAAANKPoseShotActor
+{
+	/** Into the build's scene actors */
+	int32 ActorIndex = INDEX_NONE;
+	TArray<FAAANKPoseTransformKey> TransformKeys;
+	TArray<FAAANKPoseAnimationSection> AnimationSections;
+	TArray<TPair<int32, float>> FocalLengthKeys;
+};
+
+/** A contiguous range of the movie built into its own subsequence */
+struct FAAANKPoseShot
+{
+	/** Display frames, end exclusive */
+	int32 StartFrame = 0;
+	int32 EndFrame = 0;
+	/** (display frame, camera) for the cut active at StartFrame and any cut inside the shot */
+	TArray<TPair<int32, FString>> Cuts;
+	TArray<FAAANKPoseShotActor> Actors;
+	FString ContentHash;
+};
+
+
+/**
+ * Splits a movie into shots and prepares each one independently: slicing tracks (reading only the
+ * windows of chunked tracks a shot touches) and hashing the result run as one parallel job per shot.
+ * Creating and keying the subsequences stays on the game thread in FAAANKPoseSceneBuild.
+ */
+class AAANKPOSE_API FAAANKPoseShotPartition
+{
+public:
+	/** Shots covering [0, EndFrame); camera cut mode falls back to one shot when the movie has no cuts */
+	static void MakeShots(EAAANKPoseShotPartition Mode, const TArray<FAAANKPoseCameraCut>& Cuts, int32 Fps, float WindowSeconds, int32 EndFrame, TArray<FAAANKPoseShot>& OutShots);
+
+	/** Fill every shot's actors and content hash; safe to call with shots from MakeShots only */
+	static void PrepareShots(TConstArrayView<FAAANKPoseSceneActor> SceneActors, int32 Fps, TArray<FAAANKPoseShot>& InOutShots);
+
+	/** Keys in [StartFrame, EndFrame) plus the nearest key on each side; Keys must be sorted */
+	static void SliceKeys(TConstArrayView<FAAANKPoseTransformKey> Keys, int32 StartFrame, int32 EndFrame, TArray<FAAANKPoseTransformKey>& OutKeys);
+};
@@ -0,0 +1,67 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Templates/SubclassOf.h"
+#include "AAANKPoseSpawnLibrary.generated.h"
+
+class AActor;
+class UMaterialInterface;
+
+
+/** Everything needed to spawn and dress one actor */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseSpawnDescriptor
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Spawn")
+	TSubclassOf<AActor> ActorClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Spawn")
+	FTransform Transform;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Spawn")
+	FString Label;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Spawn")
+	TArray<FName> Tags;
+
+	/** Static or skeletal mesh for the actor's first mesh component */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Spawn")
+	TSoftObjectPtr<UObject> Mesh;
+
+	/** Relative rotation of the mesh component, e.g. the -90 yaw of Belica */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Spawn")
+	FRotator MeshRotation = FRotator::ZeroRotator;
+
+	/** Material per slot, starting at slot 0; empty entries keep the mesh default */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Spawn")
+	TArray<TSoftObjectPtr<UMaterialInterface>> Materials;
+};
+
+
+/**
+ * Batch actor spawning for scene builds
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseSpawnLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Spawn all descriptors with deferred construction: every actor is configured first,
+	 * then all of them finish spawning (construction scripts, component registration) in one pass.
+	 * Each distinct mesh and material is loaded once for the whole batch.
+	 * @param WorldContextObject - Any object in the target world; the editor world when null
+	 * @return Spawned actors in descriptor order; null where a descriptor failed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Spawn", meta = (WorldContext = "WorldContextObject"))
+	static TArray<AActor*> SpawnActorsBatch(UObject* WorldContextObject, const TArray<FAAANKPoseSpawnDescriptor>& Descriptors);
+
+	/** World from the context object, falling back to the editor world */
+	static UWorld* ResolveWorld(UObject* WorldContextObject);
+};
@@ -0,0 +1,175 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "AAANKPoseTerrain.generated.h"
+
+class ALandscape;
+class UMaterialInterface;
+
+
+/** A canyon carved along a path through the terrain */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseCanyonPath
+{
+	GENERATED_BODY()
+
+	/** Path in cm from the terrain's corner; Z is ignored */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	TArray<FVector> Points;
+
+	/** Follow a Catmull-Rom spline through Points instead of straight segments */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	bool bSmooth = true;
+
+	/** Rim to rim, cm */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	float Width = 40000.0f;
+
+	/** Cut at the centre, cm */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	float Depth = 30000.0f;
+
+	/** Share of the width that is flat floor */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	float FloorFraction = 0.15f;
+
+	/** 1 is a V; higher values keep the walls steep up to the rim */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	float WallExponent = 3.0f;
+
+	/** Ledges stepped into the walls, 0 for smooth walls */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	int32 Terraces = 0;
+};
+
+/** Everything that shapes a synthesized terrain; the same settings always give the same heights */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseTerrainSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	int32 Seed = 1;
+
+	/** Samples per side, rounded to a landscape size (a multiple of 126 plus one, e.g. 1009 or 2017) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	int32 Resolution = 1009;
+
+	/** Distance between samples, cm; becomes the landscape's X/Y scale */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	float SampleSpacing = 100.0f;
+
+	/** Height of the noise from its lowest to its highest value, cm */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	float Relief = 25000.0f;
+
+	/** Wavelength of the broadest noise octave, cm */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	float FeatureSize = 60000.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	int32 Octaves = 7;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	float Lacunarity = 2.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	float Gain = 0.5f;
+
+	/** Blend from rolling fBm (0) to ridged multifractal mountains (1) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	float Ridged = 0.0f;
+
+	/** Thermal erosion passes; each slumps slopes steeper than Talus */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	int32 ErosionIterations = 16;
+
+	/** Largest height step between neighbouring samples that erosion leaves alone, cm */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	float Talus = 60.0f;
+
+	/** Share of the excess moved per pass, 0-1 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	float ErosionRate = 0.5f;
+
+	/** Carved after erosion, so their walls stay crisp */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Terrain")
+	TArray<FAAANKPoseCanyonPath> Canyons;
+};
+
+/** Synthesized heights, row-major, in cm */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseHeightfield
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Terrain")
+	int32 Size = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Terrain")
+	float SampleSpacing = 100.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Terrain")
+	TArray<float> Heights;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Terrain")
+	float MinHeight = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Terrain")
+	float MaxHeight = 0.0f;
+
+	/** Wall time of the synthesis */
+	UPROPERTY(BlueprintReadOnly, Category = "AAANKPose|Terrain")
+	double Seconds = 0.0;
+};
+
+
+/**
+ * Procedural terrain: fBm/ridged gradient noise, thermal erosion and canyons carved along splines into a
+ * height buffer, then imported as a landscape. Every stage runs rows in parallel and is deterministic
+ * for a given seed regardless of thread count.
+ */
+class AAANKPOSE_API FAAANKPoseTerrainSynthesizer
+{
+public:
+	/** Resolution rounded to the nearest size a landscape of 2x2 63-quad sections can take */
+	static int32 GetLandscapeSize(int32 Resolution);
+
+	static FAAANKPoseHeightfield Generate(const FAAANKPoseTerrainSettings& Settings);
+
+	/**
+	 * Spawn a landscape whose corner is at Location and import the heights, spread over the full 16-bit range.
+	 * Editor only; returns null elsewhere or if the heightfield is not a landscape size.
+	 */
+	static ALandscape* CreateLandscape(UWorld* World, const FAAANKPoseHeightfield& Heightfield, const FVector& Location,
+		UMaterialInterface* Material, const FString& Label);
+};
+
+
+/**
+ * Python usage:
+ *   settings = unreal.AAANKPoseTerrainSettings(seed=7, resolution=2017, ridged=0.6)
+ *   landscape = unreal.AAANKPoseTerrainLibrary.synthesize_landscape(None, settings, unreal.Vector(0, 0, 0), None, "Canyon")
+ */
+UCLASS()
+class AAANKPOSE_API UAAANKPoseTerrainLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Terrain")
+	static FAAANKPoseHeightfield GenerateHeightfield(const FAAANKPoseTerrainSettings& Settings);
+
+	/** @param WorldContextObject - Any object in the target world; the editor world when null */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Terrain", meta = (WorldContext = "WorldContextObject"))
+	static ALandscape* CreateLandscape(UObject* WorldContextObject, const FAAANKPoseHeightfield& Heightfield, FVector Location,
+		UMaterialInterface* Material, const FString& Label);
+
+	/** GenerateHeightfield and CreateLandscape in one call */
+	UFUNCTION(BlueprintCallable, Category = "AAANKPose|Terrain", meta = (WorldContext = "WorldContextObject"))
+	static ALandscape* SynthesizeLandscape(UObject* WorldContextObject, const FAAANKPoseTerrainSettings& Settings, FVector Location,
+		UMaterialInterface* Material, const FString& Label);
+};
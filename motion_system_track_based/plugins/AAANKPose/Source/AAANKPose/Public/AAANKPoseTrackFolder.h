@@ -0,0 +1,219 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AAANKPoseTrackFolder.generated.h"
+
+class FJsonObject;
+
+
+/** One entry of an actor's transform.json */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseTransformKey
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	int32 Frame = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	FRotator Rotation = FRotator::ZeroRotator;
+};
+
+/** One entry of an actor's animation.json */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseAnimationSection
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	int32 StartFrame = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	int32 EndFrame = 0;
+
+	/** Asset name or full /Game/ object path, as written by the planner */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	FString Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	float SpeedMultiplier = 1.0f;
+};
+
+/** One entry of a movie's camera_cuts.json */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseCameraCut
+{
+	GENERATED_BODY()
+
+	/** Cut time in seconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	float Time = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	FString Camera;
+};
+
+/** One fixed time window of a chunked transform track */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseTrackChunk
+{
+	GENERATED_BODY()
+
+	/** File name inside the actor's transform/ folder */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	FString File;
+
+	/** First and last keyed frame in the window */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	int32 StartFrame = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	int32 EndFrame = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	int32 NumKeys = 0;
+};
+
+/** transform/index.json: which window holds which frames, so readers open only the windows they touch */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseTrackChunkIndex
+{
+	GENERATED_BODY()
+
+	/** Frames per window; window N starts at frame N * WindowFrames */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	int32 WindowFrames = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	int32 FirstFrame = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	int32 LastFrame = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	int32 NumKeys = 0;
+
+	/** Sorted by StartFrame; empty windows are not written */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	TArray<FAAANKPoseTrackChunk> Chunks;
+
+	bool IsValid() const { return WindowFrames > 0 && Chunks.Num() > 0; }
+
+	/** Chunk whose frames cover Frame, the last one starting before it otherwise; INDEX_NONE when empty */
+	int32 FindChunk(double Frame) const;
+};
+
+/** Contents of a movie's meta.json */
+USTRUCT(BlueprintType)
+struct AAANKPOSE_API FAAANKPoseMovieMeta
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	FString Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	int32 Fps = 60;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	TArray<FString> Actors;
+
+	/** Build in the movie's own level cloned from the template (FAAANKPoseLevelTemplate) instead of the open one */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AAANKPose|Tracks")
+	bool bCreateNewLevel = false;
+};
+
+
+/**
+ * Reader/writer for the dist/<movie> track folders produced by MovieBuilder.save_to_tracks.
+ * Mirrors the JSON layout consumed by run_scene.py and motion_planner.plan_motion.
+ */
+class AAANKPOSE_API FAAANKPoseTrackFolder
+{
+public:
+	static bool LoadMeta(const FString& MovieFolder, FAAANKPoseMovieMeta& OutMeta);
+
+	/** Returns the keys sorted by frame; empty if the actor has no transform track. Reads every window of a chunked track. */
+	static bool LoadTransformKeys(const FString& ActorFolder, TArray<FAAANKPoseTransformKey>& OutKeys);
+
+	/** Writes transform.json, or re-chunks with the same window size if the actor is already chunked */
+	static bool SaveTransformKeys(const FString& ActorFolder, const TArray<FAAANKPoseTransformKey>& Keys);
+
+	/** Split sorted keys into transform/<window>.json files plus transform/index.json, replacing any transform.json */
+	static bool SaveTransformChunks(const FString& ActorFolder, const TArray<FAAANKPoseTransformKey>& Keys, int32 WindowFrames);
+
+	/** False if the actor stores its transform as a single transform.json */
+	static bool LoadTransformIndex(const FString& ActorFolder, FAAANKPoseTrackChunkIndex& OutIndex);
+
+	/** Keys of the windows overlapping [StartFrame, EndFrame] only, sorted by frame */
+	static bool LoadTransformWindow(const FString& ActorFolder, const FAAANKPoseTrackChunkIndex& Index, int32 StartFrame, int32 EndFrame, TArray<FAAANKPoseTransformKey>& OutKeys);
+
+	/** Accepts both "speed" and "speed_multiplier", like plan_motion does */
+	static bool LoadAnimationSections(const FString& ActorFolder, TArray<FAAANKPoseAnimationSection>& OutSections);
+
+	/** focal_length.json as (display frame, millimetres); empty if the actor has none */
+	static bool LoadFocalLengthKeys(const FString& ActorFolder, TArray<TPair<int32, float>>& OutKeys);
+
+	/** Sorted by time; empty if the movie has no cuts */
+	static bool LoadCameraCuts(const FString& MovieFolder, TArray<FAAANKPoseCameraCut>& OutCuts);
+
+	/** settings.json as a raw object; null if the actor has none */
+	static TSharedPtr<FJsonObject> LoadSettings(const FString& ActorFolder);
+
+	/** Same resolution rule as keyframe_applier: bare names are Belica animations */
+	static FString ResolveAnimationPath(const FString& AnimName);
+
+	/** Linear interpolation between sorted keys, clamped at both ends */
+	static FAAANKPoseTransformKey SampleTransform(const TArray<FAAANKPoseTransformKey>& Keys, double Frame);
+};
+
+
+/**
+ * Samples an actor's transform track a window at a time. Chunked tracks keep at most the window being
+ * sampled and its neighbour resident, so walking a long take costs the same memory as a short one;
+ * single-file tracks are loaded whole on first use.
+ */
+class AAANKPOSE_API FAAANKPoseTransformReader
+{
+public:
+	explicit FAAANKPoseTransformReader(const FString& InActorFolder);
+
+	bool IsValid() const { return bChunked ? Index.IsValid() : AllKeys.Num() > 0; }
+	bool IsChunked() const { return bChunked; }
+	const FAAANKPoseTrackChunkIndex& GetIndex() const { return Index; }
+
+	/** First and last keyed frame, from the index when chunked */
+	int32 GetFirstFrame() const;
+	int32 GetLastFrame() const;
+
+	/** Same result as FAAANKPoseTrackFolder::SampleTransform over the whole track */
+	FAAANKPoseTransformKey Sample(double Frame);
+
+	/**
+	 * Next window of keys in frame order, for writers that consume the track sequentially
+	 * @return false once every window has been returned
+	 */
+	bool NextWindow(TArray<FAAANKPoseTransformKey>& OutKeys);
+
+	/** Window files read so far, for checking that callers stay local */
+	int32 GetWindowsLoaded() const { return WindowsLoaded; }
+
+private:
+	const TArray<FAAANKPoseTransformKey>& GetChunk(int32 ChunkIndex);
+
+	FString ActorFolder;
+	FAAANKPoseTrackChunkIndex Index;
+	bool bChunked = false;
+
+	/** Whole track when not chunked */
+	TArray<FAAANKPoseTransformKey> AllKeys;
+	/** Chunk index -> keys; at most the sampled window and its successor */
+	TMap<int32, TArray<FAAANKPoseTransformKey>> ResidentChunks;
+	int32 NextWindowIndex = 0;
+	int32 WindowsLoaded = 0;
+};
@@ -0,0 +1,30 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+/**
+ * Console program that times the AAANKPoseMath kernels without the editor, the engine or UObjects:
+ *   Engine/Build/BatchFiles/Linux/Build.sh AAANKPoseBench Linux Development -Project=<Project>.uproject
+ */
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class AAANKPoseBenchTarget : TargetRules
+{
+	public AAANKPoseBenchTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Program;
+		LinkType = TargetLinkType.Monolithic;
+		LaunchModuleName = "AAANKPoseBench";
+		DefaultBuildSettings = BuildSettingsVersion.Latest;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Latest;
+
+		bBuildDeveloperTools = false;
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = false;
+		bCompileAgainstApplicationCore = false;
+		bCompileICU = false;
+		bUseLoggingInShipping = true;
+		bIsBuildingConsoleApplication = true;
+
+		EnablePlugins.Add("AAANKPose");
+	}
+}
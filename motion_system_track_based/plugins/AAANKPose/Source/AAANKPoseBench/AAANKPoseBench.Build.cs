@@ -0,0 +1,21 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class AAANKPoseBench : ModuleRules
+{
+	public AAANKPoseBench(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PublicIncludePathModuleNames.Add("Launch");
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"AAANKPoseMath",
+				"Core",
+				"Json",
+				"Projects",
+			}
+			);
+	}
+}
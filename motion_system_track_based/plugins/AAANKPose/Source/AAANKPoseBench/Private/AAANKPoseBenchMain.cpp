@@ -0,0 +1,418 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "RequiredProgramMainCPPInclude.h"
+#include "AAANKPoseMath.h"
+#include "Dom/JsonObject.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeExit.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include <atomic>
+#include <cstdio>
+
+
+IMPLEMENT_APPLICATION(AAANKPoseBench, "AAANKPoseBench");
+
+/**
+ * Times each AAANKPoseMath kernel across data sizes and prints one JSON line per kernel and size:
+ *   {"kernel":"track_sample","n":10000,"iterations":812,"ns_per_op":6.1,"ops_per_sec":1.6e8,"allocs_per_call":0}
+ *
+ *   AAANKPoseBench [-Kernels=a,b] [-Sizes=100,1000] [-MinTime=0.05] [-Output=<file.jsonl>]
+ *       [-Baseline=<baseline.json>] [-Margin=0.2] [-RecordBaseline]
+ *
+ * An op is one item of the kernel's input (a key lookup, a camera frame, a database row). Returns non-zero
+ * when any kernel is slower than the baseline by more than Margin, or allocates more per call than it did.
+ */
+namespace AAANKPoseBench
+{
+	/** Forwards to the real allocator and counts allocations, so steady-state kernels can be held at zero */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+		uint64 GetAllocations() const { return Allocations.load(std::memory_order_relaxed); }
+
+		virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+		{
+			Allocations.fetch_add(1, std::memory_order_relaxed);
+			return Inner->Malloc(Count, Alignment);
+		}
+		virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+		{
+			if (Count > 0)
+			{
+				Allocations.fetch_add(1, std::memory_order_relaxed);
+			}
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual const TCHAR* GetDescriptiveName() override { return TEXT("AAANKPoseBenchCounting"); }
+
+	private:
+		FMalloc* Inner;
+		std::atomic<uint64> Allocations{0};
+	};
+
+	static FCountingMalloc* CountingMalloc = nullptr;
+
+	/** Kernel results are folded in here so the optimizer can't drop the work */
+	static volatile double Sink = 0.0;
+
+	static const int32 FeatureDimension = 10;
+
+	struct FResult
+	{
+		FString Kernel;
+		int32 Num = 0;
+		int64 Iterations = 0;
+		double NsPerOp = 0.0;
+		double OpsPerSecond = 0.0;
+		double AllocsPerCall = 0.0;
+		FString Regression;
+
+		FString ToJsonLine() const
+		{
+			return FString::Printf(TEXT("{\"kernel\":\"%s\",\"n\":%d,\"iterations\":%lld,\"ns_per_op\":%.4f,\"ops_per_sec\":%.1f,\"allocs_per_call\":%.2f%s}"),
+				*Kernel, Num, Iterations, NsPerOp, OpsPerSecond, AllocsPerCall,
+				Regression.IsEmpty() ? TEXT("") : *FString::Printf(TEXT(",\"regression\":\"%s\""), *Regression));
+		}
+	};
+
+	/** Runs Body once to warm caches and grow output buffers, then repeatedly until MinSeconds have passed */
+	template <typename BodyType>
+	static FResult Measure(const FString& Kernel, int32 Num, double MinSeconds, BodyType&& Body)
+	{
+		Sink = Sink + Body();
+
+		int64 Iterations = 0;
+		const uint64 AllocationsBefore = CountingMalloc->GetAllocations();
+		const double StartSeconds = FPlatformTime::Seconds();
+		double Elapsed = 0.0;
+		do
+		{
+			Sink = Sink + Body();
+			++Iterations;
+			Elapsed = FPlatformTime::Seconds() - StartSeconds;
+		}
+		while (Elapsed < MinSeconds || Iterations < 3);
+		const uint64 Allocations = CountingMalloc->GetAllocations() - AllocationsBefore;
+
+		FResult Result;
+		Result.Kernel = Kernel;
+		Result.Num = Num;
+		Result.Iterations = Iterations;
+		const double Ops = static_cast<double>(Iterations) * Num;
+		Result.NsPerOp = Elapsed * 1.0e9 / Ops;
+		Result.OpsPerSecond = Ops / Elapsed;
+		Result.AllocsPerCall = static_cast<double>(Allocations) / Iterations;
+		return Result;
+	}
+
+	/** Planner-like path: a random walk at roughly sprint speed, with unwound yaw */
+	static void MakePath(FRandomStream& Random, int32 Num, double StepCm, TArray<FVector>& OutPoints)
+	{
+		OutPoints.SetNumUninitialized(Num);
+		FVector Location = FVector::ZeroVector;
+		double Heading = 0.0;
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			Heading += Random.FRandRange(-0.2f, 0.2f);
+			Location += FVector(FMath::Cos(Heading), FMath::Sin(Heading), 0.0) * StepCm;
+			Location.Z = 10.0 * FMath::Sin(Index * 0.05);
+			OutPoints[Index] = Location;
+		}
+	}
+
+	struct FBenchKey
+	{
+		double Frame = 0.0;
+		FVector Location = FVector::ZeroVector;
+		FRotator Rotation = FRotator::ZeroRotator;
+	};
+
+	static FResult RunKernel(const FString& Kernel, int32 Num, double MinSeconds)
+	{
+		using namespace AAANKPoseMath;
+
+		FRandomStream Random(Num);
+
+		if (Kernel == TEXT("spline_eval"))
+		{
+			TArray<FVector> Points;
+			MakePath(Random, 4, 100.0, Points);
+			return Measure(Kernel, Num, MinSeconds, [&]()
+			{
+				double Sum = 0.0;
+				for (int32 Index = 0; Index < Num; ++Index)
+				{
+					Sum += CatmullRom(Points[0], Points[1], Points[2], Points[3], Index / static_cast<double>(Num)).X;
+				}
+				return Sum;
+			});
+		}
+		if (Kernel == TEXT("spline_sample"))
+		{
+			// One op per control point; 1 m apart at a 10 cm interval gives ~10 samples each
+			TArray<FVector> Points;
+			MakePath(Random, Num, 100.0, Points);
+			TArray<FSplineSample> Samples;
+			return Measure(Kernel, Num, MinSeconds, [&]()
+			{
+				SampleSplinePath(Points, 10.0, /*bClosed*/ false, Samples);
+				return Samples.Num() > 0 ? Samples.Last().Distance : 0.0;
+			});
+		}
+		if (Kernel == TEXT("track_sample"))
+		{
+			TArray<FVector> Points;
+			MakePath(Random, Num, 20.0, Points);
+			TArray<FBenchKey> Keys;
+			Keys.SetNum(Num);
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				Keys[Index].Frame = Index;
+				Keys[Index].Location = Points[Index];
+				Keys[Index].Rotation = FRotator(0.0, Index * 2.0, 0.0);
+			}
+			TArray<double> Frames;
+			Frames.SetNumUninitialized(Num);
+			for (double& Frame : Frames)
+			{
+				Frame = Random.FRandRange(-1.0f, Num);
+			}
+			return Measure(Kernel, Num, MinSeconds, [&]()
+			{
+				double Sum = 0.0;
+				for (const double Frame : Frames)
+				{
+					double Alpha = 0.0;
+					const int32 Index = FindKeySegment(MakeArrayView(Keys), Frame, [](const FBenchKey& Key) { return Key.Frame; }, Alpha);
+					const FBenchKey& A = Keys[Index];
+					const FBenchKey& B = Keys[FMath::Min(Index + 1, Keys.Num() - 1)];
+					Sum += FMath::Lerp(A.Location, B.Location, Alpha).X + LerpRotatorComponents(A.Rotation, B.Rotation, Alpha).Yaw;
+				}
+				return Sum;
+			});
+		}
+		if (Kernel == TEXT("camera_solve"))
+		{
+			TArray<FVector> Subjects;
+			MakePath(Random, Num, 20.0, Subjects);
+			TArray<FVector> Cameras;
+			Cameras.SetNumUninitialized(Num);
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				Cameras[Index] = Subjects[Index] + FVector(-400.0, 250.0, 160.0);
+			}
+			TArray<FRotator> Rotations;
+			Rotations.SetNumUninitialized(Num);
+			TArray<float> FocalLengths;
+			FocalLengths.SetNumUninitialized(Num);
+			return Measure(Kernel, Num, MinSeconds, [&]()
+			{
+				SolveCameraTrack(Cameras, Subjects, 180.0, 0.7, Rotations, FocalLengths);
+				return static_cast<double>(FocalLengths.Last()) + Rotations.Last().Yaw;
+			});
+		}
+		if (Kernel == TEXT("curve_reduce"))
+		{
+			TArray<FVector> Points;
+			MakePath(Random, Num, 20.0, Points);
+			TArray<int32> Kept;
+			return Measure(Kernel, Num, MinSeconds, [&]()
+			{
+				ReduceCurve(Points, 1.0, Kept);
+				return static_cast<double>(Kept.Num());
+			});
+		}
+		if (Kernel == TEXT("distance_scan") || Kernel == TEXT("nearest_row"))
+		{
+			TArray<float> Rows;
+			Rows.SetNumUninitialized(Num * FeatureDimension);
+			for (float& Value : Rows)
+			{
+				Value = Random.FRandRange(-200.0f, 200.0f);
+			}
+			TArray<float> Query;
+			Query.SetNumUninitialized(FeatureDimension);
+			for (float& Value : Query)
+			{
+				Value = Random.FRandRange(-200.0f, 200.0f);
+			}
+			TArray<float> Distances;
+			Distances.SetNumUninitialized(Num);
+
+			if (Kernel == TEXT("distance_scan"))
+			{
+				return Measure(Kernel, Num, MinSeconds, [&]()
+				{
+					SquaredDistances(Query, Rows, Distances);
+					return static_cast<double>(Distances[Num / 2]);
+				});
+			}
+			return Measure(Kernel, Num, MinSeconds, [&]()
+			{
+				float Best = 0.0f;
+				return FindNearestRow(Query, Rows, Best) + static_cast<double>(Best);
+			});
+		}
+
+		if (Kernel == TEXT("noise_row"))
+		{
+			FFractalNoise Noise;
+			Noise.Seed = 7;
+			Noise.Frequency = 1.0f / 600.0f;
+			Noise.bRidged = true;
+			TArray<float> Row;
+			Row.SetNumUninitialized(Num);
+			TArray<float> Scratch;
+			Scratch.Reserve(Num);
+			return Measure(Kernel, Num, MinSeconds, [&]()
+			{
+				FractalNoiseRow(Noise, 0.0f, 1.0f, 42.0f, Row, Scratch);
+				return static_cast<double>(Row[Num / 2]);
+			});
+		}
+
+		FResult Unknown;
+		Unknown.Kernel = Kernel;
+		Unknown.Num = Num;
+		Unknown.Regression = TEXT("unknown kernel");
+		return Unknown;
+	}
+
+	/** Baseline file: {"<kernel>:<n>": {"ns_per_op": x, "allocs_per_call": y}} */
+	static void ApplyBaseline(FResult& Result, const TSharedPtr<FJsonObject>& Baseline, double Margin)
+	{
+		const TSharedPtr<FJsonObject>* Entry = nullptr;
+		if (!Baseline.IsValid() || !Baseline->TryGetObjectField(FString::Printf(TEXT("%s:%d"), *Result.Kernel, Result.Num), Entry))
+		{
+			return;
+		}
+
+		TArray<FString> Reasons;
+		double BaselineNs = 0.0;
+		if ((*Entry)->TryGetNumberField(TEXT("ns_per_op"), BaselineNs) && BaselineNs > 0.0 && Result.NsPerOp > BaselineNs * (1.0 + Margin))
+		{
+			Reasons.Add(FString::Printf(TEXT("%.2f ns/op over baseline %.2f"), Result.NsPerOp, BaselineNs));
+		}
+		double BaselineAllocs = 0.0;
+		if ((*Entry)->TryGetNumberField(TEXT("allocs_per_call"), BaselineAllocs) && Result.AllocsPerCall > BaselineAllocs + 0.5)
+		{
+			Reasons.Add(FString::Printf(TEXT("%.1f allocs/call over baseline %.1f"), Result.AllocsPerCall, BaselineAllocs));
+		}
+		Result.Regression = FString::Join(Reasons, TEXT("; "));
+	}
+
+	static TArray<FString> ParseList(const TCHAR* CommandLine, const TCHAR* Name, const TCHAR* Default)
+	{
+		FString Value = Default;
+		FParse::Value(CommandLine, Name, Value);
+		TArray<FString> Items;
+		Value.ParseIntoArray(Items, TEXT(","));
+		return Items;
+	}
+}
+
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+	using namespace AAANKPoseBench;
+
+	FTaskTagScope Scope(ETaskTag::EGameThread);
+	ON_SCOPE_EXIT
+	{
+		RequestEngineExit(TEXT("AAANKPoseBench exiting"));
+		FEngineLoop::AppPreExit();
+		FModuleManager::Get().UnloadModulesAtShutdown();
+		FEngineLoop::AppExit();
+	};
+
+	if (int32 Ret = GEngineLoop.PreInit(ArgC, ArgV))
+	{
+		return Ret;
+	}
+
+	CountingMalloc = new FCountingMalloc(GMalloc);
+	GMalloc = CountingMalloc;
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	const TArray<FString> Kernels = ParseList(CommandLine, TEXT("-Kernels="), TEXT("spline_eval,spline_sample,track_sample,camera_solve,curve_reduce,distance_scan,nearest_row,noise_row"));
+	const TArray<FString> Sizes = ParseList(CommandLine, TEXT("-Sizes="), TEXT("100,1000,10000,100000"));
+	double MinSeconds = 0.05;
+	FParse::Value(CommandLine, TEXT("-MinTime="), MinSeconds);
+	double Margin = 0.2;
+	FParse::Value(CommandLine, TEXT("-Margin="), Margin);
+	FString OutputPath;
+	FParse::Value(CommandLine, TEXT("-Output="), OutputPath);
+	FString BaselinePath;
+	FParse::Value(CommandLine, TEXT("-Baseline="), BaselinePath);
+	const bool bRecordBaseline = FParse::Param(CommandLine, TEXT("RecordBaseline"));
+
+	TSharedPtr<FJsonObject> Baseline;
+	FString BaselineText;
+	if (!bRecordBaseline && !BaselinePath.IsEmpty() && FFileHelper::LoadFileToString(BaselineText, *BaselinePath))
+	{
+		FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineText), Baseline);
+	}
+
+	TArray<FResult> Results;
+	TArray<FString> Lines;
+	int32 Regressions = 0;
+	for (const FString& Kernel : Kernels)
+	{
+		for (const FString& Size : Sizes)
+		{
+			FResult& Result = Results.Add_GetRef(RunKernel(Kernel, FMath::Max(FCString::Atoi(*Size), 1), MinSeconds));
+			if (Result.Regression.IsEmpty())
+			{
+				ApplyBaseline(Result, Baseline, Margin);
+			}
+			Regressions += Result.Regression.IsEmpty() ? 0 : 1;
+
+			Lines.Add(Result.ToJsonLine());
+			printf("%s\n", TCHAR_TO_UTF8(*Lines.Last()));
+			fflush(stdout);
+		}
+	}
+
+	if (!OutputPath.IsEmpty())
+	{
+		FFileHelper::SaveStringToFile(FString::Join(Lines, TEXT("\n")) + TEXT("\n"), *OutputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	}
+
+	if (bRecordBaseline && !BaselinePath.IsEmpty())
+	{
+		TSharedRef<FJsonObject> NewBaseline = MakeShared<FJsonObject>();
+		for (const FResult& Result : Results)
+		{
+			TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+			Entry->SetNumberField(TEXT("ns_per_op"), Result.NsPerOp);
+			Entry->SetNumberField(TEXT("allocs_per_call"), Result.AllocsPerCall);
+			NewBaseline->SetObjectField(FString::Printf(TEXT("%s:%d"), *Result.Kernel, Result.Num), Entry);
+		}
+		FString Text;
+		FJsonSerializer::Serialize(NewBaseline, TJsonWriterFactory<>::Create(&Text));
+		FFileHelper::SaveStringToFile(Text, *BaselinePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+		UE_LOG(LogTemp, Display, TEXT("AAANKPoseBench: Baseline recorded to %s"), *BaselinePath);
+	}
+
+	if (Regressions > 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("AAANKPoseBench: %d kernel(s) regressed past the %.0f%% margin"), Regressions, Margin * 100.0);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,534 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "AAANKPoseMath.h"
+#include "Modules/ModuleManager.h"
+
+
+namespace AAANKPoseMath
+{
+	/** Padded control point for segment walking: closed → [last, pts..., p0, p1], open → [p0, pts..., last] */
+	static const FVector& PaddedPoint(TConstArrayView<FVector> Points, bool bClosed, int32 PaddedIndex)
+	{
+		const int32 Num = Points.Num();
+		if (bClosed)
+		{
+			return Points[(PaddedIndex - 1 + Num) % Num];
+		}
+		return Points[FMath::Clamp(PaddedIndex - 1, 0, Num - 1)];
+	}
+
+	/** Integer hash of a noise lattice corner */
+	static FORCEINLINE uint32 HashLattice(int32 X, int32 Y, uint32 Seed)
+	{
+		uint32 Hash = Seed ^ (static_cast<uint32>(X) * 0x8da6b343u) ^ (static_cast<uint32>(Y) * 0xd8163841u);
+		Hash ^= Hash >> 16;
+		Hash *= 0x7feb352du;
+		Hash ^= Hash >> 15;
+		Hash *= 0x846ca68bu;
+		Hash ^= Hash >> 16;
+		return Hash;
+	}
+
+	/** Dot of the corner's pseudo-random gradient (components in [-1, 1]) with the offset to the sample */
+	static FORCEINLINE float CornerDot(uint32 Hash, float Dx, float Dy)
+	{
+		const float Gx = static_cast<float>(static_cast<int32>(Hash & 0xffffu) - 32768) * (1.0f / 32768.0f);
+		const float Gy = static_cast<float>(static_cast<int32>(Hash >> 16) - 32768) * (1.0f / 32768.0f);
+		return Gx * Dx + Gy * Dy;
+	}
+
+	/** 2D gradient noise with a quintic fade, mostly within +-0.5; no branches, no tables */
+	static FORCEINLINE float GradientNoise(float X, float Y, uint32 Seed)
+	{
+		const float FloorX = FMath::FloorToFloat(X);
+		const float FloorY = FMath::FloorToFloat(Y);
+		const int32 IX = static_cast<int32>(FloorX);
+		const int32 IY = static_cast<int32>(FloorY);
+		const float Fx = X - FloorX;
+		const float Fy = Y - FloorY;
+		const float U = Fx * Fx * Fx * (Fx * (Fx * 6.0f - 15.0f) + 10.0f);
+		const float V = Fy * Fy * Fy * (Fy * (Fy * 6.0f - 15.0f) + 10.0f);
+
+		const float N00 = CornerDot(HashLattice(IX, IY, Seed), Fx, Fy);
+		const float N10 = CornerDot(HashLattice(IX + 1, IY, Seed), Fx - 1.0f, Fy);
+		const float N01 = CornerDot(HashLattice(IX, IY + 1, Seed), Fx, Fy - 1.0f);
+		const float N11 = CornerDot(HashLattice(IX + 1, IY + 1, Seed), Fx - 1.0f, Fy - 1.0f);
+		const float Bottom = N00 + (N10 - N00) * U;
+		const float Top = N01 + (N11 - N01) * U;
+		return Bottom + (Top - Bottom) * V;
+	}
+}
+
+FVector AAANKPoseMath::CatmullRom(const FVector& P0, const FVector& P1, const FVector& P2, const FVector& P3, double T)
+{
+	const FVector C0 = 2.0 * P1;
+	const FVector C1 = P2 - P0;
+	const FVector C2 = 2.0 * P0 - 5.0 * P1 + 4.0 * P2 - P3;
+	const FVector C3 = -P0 + 3.0 * P1 - 3.0 * P2 + P3;
+	return 0.5 * (C0 + T * (C1 + T * (C2 + T * C3)));
+}
+
+FVector AAANKPoseMath::CatmullRomDerivative(const FVector& P0, const FVector& P1, const FVector& P2, const FVector& P3, double T)
+{
+	const FVector C1 = P2 - P0;
+	const FVector C2 = 2.0 * P0 - 5.0 * P1 + 4.0 * P2 - P3;
+	const FVector C3 = -P0 + 3.0 * P1 - 3.0 * P2 + P3;
+	return 0.5 * (C1 + 2.0 * C2 * T + 3.0 * C3 * T * T);
+}
+
+void AAANKPoseMath::SampleSplinePath(TConstArrayView<FVector> Points, double SampleInterval, bool bClosed, TArray<FSplineSample>& OutSamples)
+{
+	OutSamples.Reset();
+	if (Points.Num() < 2)
+	{
+		if (Points.Num() == 1)
+		{
+			OutSamples.AddDefaulted_GetRef().Position = Points[0];
+		}
+		return;
+	}
+
+	SampleInterval = FMath::Max(SampleInterval, UE_KINDA_SMALL_NUMBER);
+	const int32 NumSegments = bClosed ? Points.Num() : Points.Num() - 1;
+	double CurrentDistance = 0.0;
+	double TargetDistance = 0.0;
+
+	for (int32 Segment = 0; Segment < NumSegments; ++Segment)
+	{
+		const FVector& P0 = PaddedPoint(Points, bClosed, Segment);
+		const FVector& P1 = PaddedPoint(Points, bClosed, Segment + 1);
+		const FVector& P2 = PaddedPoint(Points, bClosed, Segment + 2);
+		const FVector& P3 = PaddedPoint(Points, bClosed, Segment + 3);
+
+		// Step finely (5 cm) and accumulate distance, emitting whenever the next target is crossed
+		const int32 Substeps = FMath::Max(10, static_cast<int32>(FVector::Dist(P1, P2) / 5.0));
+		FVector Previous = P1;
+		for (int32 Step = 1; Step <= Substeps; ++Step)
+		{
+			const double T = Step / static_cast<double>(Substeps);
+			const FVector Current = CatmullRom(P0, P1, P2, P3, T);
+			CurrentDistance += FVector::Dist(Previous, Current);
+
+			if (CurrentDistance >= TargetDistance)
+			{
+				const FVector Tangent = CatmullRomDerivative(P0, P1, P2, P3, T).GetSafeNormal(0.0, FVector::ForwardVector);
+				const double Slope = FMath::RadiansToDegrees(FMath::Atan2(Tangent.Z, FMath::Sqrt(Tangent.X * Tangent.X + Tangent.Y * Tangent.Y)));
+				while (CurrentDistance >= TargetDistance)
+				{
+					FSplineSample& Sample = OutSamples.AddDefaulted_GetRef();
+					Sample.Position = Current;
+					Sample.Tangent = Tangent;
+					Sample.Distance = TargetDistance;
+					Sample.Slope = Slope;
+					TargetDistance += SampleInterval;
+				}
+			}
+			Previous = Current;
+		}
+	}
+}
+
+double AAANKPoseMath::CalculateFocalLength(const FVector& CameraLocation, const FVector& SubjectLocation, double SubjectHeight, double Coverage, double SensorHeight)
+{
+	// Metres, clamped so a camera inside the subject doesn't divide by zero
+	const double Distance = FMath::Max(FVector::Dist(CameraLocation, SubjectLocation) / 100.0, 0.1);
+	const double SubjectHeightMeters = SubjectHeight / 100.0;
+	const double FrameHeight = Coverage > 0.0 ? SubjectHeightMeters / Coverage : SubjectHeightMeters;
+	const double FieldOfView = 2.0 * FMath::Atan(FrameHeight / (2.0 * Distance));
+	return SensorHeight / (2.0 * FMath::Tan(FieldOfView / 2.0));
+}
+
+FRotator AAANKPoseMath::CalculateLookAtRotation(const FVector& CameraLocation, const FVector& TargetLocation)
+{
+	const FVector Delta = TargetLocation - CameraLocation;
+	const double Yaw = FMath::RadiansToDegrees(FMath::Atan2(Delta.Y, Delta.X));
+	const double Pitch = -FMath::RadiansToDegrees(FMath::Atan2(Delta.Z, Delta.Size2D()));
+	return FRotator(Pitch, Yaw, 0.0);
+}
+
+void AAANKPoseMath::SolveCameraTrack(TConstArrayView<FVector> CameraLocations, TConstArrayView<FVector> SubjectLocations,
+	double SubjectHeight, double Coverage, TArrayView<FRotator> OutRotations, TArrayView<float> OutFocalLengths)
+{
+	check(CameraLocations.Num() == SubjectLocations.Num());
+	check(OutRotations.Num() == CameraLocations.Num() && OutFocalLengths.Num() == CameraLocations.Num());
+
+	for (int32 Index = 0; Index < CameraLocations.Num(); ++Index)
+	{
+		OutRotations[Index] = CalculateLookAtRotation(CameraLocations[Index], SubjectLocations[Index]);
+		OutFocalLengths[Index] = static_cast<float>(CalculateFocalLength(CameraLocations[Index], SubjectLocations[Index], SubjectHeight, Coverage));
+	}
+}
+
+void AAANKPoseMath::ReduceCurve(TConstArrayView<FVector> Points, double Tolerance, TArray<int32>& OutKeptIndices)
+{
+	OutKeptIndices.Reset();
+	if (Points.Num() <= 2)
+	{
+		for (int32 Index = 0; Index < Points.Num(); ++Index)
+		{
+			OutKeptIndices.Add(Index);
+		}
+		return;
+	}
+
+	// Iterative rather than recursive so long takes can't blow the stack; ranges are [First, Last]
+	const double ToleranceSquared = Tolerance * Tolerance;
+	TArray<TPair<int32, int32>, TInlineAllocator<64>> Ranges;
+	Ranges.Emplace(0, Points.Num() - 1);
+	OutKeptIndices.Add(0);
+	OutKeptIndices.Add(Points.Num() - 1);
+
+	while (Ranges.Num() > 0)
+	{
+		const TPair<int32, int32> Range = Ranges.Pop(EAllowShrinking::No);
+		const FVector& Start = Points[Range.Key];
+		const FVector& End = Points[Range.Value];
+
+		int32 Furthest = INDEX_NONE;
+		double FurthestSquared = ToleranceSquared;
+		for (int32 Index = Range.Key + 1; Index < Range.Value; ++Index)
+		{
+			const double DistanceSquared = FMath::PointDistToSegmentSquared(Points[Index], Start, End);
+			if (DistanceSquared > FurthestSquared)
+			{
+				Furthest = Index;
+				FurthestSquared = DistanceSquared;
+			}
+		}
+
+		if (Furthest != INDEX_NONE)
+		{
+			OutKeptIndices.Add(Furthest);
+			Ranges.Emplace(Range.Key, Furthest);
+			Ranges.Emplace(Furthest, Range.Value);
+		}
+	}
+
+	OutKeptIndices.Sort();
+}
+
+void AAANKPoseMath::SquaredDistances(TConstArrayView<float> Query, TConstArrayView<float> Rows, TArrayView<float> OutDistances)
+{
+	const int32 Dimension = Query.Num();
+	check(Dimension > 0 && Rows.Num() % Dimension == 0 && OutDistances.Num() == Rows.Num() / Dimension);
+
+	const float* RESTRICT QueryData = Query.GetData();
+	const float* RESTRICT Row = Rows.GetData();
+	for (int32 RowIndex = 0; RowIndex < OutDistances.Num(); ++RowIndex, Row += Dimension)
+	{
+		// Contiguous floats, left to the compiler to vectorize
+		float Sum = 0.0f;
+		for (int32 Column = 0; Column < Dimension; ++Column)
+		{
+			const float Delta = Row[Column] - QueryData[Column];
+			Sum += Delta * Delta;
+		}
+		OutDistances[RowIndex] = Sum;
+	}
+}
+
+int32 AAANKPoseMath::FindNearestRow(TConstArrayView<float> Query, TConstArrayView<float> Rows, float& OutSquaredDistance)
+{
+	const int32 Dimension = Query.Num();
+	check(Dimension > 0 && Rows.Num() % Dimension == 0);
+
+	int32 Best = INDEX_NONE;
+	OutSquaredDistance = TNumericLimits<float>::Max();
+	const float* RESTRICT QueryData = Query.GetData();
+	const float* RESTRICT Row = Rows.GetData();
+	const int32 NumRows = Rows.Num() / Dimension;
+	for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex, Row += Dimension)
+	{
+		float Sum = 0.0f;
+		for (int32 Column = 0; Column < Dimension && Sum < OutSquaredDistance; ++Column)
+		{
+			const float Delta = Row[Column] - QueryData[Column];
+			Sum += Delta * Delta;
+		}
+		if (Sum < OutSquaredDistance)
+		{
+			Best = RowIndex;
+			OutSquaredDistance = Sum;
+		}
+	}
+	return Best;
+}
+
+bool AAANKPoseMath::FTimeWarp::IsValid() const
+{
+	if (Points.Num() == 0)
+	{
+		return Speed > 0.0;
+	}
+	if (Points.Num() < 2)
+	{
+		return false;
+	}
+	for (int32 Index = 1; Index < Points.Num(); ++Index)
+	{
+		if (Points[Index].X <= Points[Index - 1].X || Points[Index].Y <= Points[Index - 1].Y)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+double AAANKPoseMath::FTimeWarp::ToSource(double OutputSeconds) const
+{
+	if (Points.Num() < 2)
+	{
+		return OutputSeconds * Speed;
+	}
+
+	// Segment containing the time, or the end segment it extends
+	const int32 Upper = FMath::Clamp(Algo::UpperBoundBy(Points, OutputSeconds, &FVector2D::X), 1, Points.Num() - 1);
+	const FVector2D& A = Points[Upper - 1];
+	const FVector2D& B = Points[Upper];
+	return A.Y + (OutputSeconds - A.X) * (B.Y - A.Y) / (B.X - A.X);
+}
+
+double AAANKPoseMath::FTimeWarp::ToOutput(double SourceSeconds) const
+{
+	if (Points.Num() < 2)
+	{
+		return SourceSeconds / Speed;
+	}
+
+	const int32 Upper = FMath::Clamp(Algo::UpperBoundBy(Points, SourceSeconds, &FVector2D::Y), 1, Points.Num() - 1);
+	const FVector2D& A = Points[Upper - 1];
+	const FVector2D& B = Points[Upper];
+	return A.X + (SourceSeconds - A.Y) * (B.X - A.X) / (B.Y - A.Y);
+}
+
+void AAANKPoseMath::FTimeWarp::ToSource(TConstArrayView<double> OutputSeconds, TArrayView<double> OutSourceSeconds) const
+{
+	check(OutputSeconds.Num() == OutSourceSeconds.Num());
+
+	if (Points.Num() < 2)
+	{
+		for (int32 Index = 0; Index < OutputSeconds.Num(); ++Index)
+		{
+			OutSourceSeconds[Index] = OutputSeconds[Index] * Speed;
+		}
+		return;
+	}
+
+	int32 Upper = 1;
+	for (int32 Index = 0; Index < OutputSeconds.Num(); ++Index)
+	{
+		const double Time = OutputSeconds[Index];
+		while (Upper < Points.Num() - 1 && Points[Upper].X <= Time)
+		{
+			++Upper;
+		}
+		const FVector2D& A = Points[Upper - 1];
+		const FVector2D& B = Points[Upper];
+		OutSourceSeconds[Index] = A.Y + (Time - A.X) * (B.Y - A.Y) / (B.X - A.X);
+	}
+}
+
+double AAANKPoseMath::FTimeWarp::Rate(double OutputStart, double OutputEnd) const
+{
+	if (OutputEnd <= OutputStart)
+	{
+		return 0.0;
+	}
+	return (ToSource(OutputEnd) - ToSource(OutputStart)) / (OutputEnd - OutputStart);
+}
+
+void AAANKPoseMath::ResampleLinear(TConstArrayView<double> KeyTimes, TConstArrayView<double> Values, int32 NumChannels,
+	TConstArrayView<double> SampleTimes, TArrayView<double> OutValues)
+{
+	check(NumChannels > 0 && Values.Num() == KeyTimes.Num() * NumChannels && OutValues.Num() == SampleTimes.Num() * NumChannels);
+	if (KeyTimes.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 LastKey = KeyTimes.Num() - 1;
+	const double* RESTRICT Keys = Values.GetData();
+	double* RESTRICT Out = OutValues.GetData();
+	int32 Upper = 0;
+	for (int32 Sample = 0; Sample < SampleTimes.Num(); ++Sample, Out += NumChannels)
+	{
+		const double Time = SampleTimes[Sample];
+		while (Upper <= LastKey && KeyTimes[Upper] <= Time)
+		{
+			++Upper;
+		}
+
+		// Before the first key or at/after the last: hold the end value
+		if (Upper == 0 || Upper > LastKey)
+		{
+			const double* RESTRICT Held = Keys + (Upper == 0 ? 0 : LastKey) * NumChannels;
+			for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+			{
+				Out[Channel] = Held[Channel];
+			}
+			continue;
+		}
+
+		const double A = KeyTimes[Upper - 1];
+		const double B = KeyTimes[Upper];
+		const double Alpha = B > A ? (Time - A) / (B - A) : 0.0;
+		const double* RESTRICT From = Keys + (Upper - 1) * NumChannels;
+		const double* RESTRICT To = From + NumChannels;
+		for (int32 Channel = 0; Channel < NumChannels; ++Channel)
+		{
+			Out[Channel] = From[Channel] + (To[Channel] - From[Channel]) * Alpha;
+		}
+	}
+}
+
+void AAANKPoseMath::FractalNoiseRow(const FFractalNoise& Noise, float X0, float XStep, float Y, TArrayView<float> OutRow, TArray<float>& Scratch)
+{
+	const int32 Num = OutRow.Num();
+	float* RESTRICT Out = OutRow.GetData();
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		Out[Index] = 0.0f;
+	}
+
+	// Ridged octaves are weighted by the previous octave's ridge, so crests stay sharp and valleys stay smooth
+	Scratch.SetNumUninitialized(Noise.bRidged ? Num : 0, EAllowShrinking::No);
+	float* RESTRICT Weight = Scratch.GetData();
+	for (int32 Index = 0; Index < Scratch.Num(); ++Index)
+	{
+		Weight[Index] = 1.0f;
+	}
+
+	float Frequency = Noise.Frequency;
+	float Amplitude = 1.0f;
+	float Total = 0.0f;
+	for (int32 Octave = 0; Octave < FMath::Max(Noise.Octaves, 1); ++Octave)
+	{
+		// Each octave gets its own lattice and offset so octaves do not line up at the origin
+		const uint32 Seed = HashLattice(Noise.Seed, Octave, 0x9e3779b9u);
+		const float OffsetX = static_cast<float>(Seed & 0xffffu) * (1.0f / 4096.0f);
+		const float OffsetY = static_cast<float>(Seed >> 16) * (1.0f / 4096.0f);
+		const float StartX = X0 * Frequency + OffsetX;
+		const float StepX = XStep * Frequency;
+		const float SampleY = Y * Frequency + OffsetY;
+
+		// Contiguous floats, left to the compiler to vectorize
+		if (Noise.bRidged)
+		{
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				float Ridge = 1.0f - FMath::Abs(GradientNoise(StartX + Index * StepX, SampleY, Seed));
+				Ridge = Ridge * Ridge * Weight[Index];
+				Weight[Index] = FMath::Clamp(Ridge * 2.0f, 0.0f, 1.0f);
+				Out[Index] += Ridge * Amplitude;
+			}
+		}
+		else
+		{
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				Out[Index] += GradientNoise(StartX + Index * StepX, SampleY, Seed) * Amplitude;
+			}
+		}
+
+		Total += Amplitude;
+		Amplitude *= Noise.Gain;
+		Frequency *= Noise.Lacunarity;
+	}
+
+	// Gradient noise stays mostly within +-0.5, so fBm is centred on 0.5 without further scaling
+	const float Scale = 1.0f / Total;
+	const float Bias = Noise.bRidged ? 0.0f : 0.5f;
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		Out[Index] = FMath::Clamp(Out[Index] * Scale + Bias, 0.0f, 1.0f);
+	}
+}
+
+void AAANKPoseMath::ThermalErosionRow(TConstArrayView<float> Heights, int32 SizeX, int32 Y, float Talus, float Rate, TArrayView<float> OutRow)
+{
+	check(SizeX > 0 && Heights.Num() % SizeX == 0 && OutRow.Num() == SizeX);
+	const int32 SizeY = Heights.Num() / SizeX;
+	check(Y >= 0 && Y < SizeY);
+
+	const float* RESTRICT Row = Heights.GetData() + Y * SizeX;
+	// A missing neighbour at the border is the sample itself, which exchanges nothing
+	const float* RESTRICT Up = Y > 0 ? Row - SizeX : Row;
+	const float* RESTRICT Down = Y < SizeY - 1 ? Row + SizeX : Row;
+	float* RESTRICT Out = OutRow.GetData();
+
+	// What a sample gains from a neighbour is exactly what the neighbour loses to it
+	const float Share = Rate * 0.25f;
+	auto Exchange = [Talus, Share](float Self, float Neighbour)
+	{
+		const float Drop = Neighbour - Self;
+		return Share * (FMath::Max(Drop - Talus, 0.0f) - FMath::Max(-Drop - Talus, 0.0f));
+	};
+
+	for (int32 X = 0; X < SizeX; ++X)
+	{
+		const float Height = Row[X];
+		const float Left = Row[FMath::Max(X - 1, 0)];
+		const float Right = Row[FMath::Min(X + 1, SizeX - 1)];
+		Out[X] = Height + Exchange(Height, Left) + Exchange(Height, Right) + Exchange(Height, Up[X]) + Exchange(Height, Down[X]);
+	}
+}
+
+void AAANKPoseMath::CarveCanyonRow(TConstArrayView<FVector2f> Path, const FCanyonProfile& Profile, int32 Y, TArrayView<float> InOutRow, TArray<float>& Scratch)
+{
+	const int32 SizeX = InOutRow.Num();
+	const float HalfWidth = FMath::Max(Profile.HalfWidth, UE_KINDA_SMALL_NUMBER);
+	const float FloorFraction = FMath::Clamp(Profile.FloorFraction, 0.0f, 0.99f);
+	const float RowY = static_cast<float>(Y);
+
+	// Deepest cut per sample over all segments, so overlapping segments never cut twice
+	Scratch.SetNumZeroed(SizeX, EAllowShrinking::No);
+	float* RESTRICT Cut = Scratch.GetData();
+	bool bTouched = false;
+
+	for (int32 Index = 0; Index + 1 < Path.Num(); ++Index)
+	{
+		const FVector2f A = Path[Index];
+		const FVector2f B = Path[Index + 1];
+		if (RowY < FMath::Min(A.Y, B.Y) - HalfWidth || RowY > FMath::Max(A.Y, B.Y) + HalfWidth)
+		{
+			continue;
+		}
+		const int32 MinX = FMath::Max(FMath::FloorToInt32(FMath::Min(A.X, B.X) - HalfWidth), 0);
+		const int32 MaxX = FMath::Min(FMath::CeilToInt32(FMath::Max(A.X, B.X) + HalfWidth), SizeX - 1);
+
+		const FVector2f Segment = B - A;
+		const float LengthSquared = FMath::Max(Segment.SizeSquared(), UE_KINDA_SMALL_NUMBER);
+		for (int32 X = MinX; X <= MaxX; ++X)
+		{
+			const FVector2f Offset = FVector2f(static_cast<float>(X), RowY) - A;
+			const float Along = FMath::Clamp(FVector2f::DotProduct(Offset, Segment) / LengthSquared, 0.0f, 1.0f);
+			const float T = (Offset - Segment * Along).Size() / HalfWidth;
+			if (T >= 1.0f)
+			{
+				continue;
+			}
+
+			float Wall = FMath::Clamp((T - FloorFraction) / (1.0f - FloorFraction), 0.0f, 1.0f);
+			if (Profile.Terraces > 0)
+			{
+				// Flat ledge at the foot of each step, steep riser at its back
+				const float Steps = Wall * Profile.Terraces;
+				const float Step = FMath::FloorToFloat(Steps);
+				Wall = FMath::Min((Step + FMath::Pow(Steps - Step, 3.0f)) / Profile.Terraces, 1.0f);
+			}
+			Cut[X] = FMath::Max(Cut[X], Profile.Depth * (1.0f - FMath::Pow(Wall, Profile.WallExponent)));
+			bTouched = true;
+		}
+	}
+
+	if (bTouched)
+	{
+		float* RESTRICT Row = InOutRow.GetData();
+		for (int32 X = 0; X < SizeX; ++X)
+		{
+			Row[X] -= Cut[X];
+		}
+	}
+}
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, AAANKPoseMath)
@@ -0,0 +1,178 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Algo/BinarySearch.h"
+
+
+/**
+ * Planning kernels with no engine or UObject dependencies, so they can be linked into the editor module
+ * and into the AAANKPoseBench program alike. Conventions follow motion_math.py / motion_planner.py:
+ * centimetres, degrees, and unwound (non-normalized) yaw.
+ */
+namespace AAANKPoseMath
+{
+	/** One point of an arc-length sampled spline */
+	struct FSplineSample
+	{
+		FVector Position = FVector::ZeroVector;
+		/** Unit tangent; +X when the curve is degenerate */
+		FVector Tangent = FVector::ForwardVector;
+		double Distance = 0.0;
+		/** Pitch of the tangent in degrees */
+		double Slope = 0.0;
+	};
+
+	/** Uniform Catmull-Rom between P1 and P2 (same coefficients as motion_math.catmull_rom_spline) */
+	AAANKPOSEMATH_API FVector CatmullRom(const FVector& P0, const FVector& P1, const FVector& P2, const FVector& P3, double T);
+
+	/** Derivative of CatmullRom with respect to T */
+	AAANKPOSEMATH_API FVector CatmullRomDerivative(const FVector& P0, const FVector& P1, const FVector& P2, const FVector& P3, double T);
+
+	/**
+	 * Walks the spline through Points in small steps and emits a sample every SampleInterval cm of travelled
+	 * distance. Port of motion_math.sample_spline_path; OutSamples is reset, not reallocated.
+	 */
+	AAANKPOSEMATH_API void SampleSplinePath(TConstArrayView<FVector> Points, double SampleInterval, bool bClosed, TArray<FSplineSample>& OutSamples);
+
+	/**
+	 * Finds the key at or before Time in keys sorted by Projection(Key), and the blend towards the next key.
+	 * Times outside the keys clamp to the first or last key with an alpha of 0. Returns INDEX_NONE when empty.
+	 */
+	template <typename KeyType, typename ProjectionType>
+	int32 FindKeySegment(TArrayView<KeyType> Keys, double Time, ProjectionType Projection, double& OutAlpha)
+	{
+		OutAlpha = 0.0;
+		if (Keys.Num() == 0)
+		{
+			return INDEX_NONE;
+		}
+		if (Time <= Projection(Keys[0]))
+		{
+			return 0;
+		}
+		if (Time >= Projection(Keys.Last()))
+		{
+			return Keys.Num() - 1;
+		}
+
+		// First key strictly after Time; the guards above keep it in [1, Num-1]
+		const int32 Upper = Algo::UpperBoundBy(Keys, Time, Projection);
+		const double A = Projection(Keys[Upper - 1]);
+		const double B = Projection(Keys[Upper]);
+		OutAlpha = B > A ? (Time - A) / (B - A) : 0.0;
+		return Upper - 1;
+	}
+
+	/** Planner yaw is unwound, so rotations lerp per component rather than along the shortest arc */
+	inline FRotator LerpRotatorComponents(const FRotator& A, const FRotator& B, double Alpha)
+	{
+		return FRotator(
+			FMath::Lerp(A.Pitch, B.Pitch, Alpha),
+			FMath::Lerp(A.Yaw, B.Yaw, Alpha),
+			FMath::Lerp(A.Roll, B.Roll, Alpha));
+	}
+
+	/** Focal length (mm) that makes a subject of SubjectHeight cm fill Coverage of the frame height */
+	AAANKPOSEMATH_API double CalculateFocalLength(const FVector& CameraLocation, const FVector& SubjectLocation, double SubjectHeight, double Coverage = 0.7, double SensorHeight = 24.0);
+
+	/** Camera rotation towards Target; pitch sign matches motion_planner.calculate_look_at_rotation */
+	AAANKPOSEMATH_API FRotator CalculateLookAtRotation(const FVector& CameraLocation, const FVector& TargetLocation);
+
+	/** Look-at rotation and focal length for every frame of a camera/subject pair; all views must be the same length */
+	AAANKPOSEMATH_API void SolveCameraTrack(TConstArrayView<FVector> CameraLocations, TConstArrayView<FVector> SubjectLocations,
+		double SubjectHeight, double Coverage, TArrayView<FRotator> OutRotations, TArrayView<float> OutFocalLengths);
+
+	/**
+	 * Ramer-Douglas-Peucker reduction of a polyline: indices of the points to keep so that no dropped point is
+	 * further than Tolerance from the kept curve. The first and last points are always kept.
+	 */
+	AAANKPOSEMATH_API void ReduceCurve(TConstArrayView<FVector> Points, double Tolerance, TArray<int32>& OutKeptIndices);
+
+	/** Squared euclidean distance from Query to each row of a row-major matrix with Query.Num() columns */
+	AAANKPOSEMATH_API void SquaredDistances(TConstArrayView<float> Query, TConstArrayView<float> Rows, TArrayView<float> OutDistances);
+
+	/** Row of a row-major matrix closest to Query, or INDEX_NONE when there are no rows */
+	AAANKPOSEMATH_API int32 FindNearestRow(TConstArrayView<float> Query, TConstArrayView<float> Rows, float& OutSquaredDistance);
+
+	/**
+	 * Piecewise-linear map from output (retimed) seconds to source seconds. With no points it is a uniform
+	 * Speed (0.5 = half-speed slow motion); points must increase in both coordinates and are extended past
+	 * either end along the end segment's slope.
+	 */
+	struct AAANKPOSEMATH_API FTimeWarp
+	{
+		/** X = output seconds, Y = source seconds */
+		TArray<FVector2D> Points;
+		double Speed = 1.0;
+
+		/** False if the map can't be inverted: fewer than two points, or points that don't strictly increase */
+		bool IsValid() const;
+
+		double ToSource(double OutputSeconds) const;
+		double ToOutput(double SourceSeconds) const;
+
+		/** ToSource over sorted times in one forward walk over the points */
+		void ToSource(TConstArrayView<double> OutputSeconds, TArrayView<double> OutSourceSeconds) const;
+
+		/** Source seconds played per output second, averaged over [OutputStart, OutputEnd] */
+		double Rate(double OutputStart, double OutputEnd) const;
+	};
+
+	/**
+	 * Linear resample of NumChannels interleaved channels keyed at sorted KeyTimes, at sorted SampleTimes, clamped
+	 * outside the keys. One forward walk over keys and samples; channels are innermost so the blend vectorizes.
+	 */
+	AAANKPOSEMATH_API void ResampleLinear(TConstArrayView<double> KeyTimes, TConstArrayView<double> Values, int32 NumChannels,
+		TConstArrayView<double> SampleTimes, TArrayView<double> OutValues);
+
+	/** Fractal gradient noise; the same settings and Seed always give the same field */
+	struct FFractalNoise
+	{
+		int32 Seed = 0;
+		int32 Octaves = 6;
+		/** Lattice cells per unit of the sample coordinates at the first octave */
+		float Frequency = 1.0f;
+		float Lacunarity = 2.0f;
+		float Gain = 0.5f;
+		/** Ridged multifractal (sharp crests) instead of fBm */
+		bool bRidged = false;
+	};
+
+	/**
+	 * Noise in [0, 1] at (X0 + i * XStep, Y) for each i of OutRow. Octaves run outermost over the whole row so the
+	 * per-sample loop is branch-free float math over contiguous arrays. Scratch holds ridged weights and is
+	 * resized to the row, so callers evaluating many rows can reuse it without allocating.
+	 */
+	AAANKPOSEMATH_API void FractalNoiseRow(const FFractalNoise& Noise, float X0, float XStep, float Y, TArrayView<float> OutRow, TArray<float>& Scratch);
+
+	/**
+	 * One thermal erosion step for row Y of a row-major SizeX-wide height grid: wherever the drop to a 4-neighbour
+	 * exceeds Talus, Rate of the excess (shared among the neighbours) slides downhill. Reads only Heights and writes
+	 * only OutRow, so all rows of a step can run in parallel into a second buffer; mass is conserved.
+	 */
+	AAANKPOSEMATH_API void ThermalErosionRow(TConstArrayView<float> Heights, int32 SizeX, int32 Y, float Talus, float Rate, TArrayView<float> OutRow);
+
+	/** Cross-section of a canyon carved along a path */
+	struct FCanyonProfile
+	{
+		/** Distance from the path centre to the rim, in grid samples */
+		float HalfWidth = 20.0f;
+		/** Depth at the centre, in height units */
+		float Depth = 100.0f;
+		/** Share of the half width that is flat floor */
+		float FloorFraction = 0.2f;
+		/** Wall shape: 1 is a straight V, higher values give steeper walls near the rim */
+		float WallExponent = 2.0f;
+		/** Number of ledges stepped into the walls; 0 for smooth walls */
+		int32 Terraces = 0;
+	};
+
+	/**
+	 * Lowers row Y of a height grid along the polyline Path (grid coordinates): samples within HalfWidth of it
+	 * drop by up to Depth, shaped by the profile. Only segments whose bounds reach the row are visited; Scratch
+	 * holds the per-sample cut and is reused like FractalNoiseRow's.
+	 */
+	AAANKPOSEMATH_API void CarveCanyonRow(TConstArrayView<FVector2f> Path, const FCanyonProfile& Profile, int32 Y, TArrayView<float> InOutRow, TArray<float>& Scratch);
+}
@@ -69,6 +69,7 @@ def reload_modules():
         "motion_math",
         "motion_planner",
         "motion_includes.cleanup",
+        "motion_includes.property_batch",
         "motion_includes.sequence_setup",
         "motion_includes.camera_setup",
         "motion_includes.mannequin_setup",
@@ -103,6 +104,248 @@ def run_scene(movie_folder: str):
         6. Add camera cuts
         7. Play sequence
     """
+    # Suspend viewport redraws and editor notifications while the scene is built
+    _begin_quiet()
+    movie_name = os.path.basename(os.path.normpath(movie_folder))
+    telemetry_lib = getattr(unreal, "AAANKPoseTelemetryLibrary", None)
+    if telemetry_lib:
+        telemetry_lib.begin_build_telemetry(movie_name)
+    # Opt-in (AAANKPOSE_PROFILE_CALLS=1): time every call into the unreal module per phase
+    from motion_includes import call_profiler
+    call_profiler.begin()
+    # Opt-in (AAANKPOSE_TRACE_QUERIES=1): record feature index queries; a trace opened while planning continues here
+    trace_lib = getattr(unreal, "AAANKPoseQueryTraceLibrary", None)
+    if trace_lib and os.environ.get("AAANKPOSE_TRACE_QUERIES", "") not in ("", "0"):
+        if not trace_lib.is_query_trace_recording():
+            trace_lib.begin_query_trace(movie_name)
+    else:
+        trace_lib = None
+    _record_leak_baseline(movie_name)
+    save_lib = getattr(unreal, "AAANKPoseSaveLibrary", None)
+    built = False
+    try:
+        built = _build_scene(movie_folder)
+        return built
+    finally:
+        # _build_scene starts collecting dirtied packages; unhook even if it failed before saving them
+        if save_lib:
+            save_lib.end_package_collection()
+        call_profiler.end(movie_name)
+        if trace_lib and trace_lib.is_query_trace_recording():
+            log(f"Query trace: {trace_lib.end_query_trace()} queries recorded")
+        _end_quiet()
+        if telemetry_lib:
+            # Failed runs are kept out of the medians later builds are compared with
+            if not built:
+                telemetry_lib.set_build_outcome(unreal.AAANKPoseBuildOutcome.FAILED)
+            _log_build_report(telemetry_lib.end_build_telemetry(0.25))
+        _check_run_growth(movie_name)
+
+
+# Token of the quiet scope this build opened; None once it has been ended
+_quiet_token = None
+
+
+def _begin_quiet():
+    """Open this build's quiet scope (no-op without the plugin)."""
+    global _quiet_token
+    quiet_lib = getattr(unreal, "AAANKPoseQuietModeLibrary", None)
+    if quiet_lib and _quiet_token is None:
+        _quiet_token = quiet_lib.begin_quiet_mode()
+
+
+def _end_quiet():
+    """End the scope _begin_quiet opened, once; scopes opened by other callers stay open."""
+    global _quiet_token
+    quiet_lib = getattr(unreal, "AAANKPoseQuietModeLibrary", None)
+    if quiet_lib and _quiet_token is not None:
+        quiet_lib.end_quiet_mode(_quiet_token)
+    _quiet_token = None
+
+
+def _leak_check_library():
+    """AAANKPoseLeakDetectorLibrary when AAANKPOSE_LEAK_CHECK=1, else None"""
+    leak_lib = getattr(unreal, "AAANKPoseLeakDetectorLibrary", None)
+    if not leak_lib or os.environ.get("AAANKPOSE_LEAK_CHECK", "") in ("", "0"):
+        return None
+    return leak_lib
+
+
+def _record_run_snapshot(leak_lib, movie_name):
+    from motion_includes import hud_setup
+    leak_lib.record_run_snapshot(movie_name, {"hud_setup.post_tick": hud_setup.registered_callback_count()})
+
+
+def _record_leak_baseline(movie_name):
+    """Snapshot the editor before the first checked run of a movie, so that run's growth counts too."""
+    leak_lib = _leak_check_library()
+    if leak_lib and leak_lib.get_recorded_run_count(movie_name) == 0:
+        _record_run_snapshot(leak_lib, movie_name)
+
+
+def _check_run_growth(movie_name, runs=3):
+    """Opt-in (AAANKPOSE_LEAK_CHECK=1): snapshot objects, callbacks and memory after each run
+    and report anything that grew on each of the last few runs of this movie."""
+    leak_lib = _leak_check_library()
+    if not leak_lib:
+        return
+    _record_run_snapshot(leak_lib, movie_name)
+    recorded = leak_lib.get_recorded_run_count(movie_name)
+    if recorded < runs:
+        log(f"Leak check: {recorded}/{runs} runs of {movie_name} recorded")
+        return
+    growth = leak_lib.analyze_run_growth(movie_name, runs)
+    if not growth:
+        log(f"[OK] Leak check: nothing grew across the last {runs} runs")
+        return
+    log(f"[WARN] Leak check: {len(growth)} counter(s) grew on each of the last {runs} runs")
+    for entry in growth[:20]:
+        log(f"  {entry.name:<40} {entry.first} -> {entry.last} (+{entry.growth_per_run:.1f}/run)")
+
+
+def _watch_for_live_apply(movie_folder, sequence):
+    """Opt-in (AAANKPOSE_LIVE_APPLY=1): keep re-keying this sequence as actor track files in
+    movie_folder are rewritten, instead of rebuilding the whole scene for each edit."""
+    live_lib = getattr(unreal, "AAANKPoseLiveApplyLibrary", None)
+    if not live_lib or os.environ.get("AAANKPOSE_LIVE_APPLY", "") in ("", "0"):
+        return
+    if live_lib.watch_movie_folder(os.path.abspath(movie_folder), sequence):
+        log(f"[OK] Live apply: watching {movie_folder} for track changes")
+
+
+def _force_rebuild():
+    """AAANKPOSE_FORCE_REBUILD=1 builds even when the track folder is unchanged since the last sequence."""
+    return os.environ.get("AAANKPOSE_FORCE_REBUILD", "") not in ("", "0")
+
+
+def _prewarm(sequence, timeout_seconds=10.0):
+    """Compile the sequence and wait until its meshes, textures, animations and audio are resident,
+    so the first play or capture doesn't hitch. Falls back to the old fixed sleep without the plugin."""
+    prewarm_lib = getattr(unreal, "AAANKPosePrewarmLibrary", None)
+    if not prewarm_lib:
+        import time
+        time.sleep(0.5)
+        return
+    result = prewarm_lib.prewarm_sequence(None, sequence, timeout_seconds)
+    state = "resident" if result.resident else f"{result.pending} still pending"
+    log(f"[OK] Prewarm: {result.sequences_compiled} sequence(s) compiled, {result.assets_referenced} asset(s), "
+        f"{result.actors_prestreamed} actor(s) {state} in {result.seconds:.2f}s")
+
+
+def _play_sequence(sequence):
+    """Open an already built sequence and play it from the start, as after a build."""
+    _end_quiet()
+    from motion_includes import cleanup
+    cleanup.close_open_sequences()
+    _prewarm(sequence)
+    unreal.LevelSequenceEditorBlueprintLibrary.open_level_sequence(sequence)
+    unreal.LevelSequenceEditorBlueprintLibrary.set_lock_camera_cut_to_viewport(True)
+    unreal.LevelSequenceEditorBlueprintLibrary.set_current_time(0)
+    unreal.LevelSequenceEditorBlueprintLibrary.play()
+
+
+def _phase(name):
+    """Start timing a build phase; the previous phase ends here."""
+    telemetry_lib = getattr(unreal, "AAANKPoseTelemetryLibrary", None)
+    if telemetry_lib:
+        telemetry_lib.begin_phase(name)
+    from motion_includes import call_profiler
+    call_profiler.set_phase(name)
+
+
+def _add_build_counter(name, delta):
+    """Add to one of the build's telemetry counters (ActorsSpawned, KeysWritten, AssetsLoaded)."""
+    telemetry_lib = getattr(unreal, "AAANKPoseTelemetryLibrary", None)
+    if telemetry_lib and delta:
+        telemetry_lib.add_build_counter(name, delta)
+
+
+def _log_build_report(report):
+    """Print the per-phase timings recorded by the AAANKPose telemetry."""
+    if not report.movie:
+        return
+    outcome = "" if report.outcome == unreal.AAANKPoseBuildOutcome.COMPLETED else f", {report.outcome.name.lower()}"
+    log(f"\nBuild timings for {report.movie} ({report.history_samples} previous builds{outcome}):")
+    for phase in list(report.phases) + [report.total]:
+        flag = "  [REGRESSED]" if phase.regressed else ""
+        median = f" (median {phase.median_seconds:.3f}s)" if phase.median_seconds > 0 else ""
+        log(f"  {phase.name:<20} {phase.seconds:8.3f}s{median}{flag}")
+    for name, value in report.counters.items():
+        log(f"  {name:<20} {value}")
+
+
+def run_scene_sliced(movie_folder: str, budget_ms: float = 8.0, shots: str = None, shot_seconds: float = 10.0):
+    """
+    Build the scene natively a few milliseconds per editor frame instead of in one blocking call.
+    Returns immediately with the executor (or None if the AAANKPose plugin is unavailable);
+    the sequence is opened and played from its on_finished callback.
+
+    shots="cuts" or shots="windows" builds one subsequence per camera cut or per shot_seconds
+    under a master sequence; a rebuild only re-keys the shots whose tracks changed.
+
+    Covers mannequins, cameras and markers. Movies with lights, splines, look-at timelines
+    or scene.json should keep using run_scene().
+    """
+    executor_class = getattr(unreal, "AAANKPoseSceneBuildExecutor", None)
+    if not executor_class:
+        log("[WARN] AAANKPoseSceneBuildExecutor not available, use run_scene()")
+        return None
+
+    from motion_includes import cleanup
+    cleanup.close_open_sequences()
+
+    def on_finished(succeeded, sequence):
+        if not succeeded or not sequence:
+            log(f"✗ Sliced build of {os.path.basename(movie_folder)} did not complete")
+            return
+        unreal.EditorAssetLibrary.save_loaded_asset(sequence)
+        shot_sequences = executor.get_shot_sequences()
+        if shot_sequences:
+            unreal.EditorAssetLibrary.save_loaded_assets(shot_sequences)
+        unreal.LevelSequenceEditorBlueprintLibrary.open_level_sequence(sequence)
+        unreal.LevelSequenceEditorBlueprintLibrary.set_lock_camera_cut_to_viewport(True)
+        unreal.LevelSequenceEditorBlueprintLibrary.set_current_time(0)
+        unreal.LevelSequenceEditorBlueprintLibrary.play()
+        log(f"[OK] Sliced build finished: {sequence.get_name()}")
+        _watch_for_live_apply(movie_folder, sequence)
+
+    partition = {
+        "cuts": unreal.AAANKPoseShotPartition.CAMERA_CUTS,
+        "windows": unreal.AAANKPoseShotPartition.TIME_WINDOWS,
+    }.get(shots, unreal.AAANKPoseShotPartition.NONE)
+    executor = executor_class.start_scene_build(None, movie_folder, budget_ms, partition, shot_seconds, _force_rebuild())
+    if executor:
+        executor.on_finished.add_callable(on_finished)
+        # Keep the Python wrapper (and its callback) alive until the build reports back
+        run_scene_sliced._active = executor
+    return executor
+
+
+def retime_movie(movie_folder: str, output_folder: str = None, fps: int = 0, speed: float = 1.0, warp=None):
+    """
+    Deliver an already planned movie at another frame rate or speed without re-running the planner.
+    Writes a retimed copy of the track folder (in place when output_folder is None) and returns its path,
+    ready for run_scene(). warp is an optional list of (output_seconds, source_seconds) points.
+    """
+    retime_lib = getattr(unreal, "AAANKPoseRetimeLibrary", None)
+    if not retime_lib:
+        log("[WARN] AAANKPoseRetimeLibrary not available, re-plan with MovieBuilder(fps=...) instead")
+        return None
+
+    settings = unreal.AAANKPoseRetimeSettings(target_fps=fps, speed=speed,
+                                              warp_curve=[unreal.Vector2D(x, y) for x, y in (warp or [])])
+    output_folder = output_folder or movie_folder
+    result = retime_lib.retime_track_folder(os.path.abspath(movie_folder), os.path.abspath(output_folder), settings)
+    if not result.succeeded:
+        log(f"✗ Retime of {os.path.basename(movie_folder)} failed")
+        return None
+    log(f"[OK] Retimed {os.path.basename(movie_folder)}: {result.source_fps} fps {result.source_duration:.2f}s -> "
+        f"{result.target_fps} fps {result.duration:.2f}s, {result.keys} transform key(s) in {result.seconds * 1000:.0f}ms")
+    return output_folder
+
+
+def _build_scene(movie_folder: str):
+    """Body of run_scene; may return early on failure."""
     reload_modules()
     
     import motion_planner
@@ -116,6 +359,7 @@ def run_scene(movie_folder: str):
     from motion_includes import keyframe_applier
     from motion_includes import attach_setup
     from motion_includes import spline_setup
+    from motion_includes.property_batch import set_properties
     from motion_includes.assets import Shapes, Materials
     
     log(f"")
@@ -141,8 +385,31 @@ def run_scene(movie_folder: str):
     log(f"Scene: {scene_name}")
     log(f"FPS: {fps}")
     log(f"Actors: {actor_names}")
+
+    # Skip the whole build when dist/<movie> is byte-identical to what the last sequence was built from
+    # (AAANKPOSE_FORCE_REBUILD=1 always rebuilds)
+    cache_lib = getattr(unreal, "AAANKPoseBuildCacheLibrary", None)
+    fingerprint = ""
+    if cache_lib:
+        fingerprint = cache_lib.compute_track_folder_fingerprint(movie_folder, "python")
+        if not _force_rebuild():
+            cached = cache_lib.find_reusable_sequence(None, movie_folder, fingerprint)
+            if cached:
+                log(f"[OK] {cached.get_name()} is up to date with {os.path.basename(movie_folder)}, skipping the build")
+                telemetry_lib = getattr(unreal, "AAANKPoseTelemetryLibrary", None)
+                if telemetry_lib:
+                    telemetry_lib.set_build_outcome(unreal.AAANKPoseBuildOutcome.SKIPPED)
+                _play_sequence(cached)
+                _watch_for_live_apply(movie_folder, cached)
+                return True
+    
+    # Record every package this build dirties so they can be saved in one batch
+    save_lib = getattr(unreal, "AAANKPoseSaveLibrary", None)
+    if save_lib:
+        save_lib.begin_package_collection()
     
     # 2. Cleanup old state
+    _phase("Cleanup")
     log("\n" + "="*60)
     log("CLEANUP PHASE")
     log("="*60)
@@ -152,6 +419,18 @@ def run_scene(movie_folder: str):
     except Exception as e:
         log(f"✗ Cleanup: close_open_sequences() failed: {e}")
     
+    # New-level movies clone the prepared template level (before actor cleanup, so a reopened level is
+    # cleaned too); its fog takes the movie's add_atmosphere directly
+    scene_commands_path = os.path.join(movie_folder, "scene.json")
+    atmosphere_applied = False
+    if meta.get("create_new_level", False):
+        _phase("Level")
+        atmosphere_cmd = None
+        if os.path.exists(scene_commands_path):
+            with open(scene_commands_path, 'r', encoding='utf-8') as f:
+                atmosphere_cmd = next((cmd for cmd in json.load(f) if cmd.get("command") == "add_atmosphere"), None)
+        atmosphere_applied = level_setup.create_movie_level(scene_name, atmosphere_cmd)
+    
     try:
         cleanup.delete_old_actors()
         log("[OK] Cleanup: delete_old_actors() completed")
@@ -159,8 +438,9 @@ def run_scene(movie_folder: str):
         log(f"✗ Cleanup: delete_old_actors() failed: {e}")
     
     # 3. Process scene commands (atmosphere, fog, etc.)
-    scene_commands_path = os.path.join(movie_folder, "scene.json")
+    light_shaft_commands = {}
     if os.path.exists(scene_commands_path):
+        _phase("SceneCommands")
         log("\n" + "="*60)
         log("SCENE COMMANDS PHASE")
         log("="*60)
@@ -171,7 +451,10 @@ def run_scene(movie_folder: str):
             for cmd in scene_commands:
                 command_type = cmd.get("command")
                 
-                if command_type == "add_atmosphere":
+                if command_type == "add_atmosphere" and atmosphere_applied:
+                    log(f"  [OK] add_atmosphere already applied to the template level's fog")
+                    
+                elif command_type == "add_atmosphere":
                     log(f"  Processing add_atmosphere command")
                     try:
                         level_setup.apply_atmosphere_settings(cmd)
@@ -190,7 +473,12 @@ def run_scene(movie_folder: str):
                     
                 elif command_type == "configure_light_shafts":
                     log(f"  Processing configure_light_shafts for {cmd.get('actor')}")
-                    # Will be applied when light is created
+                    # Folded into the light's settings when the light rig is spawned
+                    light_shaft_commands[cmd.get("actor")] = cmd
+                    
+                elif command_type == "add_light_rig":
+                    log(f"  Processing add_light_rig ({cmd.get('preset')})")
+                    light_setup.spawn_light_rig_preset(cmd.get("preset"))
                     
                 else:
                     log(f"  [WARN] Unknown scene command: {command_type}")
@@ -200,6 +488,7 @@ def run_scene(movie_folder: str):
             traceback.print_exc()
     
     # 4. Create level sequence
+    _phase("CreateSequence")
     log("\n" + "="*60)
     log("SEQUENCE CREATION PHASE")
     log("="*60)
@@ -220,6 +509,7 @@ def run_scene(movie_folder: str):
     unreal.LevelSequenceEditorBlueprintLibrary.open_level_sequence(sequence)
     
     # 4. Plan motion - process track files
+    _phase("PlanMotion")
     log("\n" + "="*60)
     log("MOTION PLANNING PHASE")
     log("="*60)
@@ -233,36 +523,53 @@ def run_scene(movie_folder: str):
         return False
     
     # 5. Create actors and cameras, apply keyframes
+    _phase("Spawn")
     actors_info = {}
     total_frames = 0
     
+    # All lights are spawned up front as one rig, fully configured before they register
+    from motion_structs import track_chunks
+    rig_lights = []
+    for actor_name in actor_names:
+        actor_folder = os.path.join(movie_folder, actor_name)
+        settings_path = os.path.join(actor_folder, "settings.json")
+        if not os.path.exists(settings_path):
+            continue
+        with open(settings_path, 'r', encoding='utf-8') as f:
+            settings = json.load(f)
+        if settings.get("actor_type") != "light" and "light_type" not in settings:
+            continue
+        if actor_name in light_shaft_commands:
+            settings = light_setup.apply_light_shafts_command(settings, light_shaft_commands[actor_name])
+        first_kf, _, _ = track_chunks.frame_range(actor_folder)
+        first_kf = first_kf or {}
+        location = unreal.Vector(first_kf.get("x", 0), first_kf.get("y", 0), first_kf.get("z", 0))
+        rotation = unreal.Rotator(pitch=first_kf.get("pitch", 0), yaw=first_kf.get("yaw", 0), roll=first_kf.get("roll", 0))
+        rig_lights.append((actor_name, location, rotation, settings))
+    rig_actors = light_setup.spawn_light_rig(rig_lights) if rig_lights else {}
+    
     for actor_name in actor_names:
         actor_folder = os.path.join(movie_folder, actor_name)
         if not os.path.exists(actor_folder):
             log(f"  [WARN] Folder not found for {actor_name}")
             continue
         
-        # Load initial state from transform track
-        transform_path = os.path.join(actor_folder, "transform.json")
+        # Load initial state from transform track (one window of a chunked track)
+        from motion_structs import track_chunks
         location = unreal.Vector(0, 0, 0)
         rotation = unreal.Rotator(0, 0, 0)
         
-        if os.path.exists(transform_path):
-            with open(transform_path, 'r', encoding='utf-8') as f:
-                transform_data = json.load(f)
+        first_kf, last_frame, _ = track_chunks.frame_range(actor_folder)
+        if first_kf:
+            location = unreal.Vector(first_kf.get("x", 0), first_kf.get("y", 0), first_kf.get("z", 0))
+            rotation = unreal.Rotator(
+                pitch=first_kf.get("pitch", 0),
+                yaw=first_kf.get("yaw", 0),
+                roll=first_kf.get("roll", 0)
+            )
             
-            if transform_data:
-                first_kf = transform_data[0]
-                location = unreal.Vector(first_kf.get("x", 0), first_kf.get("y", 0), first_kf.get("z", 0))
-                rotation = unreal.Rotator(
-                    pitch=first_kf.get("pitch", 0),
-                    yaw=first_kf.get("yaw", 0),
-                    roll=first_kf.get("roll", 0)
-                )
-                
-                # Track max frames
-                for kf in transform_data:
-                    total_frames = max(total_frames, kf.get("frame", 0))
+            # Track max frames
+            total_frames = max(total_frames, last_frame)
 
         # Check for settings to determine type
         settings_path = os.path.join(actor_folder, "settings.json")
@@ -289,7 +596,7 @@ def run_scene(movie_folder: str):
              
         elif actor_type == "light" or "light_type" in settings:
              log(f"  Creating Light: {actor_name}")
-             actor_obj = light_setup.create_light(actor_name, location, rotation, settings)
+             actor_obj = rig_actors.get(actor_name)
              
         elif actor_type == "marker":
              log(f"  Creating marker: {actor_name}")
@@ -305,11 +612,7 @@ def run_scene(movie_folder: str):
                      actor_obj.static_mesh_component.set_static_mesh(mesh_asset)
                      actor_obj.set_actor_scale3d(unreal.Vector(*mesh_scale))
                      color_name = settings.get("color", "Blue")
-                     mat_path = Materials.get_color(color_name)
-                     mat = unreal.load_object(None, mat_path)
-                     if mat:
-                         actor_obj.static_mesh_component.set_material(0, mat)
-                     log(f"    [OK] Marker created with {mesh_path}")
+                     mat = Materials.get_color_material(color_name)
                      if mat:
                          actor_obj.static_mesh_component.set_material(0, mat)
                      log(f"    [OK] Marker created with {mesh_path}")
@@ -383,15 +686,12 @@ def run_scene(movie_folder: str):
                                 actor_obj.set_actor_rotation(look_at_rot, False)
                                 log(f"    [OK] Snapped initial rotation to {target_name} ({look_at_rot})")
                     
-                    # Enable Tracking
-                    tracking_settings = actor_obj.get_editor_property("lookat_tracking_settings")
-                    tracking_settings.set_editor_property("enable_look_at_tracking", True)
-                    
-                    # Set interp speed
+                    # Enable Tracking and set interp speed
                     interp_speed = settings.get("look_at_interp_speed", 5.0)
-                    tracking_settings.set_editor_property("look_at_tracking_interp_speed", interp_speed)
-                    
-                    actor_obj.set_editor_property("lookat_tracking_settings", tracking_settings)
+                    set_properties([
+                        (actor_obj, "lookat_tracking_settings.enable_look_at_tracking", True),
+                        (actor_obj, "lookat_tracking_settings.look_at_tracking_interp_speed", interp_speed),
+                    ])
                     log(f"    [OK] LookAt tracking enabled (interp_speed: {interp_speed})")
                 except Exception as e:
                     log(f"    [WARN] Failed to enable LookAt tracking: {e}")
@@ -476,12 +776,16 @@ def run_scene(movie_folder: str):
     log(f"{'='*60}")
     log(f"")
     
+    # The light rig counts its own actors natively
+    _add_build_counter("ActorsSpawned", sum(1 for name in actors_info if name not in rig_actors))
+
     # Process attachments AFTER all actors are spawned
     log(f"")
     log(f"Processing attachments...")
     attach_setup.process_attachments(sequence, actors_info, fps)
     
     # 6. Apply keyframes to each actor
+    _phase("KeyActors")
     for actor_name, data in keyframe_data_all.get("actors", {}).items():
         if actor_name in actors_info:
             actor_obj = actors_info[actor_name]["actor"]
@@ -504,6 +808,9 @@ def run_scene(movie_folder: str):
                             log(f"    ⚠ Failed to bind component, falling back")
 
             log(f"  Applying keyframes to: {actor_name}")
+            # Three channel keys per location and per rotation key, counted like the native build
+            keyframes = data.get("keyframes", {})
+            _add_build_counter("KeysWritten", 3 * (len(keyframes.get("location", [])) + len(keyframes.get("rotation", []))))
             keyframe_applier.apply_keyframes_to_actor(
                 actor_name,
                 actors_info[actor_name]["actor"],
@@ -516,6 +823,7 @@ def run_scene(movie_folder: str):
             )
     
     # 7. Apply camera-specific keyframes (focal length, focus distance)
+    _phase("CameraTracks")
     for actor_name in actors_info:
         actor_folder = os.path.join(movie_folder, actor_name)
         
@@ -535,9 +843,7 @@ def run_scene(movie_folder: str):
                     max_kf_focal = max(kf["value"] for kf in focal_keyframes)
                     if max_kf_focal > 200.0: # Default max is often 120-200mm
                         log(f"    -> Adjusting lens limits (Max Focal Length: {max_kf_focal:.1f}mm)")
-                        lens_settings = camera_component.lens_settings
-                        lens_settings.max_focal_length = max_kf_focal + 100.0
-                        camera_component.lens_settings = lens_settings
+                        set_properties([(camera_component, "lens_settings.max_focal_length", max_kf_focal + 100.0)])
                     
                     # Create component binding (add component to sequence)
                     comp_binding = sequence.add_possessable(camera_component)
@@ -556,6 +862,7 @@ def run_scene(movie_folder: str):
                         for kf in focal_keyframes:
                             frame_number = unreal.FrameNumber(value=kf["frame"])
                             focal_channel.add_key(frame_number, kf["value"])
+                        _add_build_counter("KeysWritten", len(focal_keyframes))
                         log(f"    [OK] Applied {len(focal_keyframes)} focal length keyframes")
                     else:
                         log(f"    [WARN] Focal length track has no channels")
@@ -576,9 +883,7 @@ def run_scene(movie_folder: str):
                     camera_component = camera_obj.get_cine_camera_component()
                     
                     # Enable TRACKING focus mode (not MANUAL)
-                    focus_settings = camera_component.focus_settings
-                    focus_settings.focus_method = unreal.CameraFocusMethod.TRACKING
-                    camera_component.focus_settings = focus_settings
+                    set_properties([(camera_component, "focus_settings.focus_method", unreal.CameraFocusMethod.TRACKING)])
                     
                     # Create component binding
                     comp_binding = sequence.add_possessable(camera_component)
@@ -702,6 +1007,7 @@ def run_scene(movie_folder: str):
     
     
     # 7. Apply camera cuts
+    _phase("CameraCuts")
     camera_cuts = keyframe_data_all.get("camera_cuts", [])
     if camera_cuts:
         log(f"  Applying {len(camera_cuts)} camera cut(s)")
@@ -714,8 +1020,20 @@ def run_scene(movie_folder: str):
             })
         sequence_setup.apply_camera_cuts(sequence, frame_cuts, actors_info, fps)
     
-    # 8. Save and play
-    unreal.EditorAssetLibrary.save_loaded_asset(sequence)
+    # 8. Save and play (resume the editor first so playback redraws normally)
+    _phase("Save")
+    if cache_lib:
+        cache_lib.stamp_sequence(sequence, movie_folder, fingerprint)
+    _end_quiet()
+    
+    if save_lib:
+        save_results = save_lib.save_collected_packages()
+        log(f"[OK] Saved {len(save_results)} package(s) in one batch")
+        for r in save_results:
+            if not r.saved:
+                log(f"  [WARN] Failed to save {r.package_name}")
+    else:
+        unreal.EditorAssetLibrary.save_loaded_asset(sequence)
     
     try:
         unreal.LevelSequenceEditorBlueprintLibrary.set_lock_camera_cut_to_viewport(True)
@@ -723,8 +1041,10 @@ def run_scene(movie_folder: str):
     except Exception as e:
         log(f"[WARN] Warning: Could not lock viewport: {e}")
     
-    import time
-    time.sleep(0.5)
+    _phase("Prewarm")
+    _prewarm(sequence)
+
+    _phase("Play")
     
     try:
         unreal.LevelSequenceEditorBlueprintLibrary.refresh_current_level_sequence()
@@ -734,6 +1054,8 @@ def run_scene(movie_folder: str):
     except Exception as e:
         log(f"[WARN] Warning: Could not play sequence: {e}")
     
+    _watch_for_live_apply(movie_folder, sequence)
+    
     log(f"{'='*60}")
     log(f"SCENE EXECUTION COMPLETE")
     log(f"{'='*60}")